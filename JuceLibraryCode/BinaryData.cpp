@@ -470,16 +470,107 @@ static const unsigned char temp_binary_data_14[] =
 "uniform int invertMask;\r\n"
 "uniform vec4 tint = vec4(1.0,1.0,1.0,1.0);\r\n"
 "\r\n"
+"// Color correction, surface then screen, applied in this same pass\r\n"
+"uniform int surfaceCCEnabled;\r\n"
+"uniform vec3 surfaceLift;\r\n"
+"uniform vec3 surfaceGamma;\r\n"
+"uniform vec3 surfaceGain;\r\n"
+"uniform sampler3D surfaceLut;\r\n"
+"uniform float surfaceLutSize;\r\n"
+"uniform float surfaceLutAmount;\r\n"
+"uniform vec3 surfaceLutDomainMin;\r\n"
+"uniform vec3 surfaceLutDomainMax;\r\n"
+"\r\n"
+"uniform int screenCCEnabled;\r\n"
+"uniform vec3 screenLift;\r\n"
+"uniform vec3 screenGamma;\r\n"
+"uniform vec3 screenGain;\r\n"
+"uniform sampler3D screenLut;\r\n"
+"uniform float screenLutSize;\r\n"
+"uniform float screenLutAmount;\r\n"
+"uniform vec3 screenLutDomainMin;\r\n"
+"uniform vec3 screenLutDomainMax;\r\n"
+"\r\n"
 "float map(float value, float min1, float max1, float min2, float max2) {\r\n"
 "\treturn min2 + ((max2-min2)*(value-min1)/(max1-min1)); \r\n"
 "};\r\n"
 "\r\n"
+"vec3 liftGammaGain(vec3 c, vec3 lift, vec3 gamma, vec3 gain)\r\n"
+"{\r\n"
+"\tc = gain * (c + lift * (1.0 - c));\r\n"
+"\treturn pow(max(c, vec3(0.0)), 1.0 / max(gamma, vec3(0.0001)));\r\n"
+"}\r\n"
+"\r\n"
+"// Tetrahedral interpolation, the LUT texture is unfiltered so we fetch the 4 texels of the tetrahedron ourselves\r\n"
+"vec3 applyLut(sampler3D lut, float size, vec3 domainMin, vec3 domainMax, vec3 c)\r\n"
+"{\r\n"
+"\tvec3 p = clamp((c - domainMin) / (domainMax - domainMin), 0.0, 1.0) * (size - 1.0);\r\n"
+"\tvec3 base = min(floor(p), vec3(size - 2.0));\r\n"
+"\tvec3 f = p - base;\r\n"
+"\tivec3 b = ivec3(base);\r\n"
+"\r\n"
+"\tvec3 c000 = texelFetch(lut, b, 0).rgb;\r\n"
+"\tvec3 c111 = texelFetch(lut, b + ivec3(1, 1, 1), 0).rgb;\r\n"
+"\r\n"
+"\tif (f.r > f.g)\r\n"
+"\t{\r\n"
+"\t\tif (f.g > f.b)\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c100 = texelFetch(lut, b + ivec3(1, 0, 0), 0).rgb;\r\n"
+"\t\t\tvec3 c110 = texelFetch(lut, b + ivec3(1, 1, 0), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.r * (c100 - c000) + f.g * (c110 - c100) + f.b * (c111 - c110);\r\n"
+"\t\t}\r\n"
+"\t\telse if (f.r > f.b)\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c100 = texelFetch(lut, b + ivec3(1, 0, 0), 0).rgb;\r\n"
+"\t\t\tvec3 c101 = texelFetch(lut, b + ivec3(1, 0, 1), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.r * (c100 - c000) + f.b * (c101 - c100) + f.g * (c111 - c101);\r\n"
+"\t\t}\r\n"
+"\t\telse\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c001 = texelFetch(lut, b + ivec3(0, 0, 1), 0).rgb;\r\n"
+"\t\t\tvec3 c101 = texelFetch(lut, b + ivec3(1, 0, 1), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.b * (c001 - c000) + f.r * (c101 - c001) + f.g * (c111 - c101);\r\n"
+"\t\t}\r\n"
+"\t}\r\n"
+"\telse\r\n"
+"\t{\r\n"
+"\t\tif (f.b > f.g)\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c001 = texelFetch(lut, b + ivec3(0, 0, 1), 0).rgb;\r\n"
+"\t\t\tvec3 c011 = texelFetch(lut, b + ivec3(0, 1, 1), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.b * (c001 - c000) + f.g * (c011 - c001) + f.r * (c111 - c011);\r\n"
+"\t\t}\r\n"
+"\t\telse if (f.b > f.r)\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c010 = texelFetch(lut, b + ivec3(0, 1, 0), 0).rgb;\r\n"
+"\t\t\tvec3 c011 = texelFetch(lut, b + ivec3(0, 1, 1), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.g * (c010 - c000) + f.b * (c011 - c010) + f.r * (c111 - c011);\r\n"
+"\t\t}\r\n"
+"\t\telse\r\n"
+"\t\t{\r\n"
+"\t\t\tvec3 c010 = texelFetch(lut, b + ivec3(0, 1, 0), 0).rgb;\r\n"
+"\t\t\tvec3 c110 = texelFetch(lut, b + ivec3(1, 1, 0), 0).rgb;\r\n"
+"\t\t\treturn c000 + f.g * (c010 - c000) + f.r * (c110 - c010) + f.b * (c111 - c110);\r\n"
+"\t\t}\r\n"
+"\t}\r\n"
+"}\r\n"
+"\r\n"
+"vec3 colorCorrect(vec3 c, vec3 lift, vec3 gamma, vec3 gain, sampler3D lut, float lutSize, float lutAmount, vec3 domainMin, vec3 domainMax)\r\n"
+"{\r\n"
+"\tc = liftGammaGain(c, lift, gamma, gain);\r\n"
+"\tif (lutAmount > 0.0) c = mix(c, applyLut(lut, lutSize, domainMin, domainMax, c), lutAmount);\r\n"
+"\treturn c;\r\n"
+"}\r\n"
+"\r\n"
 "void main()\r\n"
 "{\r\n"
 "\toutColor = textureProj(tex, Texcoord);\r\n"
 "    vec2 tex2D = Texcoord.xy / Texcoord.z;\r\n"
 "    if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) \r\n"
 "    { outColor = vec4(0,0,0,0); }\r\n"
+"\tif (surfaceCCEnabled == 1) outColor.rgb = colorCorrect(outColor.rgb, surfaceLift, surfaceGamma, surfaceGain, surfaceLut, surfaceLutSize, surfaceLutAmount, surfaceLutDomainMin, surfaceLutDomainMax);\r\n"
+"\tif (screenCCEnabled == 1) outColor.rgb = colorCorrect(outColor.rgb, screenLift, screenGamma, screenGain, screenLut, screenLutSize, screenLutAmount, screenLutDomainMin, screenLutDomainMax);\r\n"
 "   \tvec4 maskColor = textureProj(mask, Maskcoord);\r\n"
 "   \tfloat alpha = outColor.a;\r\n"
 "   \tif (SurfacePosition[1] > 1-borderSoft[0])    {alpha *= map(SurfacePosition[1],1.0f,1-borderSoft[0],0.0f,1.0f);} // top\r\n"
@@ -1045,7 +1136,7 @@ const char* getNamedResource (const char* resourceNameUTF8, int& numBytes)
         case 0x48f0e2be:  numBytes = 1438; return web_png;
         case 0xf2126fe5:  numBytes = 1196; return webcam_png;
         case 0xe7f13242:  numBytes = 4212; return default_smlayout;
-        case 0x0ffdf71e:  numBytes = 1301; return fragmentShaderMainSurface_glsl;
+        case 0x0ffdf71e:  numBytes = 4685; return fragmentShaderMainSurface_glsl;
         case 0x0ff5b690:  numBytes = 9164; return fragmentShaderTestGrid_glsl;
         case 0xd4093963:  numBytes = 10023; return icon_png;
         case 0xaecbe392:  numBytes = 381; return VertexShaderMainSurface_glsl;
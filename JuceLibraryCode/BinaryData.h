@@ -51,7 +51,7 @@ namespace BinaryData
     const int            default_smlayoutSize = 4212;
 
     extern const char*   fragmentShaderMainSurface_glsl;
-    const int            fragmentShaderMainSurface_glslSize = 1301;
+    const int            fragmentShaderMainSurface_glslSize = 4685;
 
     extern const char*   fragmentShaderTestGrid_glsl;
     const int            fragmentShaderTestGrid_glslSize = 9164;
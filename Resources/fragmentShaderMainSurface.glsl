@@ -9,16 +9,107 @@ uniform vec4 borderSoft;
 uniform int invertMask;
 uniform vec4 tint = vec4(1.0,1.0,1.0,1.0);
 
+// Color correction, surface then screen, applied in this same pass
+uniform int surfaceCCEnabled;
+uniform vec3 surfaceLift;
+uniform vec3 surfaceGamma;
+uniform vec3 surfaceGain;
+uniform sampler3D surfaceLut;
+uniform float surfaceLutSize;
+uniform float surfaceLutAmount;
+uniform vec3 surfaceLutDomainMin;
+uniform vec3 surfaceLutDomainMax;
+
+uniform int screenCCEnabled;
+uniform vec3 screenLift;
+uniform vec3 screenGamma;
+uniform vec3 screenGain;
+uniform sampler3D screenLut;
+uniform float screenLutSize;
+uniform float screenLutAmount;
+uniform vec3 screenLutDomainMin;
+uniform vec3 screenLutDomainMax;
+
 float map(float value, float min1, float max1, float min2, float max2) {
 	return min2 + ((max2-min2)*(value-min1)/(max1-min1)); 
 };
 
+vec3 liftGammaGain(vec3 c, vec3 lift, vec3 gamma, vec3 gain)
+{
+	c = gain * (c + lift * (1.0 - c));
+	return pow(max(c, vec3(0.0)), 1.0 / max(gamma, vec3(0.0001)));
+}
+
+// Tetrahedral interpolation, the LUT texture is unfiltered so we fetch the 4 texels of the tetrahedron ourselves
+vec3 applyLut(sampler3D lut, float size, vec3 domainMin, vec3 domainMax, vec3 c)
+{
+	vec3 p = clamp((c - domainMin) / (domainMax - domainMin), 0.0, 1.0) * (size - 1.0);
+	vec3 base = min(floor(p), vec3(size - 2.0));
+	vec3 f = p - base;
+	ivec3 b = ivec3(base);
+
+	vec3 c000 = texelFetch(lut, b, 0).rgb;
+	vec3 c111 = texelFetch(lut, b + ivec3(1, 1, 1), 0).rgb;
+
+	if (f.r > f.g)
+	{
+		if (f.g > f.b)
+		{
+			vec3 c100 = texelFetch(lut, b + ivec3(1, 0, 0), 0).rgb;
+			vec3 c110 = texelFetch(lut, b + ivec3(1, 1, 0), 0).rgb;
+			return c000 + f.r * (c100 - c000) + f.g * (c110 - c100) + f.b * (c111 - c110);
+		}
+		else if (f.r > f.b)
+		{
+			vec3 c100 = texelFetch(lut, b + ivec3(1, 0, 0), 0).rgb;
+			vec3 c101 = texelFetch(lut, b + ivec3(1, 0, 1), 0).rgb;
+			return c000 + f.r * (c100 - c000) + f.b * (c101 - c100) + f.g * (c111 - c101);
+		}
+		else
+		{
+			vec3 c001 = texelFetch(lut, b + ivec3(0, 0, 1), 0).rgb;
+			vec3 c101 = texelFetch(lut, b + ivec3(1, 0, 1), 0).rgb;
+			return c000 + f.b * (c001 - c000) + f.r * (c101 - c001) + f.g * (c111 - c101);
+		}
+	}
+	else
+	{
+		if (f.b > f.g)
+		{
+			vec3 c001 = texelFetch(lut, b + ivec3(0, 0, 1), 0).rgb;
+			vec3 c011 = texelFetch(lut, b + ivec3(0, 1, 1), 0).rgb;
+			return c000 + f.b * (c001 - c000) + f.g * (c011 - c001) + f.r * (c111 - c011);
+		}
+		else if (f.b > f.r)
+		{
+			vec3 c010 = texelFetch(lut, b + ivec3(0, 1, 0), 0).rgb;
+			vec3 c011 = texelFetch(lut, b + ivec3(0, 1, 1), 0).rgb;
+			return c000 + f.g * (c010 - c000) + f.b * (c011 - c010) + f.r * (c111 - c011);
+		}
+		else
+		{
+			vec3 c010 = texelFetch(lut, b + ivec3(0, 1, 0), 0).rgb;
+			vec3 c110 = texelFetch(lut, b + ivec3(1, 1, 0), 0).rgb;
+			return c000 + f.g * (c010 - c000) + f.r * (c110 - c010) + f.b * (c111 - c110);
+		}
+	}
+}
+
+vec3 colorCorrect(vec3 c, vec3 lift, vec3 gamma, vec3 gain, sampler3D lut, float lutSize, float lutAmount, vec3 domainMin, vec3 domainMax)
+{
+	c = liftGammaGain(c, lift, gamma, gain);
+	if (lutAmount > 0.0) c = mix(c, applyLut(lut, lutSize, domainMin, domainMax, c), lutAmount);
+	return c;
+}
+
 void main()
 {
 	outColor = textureProj(tex, Texcoord);
     vec2 tex2D = Texcoord.xy / Texcoord.z;
     if (tex2D.x>1 || tex2D.x<0 ||tex2D.y>1 || tex2D.y<0) 
     { outColor = vec4(0,0,0,0); }
+	if (surfaceCCEnabled == 1) outColor.rgb = colorCorrect(outColor.rgb, surfaceLift, surfaceGamma, surfaceGain, surfaceLut, surfaceLutSize, surfaceLutAmount, surfaceLutDomainMin, surfaceLutDomainMax);
+	if (screenCCEnabled == 1) outColor.rgb = colorCorrect(outColor.rgb, screenLift, screenGamma, screenGain, screenLut, screenLutSize, screenLutAmount, screenLutDomainMin, screenLutDomainMax);
    	vec4 maskColor = textureProj(mask, Maskcoord);
    	float alpha = outColor.a;
    	if (SurfacePosition[1] > 1-borderSoft[0])    {alpha *= map(SurfacePosition[1],1.0f,1-borderSoft[0],0.0f,1.0f);} // top
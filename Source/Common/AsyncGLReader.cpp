@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+	AsyncGLReader.cpp
+	Created: 19 Oct 2026 2:20:11pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+AsyncGLReader::AsyncGLReader(int numBuffers, GLenum format) :
+	format(format),
+	writeIndex(0),
+	numPending(0)
+{
+	slots.resize(jmax(numBuffers, 2));
+}
+
+AsyncGLReader::~AsyncGLReader()
+{
+	//release() must have been called from the GL thread before
+	jassert(numPending == 0);
+}
+
+bool AsyncGLReader::queueRead(int width, int height, int64 frameNumber, double time)
+{
+	if (width <= 0 || height <= 0) return false;
+	if (isFull()) return false;
+
+	Slot& s = slots.getReference(writeIndex);
+
+	size_t size = (size_t)width * (size_t)height * 4;
+
+	if (s.pbo == 0) glGenBuffers(1, &s.pbo);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+	if (s.bufferSize != size)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+		s.bufferSize = size;
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, width, height, format, GL_UNSIGNED_BYTE, nullptr);
+	s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	s.width = width;
+	s.height = height;
+	s.frameNumber = frameNumber;
+	s.time = time;
+
+	writeIndex = (writeIndex + 1) % slots.size();
+	numPending++;
+
+	//make sure the fence is submitted, otherwise it may never signal without a wait
+	glFlush();
+
+	return true;
+}
+
+void AsyncGLReader::collect(std::function<void(const uint8* data, const Slot& slot)> callback)
+{
+	while (numPending > 0)
+	{
+		int readIndex = (writeIndex - numPending + slots.size()) % slots.size();
+		Slot& s = slots.getReference(readIndex);
+
+		GLenum result = glClientWaitSync(s.fence, 0, 0);
+		if (result == GL_TIMEOUT_EXPIRED) break;
+
+		glDeleteSync(s.fence);
+		s.fence = nullptr;
+		numPending--;
+
+		if (result == GL_WAIT_FAILED) continue;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+		if (const uint8* data = (const uint8*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)((size_t)s.width * s.height * 4), GL_MAP_READ_BIT))
+		{
+			callback(data, s);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		}
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+}
+
+void AsyncGLReader::release()
+{
+	for (auto& s : slots)
+	{
+		if (s.fence != nullptr) glDeleteSync(s.fence);
+		if (s.pbo != 0) glDeleteBuffers(1, &s.pbo);
+		s = Slot();
+	}
+
+	writeIndex = 0;
+	numPending = 0;
+}
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+	AsyncGLReader.h
+	Created: 19 Oct 2026 2:20:11pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Reads back framebuffers through a ring of PBOs guarded by fences, so glReadPixels never blocks the GL thread.
+	A read is queued on one frame and collected a frame or two later, once its fence has signaled.
+	Everything here must be called from the GL thread.
+*/
+class AsyncGLReader
+{
+public:
+	AsyncGLReader(int numBuffers = 3, GLenum format = juce::gl::GL_BGRA);
+	~AsyncGLReader();
+
+	struct Slot
+	{
+		GLuint pbo = 0;
+		GLsync fence = nullptr;
+		size_t bufferSize = 0;
+		int width = 0;
+		int height = 0;
+		int64 frameNumber = 0;
+		double time = 0;
+	};
+
+	GLenum format;
+	Array<Slot> slots;
+	int writeIndex;
+	int numPending;
+
+	//Queue a read of the framebuffer that is currently bound. Returns false if all the buffers are still in flight, in which case the frame is dropped.
+	bool queueRead(int width, int height, int64 frameNumber = 0, double time = 0);
+
+	//Calls the callback for every finished read, oldest first. Never waits on the GPU.
+	void collect(std::function<void(const uint8* data, const Slot& slot)> callback);
+
+	int getNumPending() const { return numPending; }
+	bool isFull() const { return numPending >= slots.size(); }
+
+	void release();
+};
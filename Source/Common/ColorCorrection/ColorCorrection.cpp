@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+	ColorCorrection.cpp
+	Created: 19 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+ColorCorrection::ColorCorrection(const String& name) :
+	EnablingControllableContainer(name),
+	shouldUploadLUT(false),
+	lutTexture(0),
+	uploadedLUTSize(0)
+{
+	for (int i = 0; i < 3; i++)
+	{
+		uploadedDomainMin[i] = 0;
+		uploadedDomainMax[i] = 1;
+	}
+
+	var zero; zero.append(0); zero.append(0); zero.append(0);
+	var one; one.append(1); one.append(1); one.append(1);
+
+	lift = addPoint3DParameter("Lift", "Raises or lowers the blacks, per channel");
+	lift->setBounds(-1, -1, -1, 1, 1, 1);
+	lift->setDefaultValue(zero);
+
+	gamma = addPoint3DParameter("Gamma", "Midtones adjustment, per channel");
+	gamma->setBounds(.1f, .1f, .1f, 4, 4, 4);
+	gamma->setDefaultValue(one);
+
+	gain = addPoint3DParameter("Gain", "Multiplies the whites, per channel");
+	gain->setBounds(0, 0, 0, 4, 4, 4);
+	gain->setDefaultValue(one);
+
+	lutFile = addFileParameter("LUT File", "3D LUT in .cube format, applied after Lift/Gamma/Gain", "");
+	lutFile->fileTypeFilter = "*.cube";
+	lutAmount = addFloatParameter("LUT Amount", "Mix between the original color and the LUT color", 1, 0, 1);
+	lutLoaded = addBoolParameter("LUT Loaded", "Is a valid LUT loaded", false);
+	lutLoaded->setControllableFeedbackOnly(true);
+	lutLoaded->isSavable = false;
+
+	enabled->setDefaultValue(false);
+	editorIsCollapsed = true;
+}
+
+ColorCorrection::~ColorCorrection()
+{
+	if (lutTexture != 0 && GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GLuint t = lutTexture;
+		GlContextHolder::getInstance()->context.executeOnGLThread([t](OpenGLContext&) { glDeleteTextures(1, &t); }, false);
+	}
+}
+
+void ColorCorrection::onContainerParameterChanged(Parameter* p)
+{
+	EnablingControllableContainer::onContainerParameterChanged(p);
+	if (p == lutFile) loadLUT();
+}
+
+void ColorCorrection::loadLUT()
+{
+	CubeLUT newLUT;
+	String error;
+
+	File f = lutFile->getFile();
+	bool success = false;
+	if (f.existsAsFile())
+	{
+		success = newLUT.loadFromFile(f, error);
+		if (success) NLOG(niceName, "LUT loaded : " << f.getFileName() << " (" << newLUT.size << "x" << newLUT.size << "x" << newLUT.size << ")");
+		else NLOGERROR(niceName, "Could not load LUT " << f.getFileName() << " : " << error);
+	}
+
+	{
+		GenericScopedLock lock(lutLock);
+		lut = newLUT;
+		shouldUploadLUT = true;
+	}
+
+	lutLoaded->setValue(success);
+}
+
+void ColorCorrection::updateGL()
+{
+	if (enabled->boolValue() && shouldUploadLUT) uploadLUT();
+}
+
+void ColorCorrection::setUniforms(GLuint shaderID, const String& prefix, int textureUnit)
+{
+	bool isActive = enabled->boolValue();
+	bool useLUT = isActive && lutTexture != 0 && lutAmount->floatValue() > 0;
+
+	const UniformLocations& u = getUniformLocations(shaderID, prefix);
+
+	//Always give the sampler its own unit, otherwise it would alias the 2D sampler on unit 0
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_3D, useLUT ? lutTexture : 0);
+	glUniform1i(u.lut, textureUnit);
+	glUniform1i(u.enabled, isActive ? 1 : 0);
+	glActiveTexture(GL_TEXTURE0);
+
+	if (!isActive) return;
+
+	glUniform3f(u.lift, lift->x, lift->y, lift->z);
+	glUniform3f(u.gamma, gamma->x, gamma->y, gamma->z);
+	glUniform3f(u.gain, gain->x, gain->y, gain->z);
+	glUniform1f(u.lutAmount, useLUT ? lutAmount->floatValue() : 0.f);
+	glUniform1f(u.lutSize, (float)uploadedLUTSize);
+	glUniform3f(u.lutDomainMin, uploadedDomainMin[0], uploadedDomainMin[1], uploadedDomainMin[2]);
+	glUniform3f(u.lutDomainMax, uploadedDomainMax[0], uploadedDomainMax[1], uploadedDomainMax[2]);
+}
+
+const ColorCorrection::UniformLocations& ColorCorrection::getUniformLocations(GLuint shaderID, const String& prefix)
+{
+	for (auto& u : uniformLocations) if (u.programID == shaderID) return u;
+
+	UniformLocations u;
+	u.programID = shaderID;
+	u.enabled = glGetUniformLocation(shaderID, (prefix + "CCEnabled").toRawUTF8());
+	u.lift = glGetUniformLocation(shaderID, (prefix + "Lift").toRawUTF8());
+	u.gamma = glGetUniformLocation(shaderID, (prefix + "Gamma").toRawUTF8());
+	u.gain = glGetUniformLocation(shaderID, (prefix + "Gain").toRawUTF8());
+	u.lut = glGetUniformLocation(shaderID, (prefix + "Lut").toRawUTF8());
+	u.lutSize = glGetUniformLocation(shaderID, (prefix + "LutSize").toRawUTF8());
+	u.lutAmount = glGetUniformLocation(shaderID, (prefix + "LutAmount").toRawUTF8());
+	u.lutDomainMin = glGetUniformLocation(shaderID, (prefix + "LutDomainMin").toRawUTF8());
+	u.lutDomainMax = glGetUniformLocation(shaderID, (prefix + "LutDomainMax").toRawUTF8());
+	uniformLocations.add(u);
+	return uniformLocations.getReference(uniformLocations.size() - 1);
+}
+
+void ColorCorrection::unbindTexture(int textureUnit)
+{
+	glActiveTexture(GL_TEXTURE0 + textureUnit);
+	glBindTexture(GL_TEXTURE_3D, 0);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+void ColorCorrection::uploadLUT()
+{
+	GenericScopedLock lock(lutLock);
+	shouldUploadLUT = false;
+
+	if (!lut.isValid())
+	{
+		if (lutTexture != 0) glDeleteTextures(1, &lutTexture);
+		lutTexture = 0;
+		uploadedLUTSize = 0;
+		return;
+	}
+
+	if (lutTexture == 0) glGenTextures(1, &lutTexture);
+
+	glBindTexture(GL_TEXTURE_3D, lutTexture);
+	//Nearest filtering, the shader does the tetrahedral interpolation itself
+	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+	glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB32F, lut.size, lut.size, lut.size, 0, GL_RGB, GL_FLOAT, lut.data.getRawDataPointer());
+	glBindTexture(GL_TEXTURE_3D, 0);
+	glGetError();
+
+	uploadedLUTSize = lut.size;
+	for (int i = 0; i < 3; i++)
+	{
+		uploadedDomainMin[i] = lut.domainMin[i];
+		uploadedDomainMax[i] = lut.domainMax[i];
+	}
+}
+
+void ColorCorrection::releaseGL()
+{
+	if (lutTexture != 0) glDeleteTextures(1, &lutTexture);
+	lutTexture = 0;
+	uploadedLUTSize = 0;
+	uniformLocations.clear(); //program ids are reused by the next context
+
+	GenericScopedLock lock(lutLock);
+	shouldUploadLUT = lut.isValid();
+}
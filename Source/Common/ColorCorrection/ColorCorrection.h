@@ -0,0 +1,65 @@
+/*
+  ==============================================================================
+
+	ColorCorrection.h
+	Created: 19 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ColorCorrection :
+	public EnablingControllableContainer
+{
+public:
+	ColorCorrection(const String& name = "Color Correction");
+	~ColorCorrection();
+
+	Point3DParameter* lift;
+	Point3DParameter* gamma;
+	Point3DParameter* gain;
+
+	FileParameter* lutFile;
+	FloatParameter* lutAmount;
+	BoolParameter* lutLoaded;
+
+	CriticalSection lutLock;
+	CubeLUT lut;
+	std::atomic<bool> shouldUploadLUT;
+
+	//GL side, only touched from the main GL thread. Output contexts sharing it only bind the texture.
+	GLuint lutTexture;
+	int uploadedLUTSize;
+	float uploadedDomainMin[3];
+	float uploadedDomainMax[3];
+
+	//Looked up once per program, the same correction is set on every frame
+	struct UniformLocations
+	{
+		GLuint programID = 0;
+		GLint enabled = -1;
+		GLint lift = -1;
+		GLint gamma = -1;
+		GLint gain = -1;
+		GLint lut = -1;
+		GLint lutSize = -1;
+		GLint lutAmount = -1;
+		GLint lutDomainMin = -1;
+		GLint lutDomainMax = -1;
+	};
+	Array<UniformLocations> uniformLocations;
+
+	void onContainerParameterChanged(Parameter* p) override;
+
+	void loadLUT();
+
+	//Uniforms are named prefix + "CCEnabled", "Lift", "Gamma", "Gain", "Lut", "LutSize", "LutAmount", "LutDomainMin", "LutDomainMax"
+	void updateGL(); //main GL thread only, uploads a newly loaded LUT
+	void setUniforms(GLuint shaderID, const String& prefix, int textureUnit);
+	const UniformLocations& getUniformLocations(GLuint shaderID, const String& prefix);
+	void unbindTexture(int textureUnit);
+	void uploadLUT();
+	void releaseGL();
+};
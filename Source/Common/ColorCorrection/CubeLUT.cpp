@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+	CubeLUT.cpp
+	Created: 19 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+CubeLUT::CubeLUT()
+{
+	clear();
+}
+
+void CubeLUT::clear()
+{
+	title = "";
+	size = 0;
+	data.clear();
+	for (int i = 0; i < 3; i++)
+	{
+		domainMin[i] = 0;
+		domainMax[i] = 1;
+	}
+}
+
+bool CubeLUT::loadFromFile(const File& f, String& error)
+{
+	if (!f.existsAsFile())
+	{
+		error = "File not found : " + f.getFullPathName();
+		return false;
+	}
+
+	return loadFromString(f.loadFileAsString(), error);
+}
+
+bool CubeLUT::loadFromString(const String& content, String& error)
+{
+	clear();
+
+	int expectedValues = 0;
+	const char* p = content.toRawUTF8();
+
+	//Parsing by hand instead of StringArray/tokens, a 65^3 LUT is more than 270k lines
+	while (*p != 0)
+	{
+		while (*p == ' ' || *p == '\t') p++;
+		const char* lineStart = p;
+		while (*p != 0 && *p != '\n' && *p != '\r') p++;
+		const char* lineEnd = p;
+		while (*p == '\n' || *p == '\r') p++;
+
+		if (lineStart == lineEnd || *lineStart == '#') continue;
+
+		if (CharacterFunctions::isLetter((juce_wchar)*lineStart))
+		{
+			StringArray tokens;
+			tokens.addTokens(String(CharPointer_UTF8(lineStart), CharPointer_UTF8(lineEnd)), " \t", "\"");
+			String key = tokens[0];
+
+			if (key == "TITLE") title = tokens[1].unquoted();
+			else if (key == "LUT_3D_SIZE")
+			{
+				size = tokens[1].getIntValue();
+				if (size < minSize || size > maxSize)
+				{
+					error = "LUT_3D_SIZE " + String(size) + " is not supported, size must be between " + String(minSize) + " and " + String(maxSize);
+					clear();
+					return false;
+				}
+				expectedValues = size * size * size * 3;
+				data.ensureStorageAllocated(expectedValues);
+			}
+			else if (key == "LUT_1D_SIZE")
+			{
+				error = "1D LUTs are not supported, only 3D LUTs";
+				clear();
+				return false;
+			}
+			else if (key == "DOMAIN_MIN" || key == "DOMAIN_MAX")
+			{
+				float* d = key == "DOMAIN_MIN" ? domainMin : domainMax;
+				for (int i = 0; i < 3; i++) d[i] = tokens[i + 1].getFloatValue();
+			}
+			else if (key == "LUT_3D_INPUT_RANGE")
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					domainMin[i] = tokens[1].getFloatValue();
+					domainMax[i] = tokens[2].getFloatValue();
+				}
+			}
+
+			continue;
+		}
+
+		if (expectedValues == 0)
+		{
+			error = "LUT data found before LUT_3D_SIZE";
+			clear();
+			return false;
+		}
+
+		const char* v = lineStart;
+		for (int i = 0; i < 3; i++)
+		{
+			char* next = nullptr;
+			float f = std::strtof(v, &next);
+			if (next == v || next > lineEnd)
+			{
+				error = "Malformed LUT line : " + String(CharPointer_UTF8(lineStart), CharPointer_UTF8(lineEnd));
+				clear();
+				return false;
+			}
+			data.add(f);
+			v = next;
+		}
+	}
+
+	if (expectedValues == 0 || data.size() != expectedValues)
+	{
+		error = "Expected " + String(expectedValues / 3) + " LUT entries, found " + String(data.size() / 3);
+		clear();
+		return false;
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (domainMax[i] <= domainMin[i])
+		{
+			error = "Invalid LUT domain";
+			clear();
+			return false;
+		}
+	}
+
+	return true;
+}
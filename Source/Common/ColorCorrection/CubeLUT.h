@@ -0,0 +1,35 @@
+/*
+  ==============================================================================
+
+	CubeLUT.h
+	Created: 19 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class CubeLUT
+{
+public:
+	CubeLUT();
+	~CubeLUT() {}
+
+	static const int minSize = 2;
+	static const int maxSize = 65;
+
+	String title;
+	int size;
+	float domainMin[3];
+	float domainMax[3];
+
+	//RGB triplets, red changing fastest then green then blue, as in the .cube spec (and as glTexImage3D expects)
+	Array<float> data;
+
+	bool isValid() const { return size >= minSize && data.size() == size * size * size * 3; }
+	void clear();
+
+	bool loadFromFile(const File& f, String& error);
+	bool loadFromString(const String& content, String& error);
+};
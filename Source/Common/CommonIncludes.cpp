@@ -16,7 +16,17 @@
 #include "NDI/ui/NDIDeviceChooser.cpp"
 #include "NDI/ui/NDIDeviceParameterUI.cpp"
 
+#include "PresentSync.cpp"
 #include "OpenGLManager.cpp"
+#include "AsyncGLReader.cpp"
+#include "LatencyHistogram.cpp"
+
+#include "NDI/NDIOutput.cpp"
+#include "NDI/NDIFrameUploader.cpp"
+#include "Recording/FrameRecorder.cpp"
+
+#include "ColorCorrection/CubeLUT.cpp"
+#include "ColorCorrection/ColorCorrection.cpp"
 
 #include "MediaTarget.cpp"
 
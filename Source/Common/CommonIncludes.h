@@ -31,7 +31,17 @@
 #include "NDI/ui/NDIDeviceParameterUI.h"
 
 #include "GLHelpers.h"
+#include "PresentSync.h"
 #include "OpenGLManager.h"
+#include "AsyncGLReader.h"
+#include "LatencyHistogram.h"
+
+#include "NDI/NDIOutput.h"
+#include "NDI/NDIFrameUploader.h"
+#include "Recording/FrameRecorder.h"
+
+#include "ColorCorrection/CubeLUT.h"
+#include "ColorCorrection/ColorCorrection.h"
 
 #include "MediaTarget.h"
 
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+	LatencyHistogram.cpp
+	Created: 19 Oct 2026 6:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+LatencyHistogram::LatencyHistogram(double binSizeMs, int numBins) :
+	binSize(binSizeMs)
+{
+	bins.insertMultiple(0, 0, numBins);
+	reset();
+}
+
+void LatencyHistogram::add(double ms)
+{
+	int bin = (int)(jmax(ms, 0.0) / binSize);
+	if (bin < bins.size()) bins.getReference(bin)++;
+	else overflow++;
+
+	count++;
+	sum += ms;
+	maxValue = jmax(maxValue, ms);
+}
+
+void LatencyHistogram::reset()
+{
+	bins.fill(0);
+	overflow = 0;
+	count = 0;
+	sum = 0;
+	maxValue = 0;
+}
+
+double LatencyHistogram::getMean() const
+{
+	return count > 0 ? sum / count : 0;
+}
+
+double LatencyHistogram::getPercentile(double p) const
+{
+	if (count == 0) return 0;
+
+	int target = jmax(1, (int)ceil(count * p));
+	int cumulated = 0;
+	for (int i = 0; i < bins.size(); i++)
+	{
+		cumulated += bins[i];
+		if (cumulated >= target) return jmin((i + 1) * binSize, maxValue);
+	}
+
+	//in the overflow bin, the max is the best we know
+	return maxValue;
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+	LatencyHistogram.h
+	Created: 19 Oct 2026 6:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Fixed bins histogram, cheap to fill and to read percentiles from. Not thread safe.
+class LatencyHistogram
+{
+public:
+	LatencyHistogram(double binSizeMs = .5, int numBins = 1000);
+	~LatencyHistogram() {}
+
+	double binSize;
+	Array<int> bins;
+	int overflow;
+	int count;
+	double sum;
+	double maxValue;
+
+	void add(double ms);
+	void reset();
+
+	double getMean() const;
+	double getPercentile(double p) const;
+};
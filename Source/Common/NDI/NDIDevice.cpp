@@ -19,78 +19,57 @@ NDIDevice::NDIDevice(NDIlib_source_t& info, Type t) :
 
 NDIInputDevice::NDIInputDevice(NDIlib_source_t & info) :
 	NDIDevice(info, NDI_IN),
-	Thread("NDI Input")
+	url(info.p_url_address)
 {
-	p_source = &info;
-	startThread();
 }
 
 NDIInputDevice::~NDIInputDevice()
 {
-	stopThread(100);
 }
 
 
 
-void NDIInputDevice::addNDIInputListener(NDIInputListener* newListener)
+NDIReceiver::NDIReceiver(const String& sourceName, const String& url, Bandwidth bandwidth) :
+	sourceName(sourceName),
+	url(url),
+	bandwidth(bandwidth),
+	recv(nullptr),
+	framesync(nullptr)
 {
-	inputListeners.add(newListener);
-	if (inputListeners.size() == 1)
+	NDIlib_source_t source;
+	source.p_ndi_name = this->sourceName.toRawUTF8();
+	source.p_url_address = this->url.isNotEmpty() ? this->url.toRawUTF8() : nullptr;
+
+	NDIlib_recv_create_v3_t recv_create_desc;
+	recv_create_desc.source_to_connect_to = source;
+	recv_create_desc.color_format = NDIlib_recv_color_format_fastest; //UYVY, or UYVA with alpha, as sent. Converted to RGB on the GPU.
+	recv_create_desc.bandwidth = bandwidth == LOWEST ? NDIlib_recv_bandwidth_lowest : NDIlib_recv_bandwidth_highest;
+	recv_create_desc.allow_video_fields = false;
+
+	recv = NDIlib_recv_create_v3(&recv_create_desc);
+	if (recv == nullptr)
 	{
-
-		NDIlib_recv_create_v3_t recv_create_desc;
-		recv_create_desc.color_format = NDIlib_recv_color_format_BGRX_BGRA; // Format de couleur souhaité
-
-		pNDI_recv = NDIlib_recv_create_v3(&recv_create_desc);
-		NDIlib_recv_connect(pNDI_recv, p_source);
-
-		// Destroy the NDI finder. We needed to have access to the pointers to p_sources[0]
-		//NDIlib_find_destroy(pNDI_find);
-
-		shouldProcess = true;
+		NLOGERROR("NDI", "Could not create NDI receiver for " << sourceName);
+		return;
 	}
+
+	framesync = NDIlib_framesync_create(recv);
+	if (framesync == nullptr) NLOGERROR("NDI", "Could not create NDI framesync for " << sourceName);
+	else NLOG("NDI", "Connected to " << sourceName << (bandwidth == LOWEST ? " (preview)" : ""));
 }
 
-void NDIInputDevice::removeNDIInputListener(NDIInputListener* listener) {
-	inputListeners.remove(listener);
-	if (inputListeners.size() == 0)
-	{
-		shouldProcess = false;
-		NDIlib_recv_destroy(pNDI_recv);
-		LOG("close connexion here");
-	}
+NDIReceiver::~NDIReceiver()
+{
+	if (framesync != nullptr) NDIlib_framesync_destroy(framesync);
+	if (recv != nullptr) NDIlib_recv_destroy(recv);
 }
 
-void NDIInputDevice::run()
+void NDIReceiver::captureVideo(NDIlib_video_frame_v2_t& frame)
 {
-	while (!threadShouldExit()) {
-		if (shouldProcess) {
-			NDIlib_video_frame_v2_t video_frame;
-
-			switch (NDIlib_recv_capture_v3(pNDI_recv, &video_frame, nullptr, nullptr, 100)) {
-				// No data
-			case NDIlib_frame_type_none:
-				//LOG("No data received");
-				break;
-
-				// Video data
-			case NDIlib_frame_type_video:
-
-				//LOG("Video data received : " <<  video_frame.xres << " / " << video_frame.yres);
-				inputListeners.call(&NDIInputListener::videoFrameReceived, &video_frame);
-				NDIlib_recv_free_video_v2(pNDI_recv, &video_frame);
-				break;
-
-				// Audio data
-			case NDIlib_frame_type_audio:
-				//LOG("Audio data received : " << audio_frame.no_samples);
-				//NDIlib_recv_free_audio_v2(pNDI_recv, &audio_frame);
-				break;
-			}
-		}
-		else {
-			wait(1000);
-		}
-	}
+	NDIlib_framesync_capture_video(framesync, &frame, NDIlib_frame_format_type_progressive);
 }
 
+void NDIReceiver::freeVideo(NDIlib_video_frame_v2_t& frame)
+{
+	NDIlib_framesync_free_video(framesync, &frame);
+}
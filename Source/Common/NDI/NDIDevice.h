@@ -23,38 +23,47 @@ public:
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIDevice)
 };
 
+//A source found on the network. Nothing is received from it until a media asks the manager for a receiver.
 class NDIInputDevice :
-	public NDIDevice,
-	public Thread
+	public NDIDevice
 {
 public:
 	NDIInputDevice(NDIlib_source_t &info);
 	~NDIInputDevice();
-	//std::unique_ptr<NDIInput> device;
 
-	NDIlib_recv_instance_t pNDI_recv;
-	NDIlib_source_t* p_source;
+	String url; //copied, the finder's source list is only valid until its next update
 
-	// Inherited via NDIInputCallback
-	//virtual void handleIncomingNDIMessage(NDIInput * source, const NDIMessage & message) override;
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIInputDevice)
+};
 
-	void run() override;
-	bool shouldProcess = false;
+/*
+	One connection to a source at a given bandwidth, shared by all the medias using it.
+	Created by the manager when a media subscribes, destroyed with its last user : the SDK's receive threads only live that long.
+	Shared pointers, so the pool can only take a new reference while another one is still alive.
+	Frames are pulled through a framesync at the consumer's own clock, it returns the latest frame, or the last one again, without waiting.
+*/
+class NDIReceiver
+{
+public:
+	enum Bandwidth { HIGHEST, LOWEST };
 
-	class NDIInputListener
-	{
-	public:
-		/** Destructor. */
-		virtual ~NDIInputListener() {}
-		virtual void videoFrameReceived(NDIlib_video_frame_v2_t* frame) {}
-		//virtual void noteOnReceived(const int&/*channel*/, const int&/*pitch*/, const int&/*velocity*/) {}
-	};
+	NDIReceiver(const String& sourceName, const String& url, Bandwidth bandwidth);
+	~NDIReceiver();
 
-	ListenerList<NDIInputListener> inputListeners;
-	void addNDIInputListener(NDIInputListener* newListener);
-	void removeNDIInputListener(NDIInputListener* listener);
+	String sourceName;
+	String url;
+	Bandwidth bandwidth;
 
+	NDIlib_recv_instance_t recv;
+	NDIlib_framesync_instance_t framesync;
 
-	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIInputDevice)
+	bool isValid() const { return framesync != nullptr; }
+
+	//p_data is null until the first frame has arrived. Every captured frame must be given back with freeVideo.
+	void captureVideo(NDIlib_video_frame_v2_t& frame);
+	void freeVideo(NDIlib_video_frame_v2_t& frame);
+
+	typedef std::shared_ptr<NDIReceiver> Ptr;
 
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIReceiver)
 };
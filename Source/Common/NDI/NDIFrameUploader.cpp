@@ -0,0 +1,287 @@
+/*
+  ==============================================================================
+
+	NDIFrameUploader.cpp
+	Created: 22 Oct 2026 10:12:41am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+using namespace juce::gl;
+
+NDIFrameUploader::NDIFrameUploader() :
+	pbos{},
+	pboSizes{},
+	pboIndex(0),
+	colorTexture(0),
+	alphaTexture(0),
+	colorTextureWidth(0),
+	colorTextureHeight(0),
+	alphaTextureWidth(0),
+	alphaTextureHeight(0),
+	format(UNSUPPORTED),
+	frameWidth(0),
+	frameHeight(0),
+	lastUnsupportedFourCC(0),
+	VAO(0),
+	glIsInit(false)
+{
+}
+
+NDIFrameUploader::~NDIFrameUploader()
+{
+}
+
+NDIFrameUploader::Format NDIFrameUploader::getFormat(NDIlib_FourCC_video_type_e fourCC)
+{
+	switch (fourCC)
+	{
+	case NDIlib_FourCC_video_type_UYVY: return UYVY;
+	case NDIlib_FourCC_video_type_UYVA: return UYVA;
+	case NDIlib_FourCC_video_type_BGRA:
+	case NDIlib_FourCC_video_type_RGBA: return RGBA;
+	case NDIlib_FourCC_video_type_BGRX:
+	case NDIlib_FourCC_video_type_RGBX: return RGBX;
+	default: return UNSUPPORTED;
+	}
+}
+
+bool NDIFrameUploader::upload(const NDIlib_video_frame_v2_t& frame)
+{
+	if (frame.p_data == nullptr || frame.xres <= 0 || frame.yres <= 0) return false;
+
+	Format f = getFormat(frame.FourCC);
+	if (f == UNSUPPORTED)
+	{
+		if (lastUnsupportedFourCC != (int)frame.FourCC) NLOGWARNING("NDI", "Unsupported NDI frame format : " << String::toHexString((int)frame.FourCC));
+		lastUnsupportedFourCC = (int)frame.FourCC;
+		return false;
+	}
+
+	if (!glIsInit) initGL();
+	if (shader == nullptr) return false;
+
+	const int width = frame.xres;
+	const int height = frame.yres;
+	const bool isYUV = f == UYVY || f == UYVA;
+
+	//Color plane, one RGBA texel is 2 pixels in UYVY
+	const int texelsPerRow = isYUV ? (width + 1) / 2 : width;
+	const int rowBytes = texelsPerRow * 4;
+	const int stride = frame.line_stride_in_bytes > 0 ? frame.line_stride_in_bytes : rowBytes;
+	if (stride < rowBytes) return false;
+
+	//The stride is kept as is when GL can skip the padding itself, otherwise rows are packed while copying
+	const bool keepStride = stride % 4 == 0;
+	const int colorPitch = keepStride ? stride : rowBytes;
+	const size_t colorSize = (size_t)colorPitch * height;
+
+	//UYVA alpha plane follows the color plane, at half its stride
+	const int alphaStride = stride / 2;
+	const int alphaPitch = width;
+	const size_t alphaSize = f == UYVA ? (size_t)alphaPitch * height : 0;
+	if (f == UYVA && alphaStride < width) return false;
+
+	const size_t size = colorSize + alphaSize;
+
+	GLuint& pbo = pbos[pboIndex];
+	if (pbo == 0) glGenBuffers(1, &pbo);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+	if (pboSizes[pboIndex] != size)
+	{
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		pboSizes[pboIndex] = size;
+	}
+
+	//Invalidating lets the driver hand out fresh memory instead of waiting for the last upload from this buffer
+	uint8* dest = (uint8*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (dest == nullptr)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		return false;
+	}
+
+	const uint8* src = frame.p_data;
+	if (keepStride) memcpy(dest, src, colorSize);
+	else for (int y = 0; y < height; y++) memcpy(dest + (size_t)y * rowBytes, src + (size_t)y * stride, rowBytes);
+
+	if (f == UYVA)
+	{
+		const uint8* alphaSrc = src + (size_t)stride * height;
+		uint8* alphaDest = dest + colorSize;
+		if (alphaStride == alphaPitch) memcpy(alphaDest, alphaSrc, alphaSize);
+		else for (int y = 0; y < height; y++) memcpy(alphaDest + (size_t)y * alphaPitch, alphaSrc + (size_t)y * alphaStride, alphaPitch);
+	}
+
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	//Uploads are only queued here, the data is read from the PBO when the GPU gets to them
+	GLenum uploadFormat = frame.FourCC == NDIlib_FourCC_video_type_BGRA || frame.FourCC == NDIlib_FourCC_video_type_BGRX ? GL_BGRA : GL_RGBA;
+
+	updateTexture(colorTexture, colorTextureWidth, colorTextureHeight, texelsPerRow, height, GL_RGBA8);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, colorPitch / 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texelsPerRow, height, uploadFormat, GL_UNSIGNED_BYTE, nullptr);
+
+	if (f == UYVA)
+	{
+		updateTexture(alphaTexture, alphaTextureWidth, alphaTextureHeight, width, height, GL_R8);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, (const void*)colorSize);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	pboIndex = (pboIndex + 1) % numBuffers;
+	format = f;
+	frameWidth = width;
+	frameHeight = height;
+
+	return true;
+}
+
+void NDIFrameUploader::updateTexture(GLuint& texture, int& textureWidth, int& textureHeight, int width, int height, GLenum internalFormat)
+{
+	if (texture == 0)
+	{
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D, texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	}
+	else glBindTexture(GL_TEXTURE_2D, texture);
+
+	if (textureWidth != width || textureHeight != height)
+	{
+		glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, internalFormat == GL_R8 ? GL_RED : GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		textureWidth = width;
+		textureHeight = height;
+	}
+}
+
+void NDIFrameUploader::draw(int width, int height)
+{
+	if (shader == nullptr || colorTexture == 0 || format == UNSUPPORTED) return;
+
+	//NDI follows BT.709 for HD and BT.601 for SD, video range. Columns are the Y, U and V contributions.
+	static const GLfloat bt709[9] = { 1, 1, 1, 0, -0.18732f, 1.8556f, 1.5748f, -0.46812f, 0 };
+	static const GLfloat bt601[9] = { 1, 1, 1, 0, -0.344136f, 1.772f, 1.402f, -0.714136f, 0 };
+
+	glViewport(0, 0, width, height);
+	glDisable(GL_BLEND);
+
+	shader->use();
+	GLuint programID = shader->getProgramID();
+	glUniform1i(glGetUniformLocation(programID, "format"), (GLint)format);
+	glUniform2i(glGetUniformLocation(programID, "size"), frameWidth, frameHeight);
+	glUniformMatrix3fv(glGetUniformLocation(programID, "yuvToRGB"), 1, GL_FALSE, frameHeight >= 720 ? bt709 : bt601);
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, format == UYVA ? alphaTexture : 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, colorTexture);
+
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glUseProgram(0);
+	glEnable(GL_BLEND);
+}
+
+void NDIFrameUploader::initGL()
+{
+	glIsInit = true;
+
+	const char* vertexShaderCode = R"(
+			#version 330
+			void main() {
+				vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+
+	//Pixels are fetched 1:1, the framebuffer has the frame's size. NDI rows are top first, GL rows bottom first.
+	//Chroma is sited on the even pixels, odd ones take the average with the next pair.
+	const char* fragmentShaderCode = R"(
+			#version 330
+			uniform sampler2D colorTex;
+			uniform sampler2D alphaTex;
+			uniform int format;
+			uniform ivec2 size;
+			uniform mat3 yuvToRGB;
+			out vec4 fragColor;
+
+			void main() {
+				ivec2 p = ivec2(int(gl_FragCoord.x), size.y - 1 - int(gl_FragCoord.y));
+
+				if (format >= 2) {
+					vec4 c = texelFetch(colorTex, p, 0);
+					fragColor = vec4(c.rgb, format == 2 ? c.a : 1.0);
+					return;
+				}
+
+				int tx = p.x >> 1;
+				vec4 t = texelFetch(colorTex, ivec2(tx, p.y), 0);
+				float y = (p.x & 1) == 0 ? t.g : t.a;
+				vec2 uv = t.rb;
+				if ((p.x & 1) == 1) uv = (uv + texelFetch(colorTex, ivec2(min(tx + 1, textureSize(colorTex, 0).x - 1), p.y), 0).rb) * 0.5;
+
+				vec3 yuv = vec3((y - 16.0 / 255.0) * 255.0 / 219.0, (uv - 128.0 / 255.0) * 255.0 / 224.0);
+				float a = format == 1 ? texelFetch(alphaTex, p, 0).r : 1.0;
+				fragColor = vec4(clamp(yuvToRGB * yuv, 0.0, 1.0), a);
+			}
+		)";
+
+	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	if (!shader->addVertexShader(vertexShaderCode) || !shader->addFragmentShader(fragmentShaderCode) || !shader->link())
+	{
+		NLOGERROR("NDI", "NDI frame conversion shader failed : " << shader->getLastError());
+		shader.reset();
+		return;
+	}
+
+	shader->use();
+	shader->setUniform("colorTex", 0);
+	shader->setUniform("alphaTex", 1);
+	glUseProgram(0);
+
+	glGenVertexArrays(1, &VAO);
+}
+
+void NDIFrameUploader::releaseGL()
+{
+	shader.reset();
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	if (colorTexture != 0) glDeleteTextures(1, &colorTexture);
+	if (alphaTexture != 0) glDeleteTextures(1, &alphaTexture);
+
+	for (int i = 0; i < numBuffers; i++)
+	{
+		if (pbos[i] != 0) glDeleteBuffers(1, &pbos[i]);
+		pbos[i] = 0;
+		pboSizes[i] = 0;
+	}
+
+	VAO = 0;
+	colorTexture = 0;
+	alphaTexture = 0;
+	colorTextureWidth = colorTextureHeight = 0;
+	alphaTextureWidth = alphaTextureHeight = 0;
+	format = UNSUPPORTED;
+	glIsInit = false;
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+	NDIFrameUploader.h
+	Created: 22 Oct 2026 10:12:41am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Uploads received NDI frames as they come from the SDK and converts them to RGBA on the GPU.
+	UYVY is uploaded as an RGBA texture of half the width, each texel holding U Y0 V Y1, and the UYVA alpha plane as a separate red texture.
+	The frame is copied once, with its line stride, into a mapped PBO : the texture upload runs from there and the NDI frame can be released right away.
+	Everything here must be called from the GL thread.
+*/
+class NDIFrameUploader
+{
+public:
+	NDIFrameUploader();
+	~NDIFrameUploader();
+
+	enum Format { UYVY, UYVA, RGBA, RGBX, UNSUPPORTED };
+
+	static const int numBuffers = 2;
+	GLuint pbos[numBuffers];
+	size_t pboSizes[numBuffers];
+	int pboIndex;
+
+	GLuint colorTexture;
+	GLuint alphaTexture;
+	int colorTextureWidth;
+	int colorTextureHeight;
+	int alphaTextureWidth;
+	int alphaTextureHeight;
+
+	Format format;
+	int frameWidth;
+	int frameHeight;
+	int lastUnsupportedFourCC;
+
+	std::unique_ptr<OpenGLShaderProgram> shader;
+	GLuint VAO;
+	bool glIsInit;
+
+	static Format getFormat(NDIlib_FourCC_video_type_e fourCC);
+
+	//Returns false if the frame couldn't be uploaded, the previous one is kept
+	bool upload(const NDIlib_video_frame_v2_t& frame);
+
+	//Draws the last uploaded frame in the bound framebuffer, as is : alpha is written, not blended
+	void draw(int width, int height);
+
+	void initGL();
+	void releaseGL();
+
+	void updateTexture(GLuint& texture, int& textureWidth, int& textureHeight, int width, int height, GLenum internalFormat);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIFrameUploader)
+};
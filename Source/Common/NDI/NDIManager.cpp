@@ -86,6 +86,44 @@ NDIInputDevice* NDIManager::getInputDeviceWithName(const String& name)
 	return nullptr;
 }
 
+NDIReceiver::Ptr NDIManager::getReceiver(NDIInputDevice* device, NDIReceiver::Bandwidth bandwidth)
+{
+	if (device == nullptr) return nullptr;
+
+	GenericScopedLock lock(receiversLock);
+	for (auto& p : receivers)
+	{
+		//Only succeeds while another reference is alive : a receiver whose last user just let go is left to its deleter
+		if (NDIReceiver::Ptr r = p.ref.lock())
+		{
+			if (r->sourceName == device->name && r->bandwidth == bandwidth) return r;
+		}
+	}
+
+	//The last release, from any thread, unregisters the receiver under the pool lock before deleting it
+	NDIReceiver::Ptr r(new NDIReceiver(device->name, device->url, bandwidth), [](NDIReceiver* dying)
+		{
+			if (NDIManager::getInstanceWithoutCreating() != nullptr) NDIManager::getInstance()->receiverDestroyed(dying);
+			delete dying;
+		});
+
+	if (!r->isValid()) return nullptr;
+
+	receivers.add({ r.get(), r });
+	return r;
+}
+
+void NDIManager::receiverDestroyed(NDIReceiver* r)
+{
+	GenericScopedLock lock(receiversLock);
+	for (int i = 0; i < receivers.size(); i++)
+	{
+		if (receivers.getReference(i).receiver != r) continue;
+		receivers.remove(i);
+		break;
+	}
+}
+
 void NDIManager::run()
 {
     while (!threadShouldExit()) {
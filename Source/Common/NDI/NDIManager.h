@@ -28,6 +28,19 @@ public:
 
 	NDIInputDevice * getInputDeviceWithName(const String &name);
 
+	//Receivers are pooled, medias using the same source at the same bandwidth share one connection
+	struct PooledReceiver
+	{
+		NDIReceiver* receiver;
+		std::weak_ptr<NDIReceiver> ref;
+	};
+
+	CriticalSection receiversLock;
+	Array<PooledReceiver> receivers;
+
+	NDIReceiver::Ptr getReceiver(NDIInputDevice* device, NDIReceiver::Bandwidth bandwidth);
+	void receiverDestroyed(NDIReceiver* r);
+
 	class NDIManagerListener
 	{
 	public:
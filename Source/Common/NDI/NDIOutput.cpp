@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+	NDIOutput.cpp
+	Created: 19 Oct 2026 2:20:11pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+#include "Engine/MGEngine.h"
+
+using namespace juce::gl;
+
+NDIOutput::NDIOutput(const String& name) :
+	name(name),
+	pNDI_send(nullptr),
+	inFlightFrame(nullptr),
+	VAO(0),
+	reader(3, GL_RGBA),
+	glIsInit(false),
+	frameNumber(0),
+	sentFrames(0),
+	droppedFrames(0)
+{
+	NDIlib_send_create_t sendDesc;
+	sendDesc.p_ndi_name = name.toRawUTF8();
+	sendDesc.p_groups = nullptr;
+	sendDesc.clock_video = false; //frames are paced by the GL render
+	sendDesc.clock_audio = false;
+
+	pNDI_send = NDIlib_send_create(&sendDesc);
+	if (pNDI_send == nullptr) NLOGERROR("NDI", "Could not create NDI sender " << name);
+	else NLOG("NDI", "NDI sender created : " << name);
+}
+
+NDIOutput::~NDIOutput()
+{
+	if (glIsInit && GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GlContextHolder::getInstance()->context.executeOnGLThread([this](OpenGLContext&) { releaseGL(); }, true);
+	}
+
+	if (pNDI_send != nullptr)
+	{
+		//synchronizing event, after this the in flight frame is not used by NDI anymore
+		NDIlib_send_send_video_async_v2(pNDI_send, nullptr);
+		NDIlib_send_destroy(pNDI_send);
+	}
+}
+
+void NDIOutput::initGL()
+{
+	//Packs 2 pixels in one RGBA texel as U Y0 V Y1, BT.709 video range. Rows are flipped so NDI gets the image top first.
+	const char* vertexShaderCode = R"(
+			#version 330
+			void main() {
+				vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+
+	const char* fragmentShaderCode = R"(
+			#version 330
+			uniform sampler2D tex;
+			out vec4 fragColor;
+
+			float luma(vec3 c) { return dot(c, vec3(0.2126, 0.7152, 0.0722)); }
+
+			void main() {
+				ivec2 size = textureSize(tex, 0);
+				int y = size.y - 1 - int(gl_FragCoord.y);
+				int x = int(gl_FragCoord.x) * 2;
+
+				vec3 c0 = texelFetch(tex, ivec2(x, y), 0).rgb;
+				vec3 c1 = texelFetch(tex, ivec2(min(x + 1, size.x - 1), y), 0).rgb;
+
+				float y0 = luma(c0);
+				float y1 = luma(c1);
+				vec3 c = (c0 + c1) * 0.5;
+				float yc = (y0 + y1) * 0.5;
+
+				float u = (c.b - yc) / 1.8556;
+				float v = (c.r - yc) / 1.5748;
+
+				fragColor = vec4(u * 224.0 / 255.0 + 128.0 / 255.0,
+								y0 * 219.0 / 255.0 + 16.0 / 255.0,
+								v * 224.0 / 255.0 + 128.0 / 255.0,
+								y1 * 219.0 / 255.0 + 16.0 / 255.0);
+			}
+		)";
+
+	uyvyShader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	if (!uyvyShader->addVertexShader(vertexShaderCode) || !uyvyShader->addFragmentShader(fragmentShaderCode) || !uyvyShader->link())
+	{
+		NLOGERROR("NDI", "UYVY conversion shader failed : " << uyvyShader->getLastError());
+		uyvyShader.reset();
+	}
+
+	glGenVertexArrays(1, &VAO);
+	glIsInit = true;
+}
+
+void NDIOutput::releaseGL()
+{
+	reader.release();
+	uyvyFBO.release();
+	uyvyShader.reset();
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	VAO = 0;
+	glIsInit = false;
+}
+
+void NDIOutput::sendFrame(OpenGLFrameBuffer& source)
+{
+	if (pNDI_send == nullptr || !source.isValid()) return;
+
+	if (!glIsInit) initGL();
+	if (uyvyShader == nullptr) return;
+
+	//First send what previous frames have finished reading back
+	reader.collect([this](const uint8* data, const AsyncGLReader::Slot& slot)
+		{
+			Frame* f = getFreeFrame(slot.width * 2, slot.height);
+			if (f == nullptr)
+			{
+				droppedFrames++;
+				return;
+			}
+
+			memcpy(f->data, data, f->size);
+			sendAsync(f);
+		});
+
+	//Then convert and queue the current one
+	int w = (source.getWidth() + 1) / 2;
+	int h = source.getHeight();
+
+	if (reader.isFull())
+	{
+		droppedFrames++;
+		return;
+	}
+
+	if (uyvyFBO.getWidth() != w || uyvyFBO.getHeight() != h)
+	{
+		uyvyFBO.release();
+		uyvyFBO.initialise(GlContextHolder::getInstance()->context, w, h);
+	}
+
+	uyvyFBO.makeCurrentRenderingTarget();
+	glViewport(0, 0, w, h);
+	glDisable(GL_BLEND); //alpha holds Y1, it must be written as is
+
+	uyvyShader->use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, source.getTextureID());
+	uyvyShader->setUniform("tex", 0);
+
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	glUseProgram(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	reader.queueRead(w, h, frameNumber++, Time::getMillisecondCounterHiRes());
+
+	uyvyFBO.releaseAsRenderingTarget();
+	glEnable(GL_BLEND);
+}
+
+NDIOutput::Frame* NDIOutput::getFreeFrame(int width, int height)
+{
+	Frame* f = nullptr;
+	if (!freeFrames.isEmpty()) f = freeFrames.removeAndReturn(freeFrames.size() - 1);
+	else if (framePool.size() < maxPoolSize) f = framePool.add(new Frame());
+
+	if (f == nullptr) return nullptr;
+
+	size_t size = (size_t)width * (size_t)height * 2;
+	if (f->size != size) f->data.allocate(size, false);
+	f->size = size;
+	f->width = width;
+	f->height = height;
+
+	return f;
+}
+
+void NDIOutput::sendAsync(Frame* f)
+{
+	int fps = RMPSettings::getInstance()->fpsLimit->enabled ? RMPSettings::getInstance()->fpsLimit->intValue() : 60;
+
+	NDIlib_video_frame_v2_t videoFrame;
+	videoFrame.xres = f->width;
+	videoFrame.yres = f->height;
+	videoFrame.FourCC = NDIlib_FourCC_video_type_UYVY;
+	videoFrame.frame_rate_N = jmax(fps, 1);
+	videoFrame.frame_rate_D = 1;
+	videoFrame.picture_aspect_ratio = 0; //square pixels
+	videoFrame.frame_format_type = NDIlib_frame_format_type_progressive;
+	videoFrame.timecode = NDIlib_send_timecode_synthesize;
+	videoFrame.p_data = f->data;
+	videoFrame.line_stride_in_bytes = f->width * 2;
+	videoFrame.p_metadata = nullptr;
+	videoFrame.timestamp = 0;
+
+	NDIlib_send_send_video_async_v2(pNDI_send, &videoFrame);
+
+	//Sending a new frame is the synchronizing event that gives back the previous one
+	if (inFlightFrame != nullptr) freeFrames.add(inFlightFrame);
+	inFlightFrame = f;
+
+	sentFrames++;
+}
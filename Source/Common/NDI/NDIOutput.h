@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+	NDIOutput.h
+	Created: 19 Oct 2026 2:20:11pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class NDIOutput
+{
+public:
+	NDIOutput(const String& name);
+	~NDIOutput();
+
+	String name;
+	NDIlib_send_instance_t pNDI_send;
+
+	struct Frame
+	{
+		HeapBlock<uint8> data;
+		size_t size = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	//Frames are recycled : one is in flight in the NDI async sender, the others are free for the next readbacks
+	static const int maxPoolSize = 3;
+	OwnedArray<Frame> framePool;
+	Array<Frame*> freeFrames;
+	Frame* inFlightFrame;
+
+	//GL side
+	std::unique_ptr<OpenGLShaderProgram> uyvyShader;
+	OpenGLFrameBuffer uyvyFBO;
+	GLuint VAO;
+	AsyncGLReader reader;
+	bool glIsInit;
+
+	int64 frameNumber;
+	std::atomic<int> sentFrames;
+	std::atomic<int> droppedFrames;
+
+	//Called from the GL thread, right after the source has been rendered
+	void sendFrame(OpenGLFrameBuffer& source);
+
+	void initGL();
+	void releaseGL();
+
+	Frame* getFreeFrame(int width, int height);
+	void sendAsync(Frame* f);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NDIOutput)
+};
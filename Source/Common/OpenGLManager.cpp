@@ -16,7 +16,8 @@ juce_ImplementSingleton(GlContextHolder)
 using namespace juce::gl;
 
 GlContextHolder::GlContextHolder() :
-	timeAtRender(0)
+	timeAtRender(0),
+	frameNumber(0)
 {
 	offScreenRenderComponent.setSize(1, 1); // (1, 1) is the minimum size for an OpenGL context (on Windows at least
 }
@@ -258,6 +259,7 @@ void GlContextHolder::renderOpenGL()
 	juce::OpenGLHelpers::clear(Colours::black);
 	checkComponents(false, true);
 
+	frameNumber++;
 	for (auto& c : sharedRenderers) c->context.triggerRepaint();
 }
 
@@ -42,6 +42,10 @@ public:
 
 	double timeAtRender;
 
+	//Incremented on each main render, the outputs repainted after it show this frame
+	std::atomic<int64> frameNumber;
+	PresentBarrier presentBarrier;
+
 	juce::OpenGLContext context;
 	juce::Component* parent;
 	Component offScreenRenderComponent;
@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+	PresentSync.cpp
+	Created: 19 Oct 2026 8:14:53pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+
+PresentBarrier::PresentBarrier() :
+	numArrived(0),
+	numHeld(0),
+	generation(0),
+	numRegroups(0),
+	generationFrame(-1),
+	generationReleaseTime(0)
+{
+}
+
+void PresentBarrier::addParticipant(void* participant)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	participants.addIfNotAlreadyThere(participant);
+}
+
+void PresentBarrier::removeParticipant(void* participant)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	participants.removeAllInstancesOf(participant);
+
+	//don't keep the others waiting for someone that left
+	releaseIfComplete();
+}
+
+int PresentBarrier::getNumParticipants()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return participants.size();
+}
+
+PresentBarrier::Result PresentBarrier::arriveAndWait(int64 frameNumber, double timeoutMs)
+{
+	Result result;
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if (participants.size() <= 1)
+	{
+		result.releaseTime = Time::getMillisecondCounterHiRes();
+		return result;
+	}
+
+	const auto timeout = std::chrono::microseconds((int64)(timeoutMs * 1000));
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	for (;;)
+	{
+		int64 gen = generation;
+		bool released = false;
+
+		if (numArrived > 0 && frameNumber > generationFrame)
+		{
+			//Ahead of the frame being gathered, wait for it to be presented then join the next group
+			result.heldBack = true;
+			numHeld++;
+			releaseIfComplete();
+			released = condition.wait_until(lock, deadline, [this, gen] { return generation != gen; });
+			if (released)
+			{
+				deadline = std::chrono::steady_clock::now() + timeout; //the others only start drawing this frame now
+				continue;
+			}
+		}
+		else
+		{
+			if (numArrived > 0 && frameNumber < generationFrame)
+			{
+				//Behind the frame being gathered, the outputs already waiting are ahead and go back to being held
+				numArrived = 0;
+				numRegroups++;
+				condition.notify_all();
+			}
+
+			if (numArrived == 0) generationFrame = frameNumber;
+			numArrived++;
+
+			int64 regroup = numRegroups;
+			releaseIfComplete();
+			released = condition.wait_until(lock, deadline, [this, gen, regroup] { return generation != gen || numRegroups != regroup; });
+			if (released && generation == gen) continue; //regrouped behind an older frame
+		}
+
+		if (!released)
+		{
+			//someone didn't render this frame (hidden window, stalled driver), let everyone go
+			release(Time::getMillisecondCounterHiRes());
+			result.timedOut = true;
+		}
+
+		result.releaseTime = generationReleaseTime;
+		return result;
+	}
+}
+
+void PresentBarrier::releaseIfComplete()
+{
+	if (numArrived > 0 && numArrived + numHeld >= participants.size()) release(Time::getMillisecondCounterHiRes());
+}
+
+void PresentBarrier::release(double time)
+{
+	//held outputs count themselves again in the next group
+	numArrived = 0;
+	numHeld = 0;
+	generation++;
+	generationReleaseTime = time;
+	condition.notify_all();
+}
+
+
+
+PresentStats::PresentStats() :
+	ControllableContainer("Present Sync"),
+	lastFrame(0),
+	lastOffset(0),
+	maxOffsetValue(0),
+	numLate(0),
+	numHeld(0),
+	isInSwapGroup(false),
+	hasNewResult(false),
+	isPublishing(false)
+{
+	frame = addIntParameter("Frame", "Last frame of the main context presented by this output", 0, 0);
+	offset = addFloatParameter("Offset", "Time between the barrier release and this output waking up, in ms", 0, 0);
+	maxOffset = addFloatParameter("Max Offset", "Worst offset since the last reset, in ms", 0, 0);
+	lateFrames = addIntParameter("Late Frames", "Frames where the barrier timed out waiting for another output", 0, 0);
+	heldFrames = addIntParameter("Held Frames", "Frames this output drew ahead of the others and held back until they presented theirs", 0, 0);
+	swapGroup = addBoolParameter("Swap Group", "This output is swap locked by the driver", false);
+
+	for (auto& c : controllables)
+	{
+		c->setControllableFeedbackOnly(true);
+		if (Parameter* p = dynamic_cast<Parameter*>(c)) p->isSavable = false;
+	}
+
+	resetTrigger = addTrigger("Reset", "Clear the max offset and the frame counters");
+
+	editorIsCollapsed = true;
+}
+
+PresentStats::~PresentStats()
+{
+	cancelPendingUpdate();
+	stopTimer();
+}
+
+void PresentStats::addResult(int64 frameNumber, const PresentBarrier::Result& result, double wakeTime)
+{
+	double o = wakeTime - result.releaseTime;
+	lastFrame = frameNumber;
+	lastOffset = o;
+	if (o > maxOffsetValue) maxOffsetValue = o;
+	if (result.timedOut) numLate++;
+	if (result.heldBack) numHeld++;
+
+	hasNewResult = true;
+	if (!isPublishing.exchange(true)) triggerAsyncUpdate();
+}
+
+void PresentStats::reset()
+{
+	maxOffsetValue = 0;
+	numLate = 0;
+	numHeld = 0;
+}
+
+void PresentStats::onContainerTriggerTriggered(Trigger* t)
+{
+	ControllableContainer::onContainerTriggerTriggered(t);
+	if (t == resetTrigger) reset();
+}
+
+void PresentStats::handleAsyncUpdate()
+{
+	startTimerHz(4);
+}
+
+void PresentStats::timerCallback()
+{
+	//sync was turned off or the outputs are gone
+	if (!hasNewResult.exchange(false))
+	{
+		stopTimer();
+		isPublishing = false;
+		return;
+	}
+
+	frame->setValue((int)(lastFrame % INT32_MAX));
+	offset->setValue(lastOffset.load());
+	maxOffset->setValue(maxOffsetValue.load());
+	lateFrames->setValue(numLate.load());
+	heldFrames->setValue(numHeld.load());
+	swapGroup->setValue(isInSwapGroup.load());
+}
+
+
+
+#if JUCE_LINUX
+typedef void* (*GLXGetCurrentDisplayFunc)();
+typedef unsigned long (*GLXGetCurrentDrawableFunc)();
+typedef int (*GLXQueryMaxSwapGroupsNVFunc)(void*, int, GLuint*, GLuint*);
+typedef int (*GLXJoinSwapGroupNVFunc)(void*, unsigned long, GLuint);
+typedef int (*GLXBindSwapBarrierNVFunc)(void*, GLuint, GLuint);
+#elif JUCE_WINDOWS
+typedef void* (__stdcall* WGLGetCurrentDCFunc)();
+typedef int (__stdcall* WGLQueryMaxSwapGroupsNVFunc)(void*, GLuint*, GLuint*);
+typedef int (__stdcall* WGLJoinSwapGroupNVFunc)(void*, GLuint);
+typedef int (__stdcall* WGLBindSwapBarrierNVFunc)(GLuint, GLuint);
+#endif
+
+bool NVSwapGroup::join(GLuint group)
+{
+#if JUCE_LINUX
+	static DynamicLibrary glLib("libGL.so.1");
+	auto getDisplay = (GLXGetCurrentDisplayFunc)glLib.getFunction("glXGetCurrentDisplay");
+	auto getDrawable = (GLXGetCurrentDrawableFunc)glLib.getFunction("glXGetCurrentDrawable");
+	auto queryMax = (GLXQueryMaxSwapGroupsNVFunc)OpenGLHelpers::getExtensionFunction("glXQueryMaxSwapGroupsNV");
+	auto joinGroup = (GLXJoinSwapGroupNVFunc)OpenGLHelpers::getExtensionFunction("glXJoinSwapGroupNV");
+	auto bindBarrier = (GLXBindSwapBarrierNVFunc)OpenGLHelpers::getExtensionFunction("glXBindSwapBarrierNV");
+	if (getDisplay == nullptr || getDrawable == nullptr || queryMax == nullptr || joinGroup == nullptr) return false;
+
+	void* display = getDisplay();
+	GLuint maxGroups = 0, maxBarriers = 0;
+	if (display == nullptr || !queryMax(display, 0, &maxGroups, &maxBarriers) || group > maxGroups) return false;
+	if (!joinGroup(display, getDrawable(), group)) return false;
+
+	//the barrier extends the lock to other machines with a sync card, optional
+	if (group > 0 && maxBarriers > 0 && bindBarrier != nullptr) bindBarrier(display, group, 1);
+	return true;
+
+#elif JUCE_WINDOWS
+	static DynamicLibrary glLib("opengl32.dll");
+	auto getDC = (WGLGetCurrentDCFunc)glLib.getFunction("wglGetCurrentDC");
+	auto queryMax = (WGLQueryMaxSwapGroupsNVFunc)OpenGLHelpers::getExtensionFunction("wglQueryMaxSwapGroupsNV");
+	auto joinGroup = (WGLJoinSwapGroupNVFunc)OpenGLHelpers::getExtensionFunction("wglJoinSwapGroupNV");
+	auto bindBarrier = (WGLBindSwapBarrierNVFunc)OpenGLHelpers::getExtensionFunction("wglBindSwapBarrierNV");
+	if (getDC == nullptr || queryMax == nullptr || joinGroup == nullptr) return false;
+
+	void* dc = getDC();
+	GLuint maxGroups = 0, maxBarriers = 0;
+	if (dc == nullptr || !queryMax(dc, &maxGroups, &maxBarriers) || group > maxGroups) return false;
+	if (!joinGroup(dc, group)) return false;
+
+	if (group > 0 && maxBarriers > 0 && bindBarrier != nullptr) bindBarrier(group, 1);
+	return true;
+
+#else
+	//macOS has no swap groups
+	return false;
+#endif
+}
+
+void NVSwapGroup::leave()
+{
+	join(0);
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+	PresentSync.h
+	Created: 19 Oct 2026 8:14:53pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Every output window renders on its own GL thread. The barrier holds each of them after their draw
+	until all live outputs are done, so the swaps that follow happen as close together as possible.
+	All outputs of a group present the same frame of the main context : an output that drew a newer frame
+	is held back until the others have presented theirs, then presented with the next group.
+*/
+class PresentBarrier
+{
+public:
+	PresentBarrier();
+	~PresentBarrier() {}
+
+	void addParticipant(void* participant);
+	void removeParticipant(void* participant);
+	int getNumParticipants();
+
+	struct Result
+	{
+		bool timedOut = false;
+		bool heldBack = false; //this output was ahead of the others and waited for them to present the previous frame
+		double releaseTime = 0;
+	};
+
+	//Called from each output's GL thread, right before its swap
+	Result arriveAndWait(int64 frameNumber, double timeoutMs);
+
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	Array<void*> participants;
+
+	int numArrived;
+	int numHeld;
+	int64 generation;
+	int64 numRegroups;
+	int64 generationFrame;
+	double generationReleaseTime;
+
+	void releaseIfComplete();
+	void release(double time);
+};
+
+//Feedback of one output, written from its GL thread and published on the message thread
+class PresentStats :
+	public ControllableContainer,
+	public Timer,
+	public AsyncUpdater
+{
+public:
+	PresentStats();
+	~PresentStats();
+
+	IntParameter* frame;
+	FloatParameter* offset;
+	FloatParameter* maxOffset;
+	IntParameter* lateFrames;
+	IntParameter* heldFrames;
+	BoolParameter* swapGroup;
+	Trigger* resetTrigger;
+
+	std::atomic<int64> lastFrame;
+	std::atomic<double> lastOffset;
+	std::atomic<double> maxOffsetValue;
+	std::atomic<int> numLate;
+	std::atomic<int> numHeld;
+	std::atomic<bool> isInSwapGroup;
+	std::atomic<bool> hasNewResult;
+	std::atomic<bool> isPublishing;
+
+	void addResult(int64 frameNumber, const PresentBarrier::Result& result, double wakeTime);
+	void reset();
+
+	void onContainerTriggerTriggered(Trigger* t) override;
+
+	//The timer only runs while synced outputs send results, it stops on the first tick without one
+	void handleAsyncUpdate() override;
+	void timerCallback() override;
+};
+
+//Hardware swap lock between windows on NVIDIA pro cards, through GLX_NV_swap_group / WGL_NV_swap_group
+class NVSwapGroup
+{
+public:
+	//Must be called on the GL thread with the output's context active
+	static bool join(GLuint group);
+	static void leave();
+};
@@ -0,0 +1,471 @@
+/*
+  ==============================================================================
+
+	FrameRecorder.cpp
+	Created: 19 Oct 2026 4:05:32pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Common/CommonIncludes.h"
+#include "Engine/MGEngine.h"
+
+using namespace juce::gl;
+
+FrameRecorder::FrameRecorder(const String& name) :
+	ControllableContainer(name),
+	poolLimit(8),
+	isRecording(false),
+	currentFormat(PNG_SEQUENCE),
+	nextFrameIndex(0),
+	ffmpegPipe(nullptr),
+	pipeFailed(false),
+	videoWidth(0),
+	videoHeight(0),
+	numRecorded(0),
+	numDropped(0),
+	hasLoggedError(false),
+	reader(3, GL_BGRA),
+	glIsInit(false)
+{
+	record = addBoolParameter("Record", "Start or stop the recording", false);
+	record->isSavable = false;
+
+	format = addEnumParameter("Format", "Image sequence, or a video encoded by ffmpeg");
+	format->addOption("PNG Sequence", PNG_SEQUENCE)->addOption("QOI Sequence", QOI_SEQUENCE)->addOption("FFmpeg", FFMPEG);
+
+	outputFolder = addFileParameter("Output Folder", "Folder where the recordings are written. If empty, a MapGyver folder in the user's videos", "");
+	outputFolder->directoryMode = true;
+	fileName = addStringParameter("File Name", "Base name of the recorded files, the date and time are appended", "recording");
+
+	numThreads = addIntParameter("Encoder Threads", "Number of threads encoding image sequences. FFmpeg always uses one, frames must stay in order", jlimit(1, 8, SystemStats::getNumCpus() / 2), 1, 32);
+	maxQueuedFrames = addIntParameter("Max Queued Frames", "Frames waiting to be encoded before new ones get dropped", 8, 2, 120);
+
+	ffmpegPath = addFileParameter("FFmpeg Executable", "Path to ffmpeg. If empty, ffmpeg is looked up in the PATH", "");
+	ffmpegArgs = addStringParameter("FFmpeg Arguments", "Output arguments given to ffmpeg", "-c:v libx264 -preset fast -crf 18 -pix_fmt yuv420p");
+	videoExtension = addStringParameter("Video Extension", "Extension of the file written by ffmpeg", "mp4");
+
+	queueDepth = addIntParameter("Queue Depth", "Frames waiting to be encoded", 0, 0);
+	recordedFrames = addIntParameter("Recorded Frames", "Frames written in the current recording", 0, 0);
+	droppedFrames = addIntParameter("Dropped Frames", "Frames dropped in the current recording because the encoders didn't keep up", 0, 0);
+	for (auto& p : { queueDepth, recordedFrames, droppedFrames })
+	{
+		p->setControllableFeedbackOnly(true);
+		p->isSavable = false;
+	}
+
+	editorIsCollapsed = true;
+}
+
+FrameRecorder::~FrameRecorder()
+{
+	stopRecording();
+	if (!waitForEncoders(10000)) NLOGWARNING(niceName, "Encoders are still busy, " << encoderPool->getNumJobs() << " frames will be lost");
+	encoderPool.reset();
+	closePipe();
+
+	if (glIsInit && GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GlContextHolder::getInstance()->context.executeOnGLThread([this](OpenGLContext&) { releaseGL(); }, true);
+	}
+}
+
+void FrameRecorder::onContainerParameterChanged(Parameter* p)
+{
+	ControllableContainer::onContainerParameterChanged(p);
+	if (p == record)
+	{
+		if (record->boolValue()) startRecording();
+		else stopRecording();
+	}
+}
+
+void FrameRecorder::startRecording(double fps)
+{
+	if (isRecording) return;
+
+	File folder = outputFolder->stringValue().isNotEmpty() ? outputFolder->getFile() : File::getSpecialLocation(File::userMoviesDirectory).getChildFile("MapGyver");
+	Result r = folder.createDirectory();
+	if (r.failed())
+	{
+		NLOGERROR(niceName, "Could not create the output folder " << folder.getFullPathName() << " : " << r.getErrorMessage());
+		record->setValue(false);
+		return;
+	}
+
+	//The previous recording may still be flushing, its jobs still use the pooled frames. Not waited for, it would block the message thread.
+	if (encoderPool != nullptr && encoderPool->getNumJobs() > 0)
+	{
+		NLOGERROR(niceName, "The previous recording is still being written, " << encoderPool->getNumJobs() << " frames left, try again later");
+		record->setValue(false);
+		return;
+	}
+	encoderPool.reset();
+	closePipe();
+
+	currentFormat = format->getValueDataAsEnum<RecordFormat>();
+	currentFolder = folder;
+	currentFileName = (fileName->stringValue().isNotEmpty() ? fileName->stringValue() : "recording") + "_" + Time::getCurrentTime().formatted("%Y%m%d_%H%M%S");
+
+	if (currentFormat == FFMPEG)
+	{
+		if (fps <= 0) fps = RMPSettings::getInstance()->fpsLimit->intValue();
+		String exe = ffmpegPath->stringValue().isNotEmpty() ? ffmpegPath->getFile().getFullPathName().quoted() : "ffmpeg";
+		videoFile = currentFolder.getChildFile(currentFileName + "." + videoExtension->stringValue().trimCharactersAtStart("."));
+		ffmpegCommand = exe + " -y -loglevel error -f rawvideo -pix_fmt bgra -r " + String(jmax(fps, 1.0)) + " -s %SIZE% -i - " + ffmpegArgs->stringValue() + " " + videoFile.getFullPathName().quoted();
+	}
+
+	{
+		GenericScopedLock lock(queueLock);
+		poolLimit = maxQueuedFrames->intValue();
+		while (framePool.size() > poolLimit) framePool.removeLast();
+		freeFrames.clear();
+		for (auto& f : framePool) freeFrames.add(f);
+
+		nextFrameIndex = 0;
+		pipeFailed = false;
+		videoWidth = 0;
+		videoHeight = 0;
+		numRecorded = 0;
+		numDropped = 0;
+		hasLoggedError = false;
+
+		//The pipe needs the frames in order, image files can be written in any order
+		encoderPool.reset(new ThreadPool(currentFormat == FFMPEG ? 1 : numThreads->intValue()));
+		isRecording = true;
+	}
+
+	NLOG(niceName, "Recording started : " << (currentFormat == FFMPEG ? videoFile.getFullPathName() : currentFolder.getChildFile(currentFileName).getFullPathName()));
+}
+
+void FrameRecorder::stopRecording()
+{
+	{
+		GenericScopedLock lock(queueLock);
+		if (!isRecording) return;
+		isRecording = false;
+
+		//Queued after the last frame, so the pipe closes once everything is written
+		if (currentFormat == FFMPEG) encoderPool->addJob([this] { closePipe(); });
+	}
+
+	NLOG(niceName, "Recording stopped, " << nextFrameIndex << " frames captured, " << numDropped.load() << " dropped");
+}
+
+bool FrameRecorder::waitForEncoders(int timeoutMs)
+{
+	if (encoderPool == nullptr) return true;
+
+	uint32 startTime = Time::getMillisecondCounter();
+	while (encoderPool->getNumJobs() > 0)
+	{
+		if (Time::getMillisecondCounter() - startTime > (uint32)timeoutMs) return false;
+		Thread::sleep(5);
+	}
+
+	return true;
+}
+
+void FrameRecorder::captureFrame(OpenGLFrameBuffer& source)
+{
+	if (!isRecording && reader.getNumPending() == 0) return;
+	if (!source.isValid()) return;
+
+	collectFrames();
+
+	if (isRecording)
+	{
+		if (reader.isFull()) numDropped++;
+		else
+		{
+			source.makeCurrentRenderingTarget();
+			reader.queueRead(source.getWidth(), source.getHeight());
+			source.releaseAsRenderingTarget();
+		}
+	}
+
+	int depth = 0;
+	{
+		GenericScopedLock lock(queueLock);
+		depth = framePool.size() - freeFrames.size();
+	}
+
+	queueDepth->setValue(depth);
+	recordedFrames->setValue(numRecorded.load());
+	droppedFrames->setValue(numDropped.load());
+}
+
+void FrameRecorder::collectFrames()
+{
+	glIsInit = true;
+
+	reader.collect([this](const uint8* data, const AsyncGLReader::Slot& slot)
+		{
+			GenericScopedLock lock(queueLock);
+			if (!isRecording) return; //stopped while this one was reading back
+
+			Frame* f = getFreeFrame(slot.width, slot.height);
+			if (f == nullptr)
+			{
+				numDropped++;
+				return;
+			}
+
+			memcpy(f->data, data, f->size);
+			f->index = nextFrameIndex++;
+			encoderPool->addJob([this, f] { encodeFrame(f); });
+		});
+}
+
+bool FrameRecorder::isReadyForFrame()
+{
+	collectFrames();
+	if (!isRecording || reader.isFull()) return false;
+
+	//every pending readback will need a free frame when collected
+	GenericScopedLock lock(queueLock);
+	return framePool.size() - freeFrames.size() + reader.getNumPending() < poolLimit;
+}
+
+void FrameRecorder::releaseGL()
+{
+	reader.release();
+	glIsInit = false;
+}
+
+FrameRecorder::Frame* FrameRecorder::getFreeFrame(int width, int height)
+{
+	Frame* f = nullptr;
+	if (!freeFrames.isEmpty()) f = freeFrames.removeAndReturn(freeFrames.size() - 1);
+	else if (framePool.size() < poolLimit) f = framePool.add(new Frame());
+
+	if (f == nullptr) return nullptr;
+
+	size_t size = (size_t)width * (size_t)height * 4;
+	if (f->size != size) f->data.allocate(size, false);
+	f->size = size;
+	f->width = width;
+	f->height = height;
+
+	return f;
+}
+
+void FrameRecorder::releaseFrame(Frame* f)
+{
+	GenericScopedLock lock(queueLock);
+	freeFrames.add(f);
+}
+
+void FrameRecorder::encodeFrame(Frame* f)
+{
+	bool success = false;
+
+	switch (currentFormat)
+	{
+	case PNG_SEQUENCE:
+		success = writePNG(getFrameFile(f->index, "png"), *f);
+		if (!success) logEncodeError("Could not write " + getFrameFile(f->index, "png").getFullPathName());
+		break;
+
+	case QOI_SEQUENCE:
+		success = writeQOI(getFrameFile(f->index, "qoi"), *f);
+		if (!success) logEncodeError("Could not write " + getFrameFile(f->index, "qoi").getFullPathName());
+		break;
+
+	case FFMPEG:
+		success = writePipe(f);
+		break;
+	}
+
+	if (success) numRecorded++;
+	else numDropped++;
+
+	releaseFrame(f);
+}
+
+bool FrameRecorder::writePipe(Frame* f)
+{
+	if (ffmpegPipe == nullptr)
+	{
+		if (pipeFailed || !openPipe(f->width, f->height)) return false;
+	}
+
+	if (f->width != videoWidth || f->height != videoHeight)
+	{
+		logEncodeError("Source size changed during the recording, frames are dropped until it gets back to " + String(videoWidth) + "x" + String(videoHeight));
+		return false;
+	}
+
+	//GL rows are bottom first
+	const size_t rowSize = (size_t)f->width * 4;
+	for (int y = f->height - 1; y >= 0; y--)
+	{
+		if (fwrite(f->data + (size_t)y * rowSize, 1, rowSize, ffmpegPipe) != rowSize)
+		{
+			logEncodeError("FFmpeg stopped accepting frames, check the arguments");
+			closePipe();
+			pipeFailed = true;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FrameRecorder::openPipe(int width, int height)
+{
+	String cmd = ffmpegCommand.replace("%SIZE%", String(width) + "x" + String(height));
+
+#if JUCE_WINDOWS
+	//cmd.exe strips the outer quotes of the whole command
+	ffmpegPipe = _popen(("\"" + cmd + "\"").toRawUTF8(), "wb");
+#else
+	ffmpegPipe = popen(cmd.toRawUTF8(), "w"); //SIGPIPE is ignored from the app start, see MapGyverApplication::initialiseInternal
+#endif
+
+	if (ffmpegPipe == nullptr)
+	{
+		logEncodeError("Could not start ffmpeg : " + cmd);
+		pipeFailed = true;
+		return false;
+	}
+
+	videoWidth = width;
+	videoHeight = height;
+	return true;
+}
+
+void FrameRecorder::closePipe()
+{
+	if (ffmpegPipe == nullptr) return;
+
+#if JUCE_WINDOWS
+	int result = _pclose(ffmpegPipe);
+#else
+	int result = pclose(ffmpegPipe);
+#endif
+	ffmpegPipe = nullptr;
+
+	if (result != 0) NLOGWARNING(niceName, "FFmpeg exited with code " << result);
+	else NLOG(niceName, "Video written : " << videoFile.getFullPathName());
+}
+
+void FrameRecorder::logEncodeError(const String& message)
+{
+	//only once per recording, this runs for every frame
+	if (hasLoggedError.exchange(true)) return;
+	NLOGERROR(niceName, message);
+}
+
+File FrameRecorder::getFrameFile(int64 index, const String& extension) const
+{
+	return currentFolder.getChildFile(currentFileName + "_" + String(index).paddedLeft('0', 6) + "." + extension);
+}
+
+bool FrameRecorder::writePNG(const File& file, const Frame& f)
+{
+	Image img(Image::ARGB, f.width, f.height, false);
+	{
+		//GL gives BGRA bottom first, same memory layout as PixelARGB, only the rows are flipped
+		Image::BitmapData bitmapData(img, Image::BitmapData::writeOnly);
+		const size_t rowSize = (size_t)f.width * 4;
+		for (int y = 0; y < f.height; y++) memcpy(bitmapData.getLinePointer(y), f.data + (size_t)(f.height - 1 - y) * rowSize, rowSize);
+	}
+
+	file.deleteFile();
+	FileOutputStream os(file);
+	if (!os.openedOk()) return false;
+
+	PNGImageFormat png;
+	return png.writeImageToStream(img, os);
+}
+
+bool FrameRecorder::writeQOI(const File& file, const Frame& f)
+{
+	//See https://qoiformat.org/qoi-specification.pdf
+	MemoryOutputStream os((size_t)f.width * f.height * 2);
+	os.write("qoif", 4);
+	os.writeIntBigEndian(f.width);
+	os.writeIntBigEndian(f.height);
+	os.writeByte(4); //RGBA
+	os.writeByte(0); //sRGB with linear alpha
+
+	uint8 index[64][4]{};
+	uint8 prev[4] = { 0, 0, 0, 255 };
+	int run = 0;
+
+	for (int y = f.height - 1; y >= 0; y--)
+	{
+		const uint8* row = f.data + (size_t)y * f.width * 4;
+		for (int x = 0; x < f.width; x++)
+		{
+			const uint8* p = row + x * 4;
+			uint8 px[4] = { p[2], p[1], p[0], p[3] };
+
+			if (memcmp(px, prev, 4) == 0)
+			{
+				if (++run == 62)
+				{
+					os.writeByte((char)(0xc0 | (run - 1)));
+					run = 0;
+				}
+				continue;
+			}
+
+			if (run > 0)
+			{
+				os.writeByte((char)(0xc0 | (run - 1)));
+				run = 0;
+			}
+
+			int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+			if (memcmp(index[hash], px, 4) == 0)
+			{
+				os.writeByte((char)hash);
+			}
+			else
+			{
+				memcpy(index[hash], px, 4);
+
+				if (px[3] == prev[3])
+				{
+					int8 vr = (int8)(px[0] - prev[0]);
+					int8 vg = (int8)(px[1] - prev[1]);
+					int8 vb = (int8)(px[2] - prev[2]);
+					int8 vgr = vr - vg;
+					int8 vgb = vb - vg;
+
+					if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+					{
+						os.writeByte((char)(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+					}
+					else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8)
+					{
+						os.writeByte((char)(0x80 | (vg + 32)));
+						os.writeByte((char)((vgr + 8) << 4 | (vgb + 8)));
+					}
+					else
+					{
+						os.writeByte((char)0xfe);
+						os.write(px, 3);
+					}
+				}
+				else
+				{
+					os.writeByte((char)0xff);
+					os.write(px, 4);
+				}
+			}
+
+			memcpy(prev, px, 4);
+		}
+	}
+
+	if (run > 0) os.writeByte((char)(0xc0 | (run - 1)));
+
+	const uint8 padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+	os.write(padding, 8);
+
+	return file.replaceWithData(os.getData(), os.getDataSize());
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+	FrameRecorder.h
+	Created: 19 Oct 2026 4:05:32pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Records a framebuffer to disk, as an image sequence or through an ffmpeg pipe.
+	Readback is asynchronous and encoding happens on a thread pool. When the encoders can't keep up,
+	recording frames are dropped : the live render never waits for the disk.
+*/
+class FrameRecorder :
+	public ControllableContainer
+{
+public:
+	FrameRecorder(const String& name = "Recorder");
+	~FrameRecorder();
+
+	enum RecordFormat { PNG_SEQUENCE, QOI_SEQUENCE, FFMPEG };
+
+	BoolParameter* record;
+	EnumParameter* format;
+	FileParameter* outputFolder;
+	StringParameter* fileName;
+	IntParameter* numThreads;
+	IntParameter* maxQueuedFrames;
+
+	FileParameter* ffmpegPath;
+	StringParameter* ffmpegArgs;
+	StringParameter* videoExtension;
+
+	IntParameter* queueDepth;
+	IntParameter* recordedFrames;
+	IntParameter* droppedFrames;
+
+	struct Frame
+	{
+		HeapBlock<uint8> data;
+		size_t size = 0;
+		int width = 0;
+		int height = 0;
+		int64 index = 0;
+	};
+
+	//Bounded queue, frames are allocated up to maxQueuedFrames and recycled once encoded
+	CriticalSection queueLock;
+	OwnedArray<Frame> framePool;
+	Array<Frame*> freeFrames;
+	int poolLimit;
+
+	std::unique_ptr<ThreadPool> encoderPool;
+
+	//Session state, captured when the recording starts so the workers never read parameters
+	std::atomic<bool> isRecording;
+	RecordFormat currentFormat;
+	File currentFolder;
+	String currentFileName;
+	String ffmpegCommand;
+	File videoFile;
+	int64 nextFrameIndex;
+
+	FILE* ffmpegPipe;
+	bool pipeFailed;
+	int videoWidth;
+	int videoHeight;
+
+	std::atomic<int> numRecorded;
+	std::atomic<int> numDropped;
+	std::atomic<bool> hasLoggedError;
+
+	//GL side
+	AsyncGLReader reader;
+	bool glIsInit;
+
+	void onContainerParameterChanged(Parameter* p) override;
+
+	//fps is only used by the ffmpeg pipe, 0 means the global fps limit
+	void startRecording(double fps = 0);
+	void stopRecording();
+	bool waitForEncoders(int timeoutMs); //false if they are still busy after the timeout
+
+	//Called from the GL thread, right after the source has been rendered
+	void captureFrame(OpenGLFrameBuffer& source);
+	void collectFrames();
+	void releaseGL();
+
+	//Offline renders can't drop frames, they wait for this before rendering the next one
+	bool isReadyForFrame();
+
+	Frame* getFreeFrame(int width, int height);
+	void releaseFrame(Frame* f);
+
+	//Called from the encoder threads
+	void encodeFrame(Frame* f);
+	bool writePipe(Frame* f);
+	bool openPipe(int width, int height);
+	void closePipe();
+	void logEncodeError(const String& message);
+
+	File getFrameFile(int64 index, const String& extension) const;
+
+	static bool writePNG(const File& file, const Frame& f);
+	static bool writeQOI(const File& file, const Frame& f);
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FrameRecorder)
+};
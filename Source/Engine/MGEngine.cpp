@@ -56,6 +56,7 @@ MGEngine::~MGEngine()
 	isClearing = true;
 
 	MediaManager::deleteInstance();
+	ShaderProgramCache::deleteInstance();
 	ScreenManager::deleteInstance();
 	NDIManager::deleteInstance();
 #if !JUCE_LINUX
@@ -107,9 +108,32 @@ void MGEngine::loadJSONDataInternalEngine(var data, ProgressTask* loadingTask)
 	ScreenTask->setProgress(1);
 	ScreenTask->end();
 
+	warmUpShaders();
 
 }
 
+void MGEngine::warmUpShaders()
+{
+	//Load all the programs of the project at once, from the binary cache when possible, so the shaders find them ready on their first render.
+	//Only the saved sources go to the GL thread, the medias may be deleted before it runs.
+	if (GlContextHolder::getInstanceWithoutCreating() == nullptr || !GlContextHolder::getInstance()->context.isAttached()) return;
+
+	StringArray fragmentSources;
+	for (auto& c : MediaManager::getInstance()->getAllContainers(true))
+	{
+		if (ShaderMedia* sm = dynamic_cast<ShaderMedia*>(c.get())) fragmentSources.addArray(sm->getProgramSources());
+	}
+
+	fragmentSources.removeDuplicates(false);
+	if (fragmentSources.isEmpty()) return;
+
+	String vertexSource = ShaderMedia::vertexShaderSource;
+	GlContextHolder::getInstance()->context.executeOnGLThread([vertexSource, fragmentSources](OpenGLContext&)
+		{
+			ShaderProgramCache::getInstance()->warmUp(vertexSource, fragmentSources);
+		}, false);
+}
+
 void MGEngine::childStructureChanged(ControllableContainer* cc)
 {
 	Engine::childStructureChanged(cc);
@@ -195,4 +219,16 @@ RMPSettings::RMPSettings() :
 {
 	fpsLimit = addIntParameter("FPS Limit", "Limit the framerate", 60, 0, 360);
 	fpsLimit->canBeDisabledByUser = true;
+
+	syncOutputs = addBoolParameter("Sync Outputs", "Output windows wait for each other after drawing so they all present the same frame together", true);
+	useSwapGroup = addBoolParameter("Use Swap Group", "Lock the output windows' swaps in the driver when supported (NVIDIA pro cards)", false);
+
+	shaderDiskCache = addBoolParameter("Shader Disk Cache", "Keep the compiled shaders on disk so they load without recompiling on the next launches", true);
+	clearShaderCache = addTrigger("Clear Shader Cache", "Delete all the compiled shaders stored on disk");
+}
+
+void RMPSettings::onContainerTriggerTriggered(Trigger* t)
+{
+	ControllableContainer::onContainerTriggerTriggered(t);
+	if (t == clearShaderCache) ShaderProgramCache::clearDiskCache();
 }
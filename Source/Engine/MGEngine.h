@@ -22,6 +22,12 @@ public:
 	~RMPSettings() {};
 
 	IntParameter* fpsLimit;
+	BoolParameter* syncOutputs;
+	BoolParameter* useSwapGroup;
+	BoolParameter* shaderDiskCache;
+	Trigger* clearShaderCache;
+
+	void onContainerTriggerTriggered(Trigger* t) override;
 };
 
 class MGEngine :
@@ -38,6 +44,7 @@ public:
 
 	var getJSONData(bool includeNonOverriden = false) override;
 	void loadJSONDataInternalEngine(var data, ProgressTask* loadingTask) override;
+	void warmUpShaders();
 
 	void childStructureChanged(ControllableContainer* cc) override;
 	void controllableFeedbackUpdate(ControllableContainer* cc, Controllable* c) override;
@@ -3,6 +3,10 @@
 #include "MainIncludes.h"
 #include "Engine/MGEngine.h"
 
+#if !JUCE_WINDOWS
+#include <signal.h>
+#endif
+
 MapGyverApplication::MapGyverApplication() :
 	OrganicApplication("MapGyver", true, ImageCache::getFromMemory(BinaryData::icon_png, BinaryData::icon_pngSize))
 {
@@ -11,6 +15,11 @@ MapGyverApplication::MapGyverApplication() :
 
 void MapGyverApplication::initialiseInternal(const String&)
 {
+#if !JUCE_WINDOWS
+	//Writing to a pipe whose reader quit, like a crashed ffmpeg recording, has to fail with EPIPE instead of killing the app
+	signal(SIGPIPE, SIG_IGN);
+#endif
+
 	engine.reset(new MGEngine());
 	if (useWindow) mainComponent.reset(new MainContentComponent());
 
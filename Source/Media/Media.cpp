@@ -19,12 +19,17 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 	width(nullptr),
 	height(nullptr),
 	customTime(-1),
+	isRenderingOffline(false),
 	mediaParams("Media Parameters"),
+	recorder("Recorder"),
 	alwaysRedraw(false),
 	shouldRedraw(false),
 	forceRedraw(false),
 	autoClearFrameBufferOnRender(true),
 	autoClearWhenNotUsed(true),
+	releaseFrameBufferWhenIdle(false),
+	contentGeneration(0),
+	contentIsUnchanged(false),
 	timeAtLastRender(0),
 	lastFPSTick(0),
 	lastFPSIndex(0),
@@ -36,6 +41,7 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 	setHasCustomColor(true);
 
 	addChildControllableContainer(&mediaParams);
+	addChildControllableContainer(&recorder);
 
 	isBeingUsed = addBoolParameter("isBeingUsed", "Is being used", false);
 	isBeingUsed->setControllableFeedbackOnly(true);
@@ -61,6 +67,12 @@ Media::Media(const String& name, var params, bool hasCustomSize) :
 
 Media::~Media()
 {
+	unregisterRenderer();
+}
+
+void Media::unregisterRenderer()
+{
+	//Blocks until the GL thread has called openGLContextClosing, a second call finds nothing to unregister
 	if (!manualRender && GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->unregisterOpenGlRenderer(this);
 }
 
@@ -97,6 +109,13 @@ void Media::renderOpenGLMedia(bool force)
 {
 	if (isClearing) return;
 
+	if (releaseFrameBufferWhenIdle && !force && !forceRedraw && !(enabled->boolValue() && isBeingUsed->boolValue()))
+	{
+		//Allocated again the next time it's used
+		if (frameBuffer.isValid()) frameBuffer.release();
+		return;
+	}
+
 	Point<int> size = getMediaSize();
 	if (size.isOrigin()) return;
 	if (frameBuffer.getWidth() != size.x || frameBuffer.getHeight() != size.y) initFrameBuffer();
@@ -143,10 +162,14 @@ void Media::renderOpenGLMedia(bool force)
 			frameBuffer.makeCurrentRenderingTarget();
 		}
 
+		bool contentChanged = autoClearFrameBufferOnRender;
 		if (shouldRenderContent)
 		{
+			contentIsUnchanged = false;
 			renderGLInternal();
+			if (!contentIsUnchanged) contentChanged = true;
 		}
+		if (contentChanged) contentGeneration++;
 
 		if (shouldGeneratePreviewImage)
 		{
@@ -158,6 +181,9 @@ void Media::renderOpenGLMedia(bool force)
 
 		if (!customFPSTick) FPSTick();
 	}
+
+	//every tick, so a still media still records at the render framerate
+	recorder.captureFrame(frameBuffer);
 }
 
 
@@ -255,6 +281,7 @@ void Media::setIsEditing(bool editing)
 void Media::openGLContextClosing()
 {
 	closeGLInternal();
+	recorder.releaseGL();
 	frameBuffer.release();
 }
 
@@ -265,6 +292,7 @@ void Media::initFrameBuffer()
 	if (frameBuffer.isValid()) frameBuffer.release();
 	frameBuffer.initialise(GlContextHolder::getInstance()->context, size.x, size.y);
 	shouldRedraw = true;
+	contentGeneration++;
 }
 
 Point<int> Media::getMediaSize()
@@ -273,6 +301,10 @@ Point<int> Media::getMediaSize()
 	return Point<int>(0, 0);
 }
 
+void Media::takeFrameTiming(Media* source)
+{
+	if (source != nullptr && source->frameTiming.arrivalTime > frameTiming.arrivalTime) frameTiming = source->frameTiming;
+}
 
 void Media::FPSTick()
 {
@@ -316,7 +348,8 @@ void Media::FPSTick()
 // ImageMedia
 
 ImageMedia::ImageMedia(const String& name, var params) :
-	Media(name, params)
+	Media(name, params),
+	frameArrivalTime(-1)
 {
 }
 
@@ -332,6 +365,13 @@ void ImageMedia::preRenderGLInternal()
 	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.getWidth(), image.getHeight(), GL_BGRA, GL_UNSIGNED_BYTE, bitmapData->data);
 	imageFBO.releaseAsRenderingTarget();
 	glBindTexture(GL_TEXTURE_2D, 0);
+
+	double arrival = frameArrivalTime;
+	if (arrival != frameTiming.arrivalTime)
+	{
+		frameTiming.arrivalTime = arrival;
+		frameTiming.uploadTime = Time::getMillisecondCounterHiRes();
+	}
 }
 
 void ImageMedia::renderGLInternal()
@@ -390,6 +430,11 @@ void ImageMedia::initImage(const Image& newImage)
 	}
 }
 
+void ImageMedia::markFrameArrival()
+{
+	frameArrivalTime = Time::getMillisecondCounterHiRes();
+}
+
 Point<int> ImageMedia::getMediaSize()
 {
 	return Point<int>(image.getWidth(), image.getHeight());
@@ -12,6 +12,15 @@
 
 
 
+//Timestamps of the frame currently in a media, from Time::getMillisecondCounterHiRes. -1 when unknown
+struct FrameTiming
+{
+	double arrivalTime = -1;
+	double uploadTime = -1;
+	double drawTime = -1;
+	double presentTime = -1;
+};
+
 class Media :
 	public BaseItem,
 	public OpenGLRenderer
@@ -27,6 +36,7 @@ public:
 	Trigger* generatePreview;
 
 	ControllableContainer mediaParams;
+	FrameRecorder recorder;
 
 	OpenGLFrameBuffer frameBuffer;
 	bool alwaysRedraw;
@@ -34,12 +44,21 @@ public:
 	bool forceRedraw;
 	bool autoClearFrameBufferOnRender;
 	bool autoClearWhenNotUsed;
+	bool releaseFrameBufferWhenIdle; //for medias that are only rendered for short periods, like transitions
 
 	Array<MediaTarget*> usedTargets;
 
+	FrameTiming frameTiming;
+	void takeFrameTiming(Media* source); //GL thread, medias drawing others carry the newest input frame they drew
+
+	//Incremented each time the framebuffer content changes, so medias drawing this one can tell a new frame from a repeat
+	int64 contentGeneration;
+	bool contentIsUnchanged; //set by renderGLInternal when it left the framebuffer as it was
+
 	bool manualRender;
 	double timeAtLastRender;
 	double customTime;
+	bool isRenderingOffline;
 
 	FloatParameter* currentFPS;
 	double lastFPSTick;
@@ -68,6 +87,9 @@ public:
 	virtual void renderGLInternal() {}
 	virtual void closeGLInternal() {}
 
+	//First thing in the destructor of medias holding GL resources : the GL thread stops rendering them and releases them through closeGLInternal, still reachable there
+	void unregisterRenderer();
+
 	OpenGLFrameBuffer* getFrameBuffer();
 	GLint getTextureID();
 
@@ -84,6 +106,10 @@ public:
 	virtual void handleStop() {}
 	virtual void handleStart() {}
 
+	//Offline renders step the time themselves and wait for every frame, medias must not depend on realtime anymore
+	virtual void setOfflineMode(bool offline) { isRenderingOffline = offline; }
+	virtual bool isOfflineFrameReady() { return true; } //message thread, polled after an offline seek until the frame for the new time is there
+
 
 	void setIsEditing(bool editing);
 	virtual void updateBeingUsed();
@@ -107,6 +133,10 @@ public:
 	std::shared_ptr<Image::BitmapData> bitmapData;
 	juce::OpenGLFrameBuffer imageFBO;
 
+	//Set by live inputs when a frame is received, carried to frameTiming when it is uploaded
+	std::atomic<double> frameArrivalTime;
+	void markFrameArrival();
+
 	virtual void preRenderGLInternal() override;
 	virtual void renderGLInternal();
 	virtual void initFrameBuffer() override;
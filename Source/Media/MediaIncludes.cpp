@@ -17,12 +17,16 @@
 
 #include "medias/composition/CompositionLayer/CompositionLayer.cpp"
 #include "medias/composition/CompositionLayer/CompositionLayerManager.cpp"
+#include "medias/composition/CompositionRenderer.cpp"
 #include "medias/composition/CompositionMedia.cpp"
 
 #include "medias/picture/PictureMedia.cpp"
 
 #include "medias/ndi/NDIMedia.cpp"
 #include "medias/sharedtexture/SharedTextureMedia.cpp"
+#include "medias/shader/ShaderUniformTable.cpp"
+#include "medias/shader/ShaderProgramCache.cpp"
+#include "medias/shader/ShaderPass.cpp"
 #include "medias/shader/ShaderMedia.cpp"
 
 #include "medias/color/ColorMedia.cpp"
@@ -42,6 +46,11 @@
 
 #include "medias/canvas/CanvasMedia.cpp"
 #include "medias/web/WebMedia.cpp"
+#include "medias/grid/GridItem.cpp"
+#include "medias/grid/GridLayerItemManager.cpp"
+#include "medias/grid/GridLayer.cpp"
+#include "medias/grid/GridLayerManager.cpp"
+#include "medias/grid/GridColumn.cpp"
 #include "medias/grid/GridMedia.cpp"
 
 
@@ -49,8 +58,10 @@
 
 #include "medias/sequence/MediaClip.cpp"
 #include "medias/sequence/ClipTransition.cpp"
+#include "medias/sequence/ClipIntervalIndex.cpp"
 #include "medias/sequence/MediaClipManager.cpp"
 #include "medias/sequence/MediaLayer.cpp"
+#include "medias/sequence/SequenceCompositor.cpp"
 #include "medias/sequence/SequenceMedia.cpp"
 #include "medias/sequence/ui/MediaClipUI.cpp"
 #include "medias/sequence/ui/MediaClipManagerUI.cpp"
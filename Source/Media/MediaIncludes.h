@@ -19,6 +19,7 @@
 
 #include "medias/composition/CompositionLayer/CompositionLayer.h"
 #include "medias/composition/CompositionLayer/CompositionLayerManager.h"
+#include "medias/composition/CompositionRenderer.h"
 #include "medias/composition/CompositionMedia.h"
 
 #include "medias/picture/PictureMedia.h"
@@ -29,11 +30,12 @@
 #include "medias/canvas/CanvasMedia.h"
 #include "medias/web/WebMedia.h"
 
-#include "medias/grid/GridMedia.h"
 #include "medias/grid/GridItem.h"
 #include "medias/grid/GridLayerItemManager.h"
 #include "medias/grid/GridLayer.h"
 #include "medias/grid/GridLayerManager.h"
+#include "medias/grid/GridColumn.h"
+#include "medias/grid/GridMedia.h"
 
 #include "medias/grid/ui/GridItemUI.h"
 #include "medias/grid/ui/GridBoard.h"
@@ -44,6 +46,9 @@
 
 #include "medias/interactiveapp/InteractiveAppMedia.h"
 
+#include "medias/shader/ShaderUniformTable.h"
+#include "medias/shader/ShaderProgramCache.h"
+#include "medias/shader/ShaderPass.h"
 #include "medias/shader/ShaderMedia.h"
 
 #include "medias/color/ColorMedia.h"
@@ -64,8 +69,10 @@
 
 #include "medias/sequence/MediaClip.h"
 #include "medias/sequence/ClipTransition.h"
+#include "medias/sequence/ClipIntervalIndex.h"
 #include "medias/sequence/MediaClipManager.h"
 #include "medias/sequence/MediaLayer.h"
+#include "medias/sequence/SequenceCompositor.h"
 #include "medias/sequence/SequenceMedia.h"
 #include "medias/sequence/ui/MediaClipUI.h"
 #include "medias/sequence/ui/MediaClipManagerUI.h"
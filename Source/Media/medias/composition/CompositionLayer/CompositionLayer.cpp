@@ -13,9 +13,19 @@
 
 #define COMPOSITION_TARGET_MEDIA_ID 0
 
+using namespace juce::gl;
+
 CompositionLayer::CompositionLayer(const String& name, var params) :
 	BaseItem(name),
-	media(nullptr)
+	media(nullptr),
+	transformIsDirty(true),
+	blendIsDirty(true),
+	glSourceFactor(GL_SRC_ALPHA),
+	glDestinationFactor(GL_ONE_MINUS_SRC_ALPHA),
+	needsRedraw(true),
+	wasDrawn(false),
+	drawnTexture(0),
+	drawnContentGeneration(-1)
 {
 	saveAndLoadRecursiveData = true;
 	canBeDisabled = true;
@@ -84,9 +94,54 @@ CompositionLayer::~CompositionLayer()
 {
 }
 
+void CompositionLayer::updateTransform()
+{
+	transformIsDirty = false;
+
+	Point<float> p = position->getPoint();
+	Point<float> s = size->getPoint();
+
+	//rotation is around the center of the layer
+	transform = AffineTransform::scale(s.x, s.y)
+		.translated(-s.x * .5f, -s.y * .5f)
+		.rotated(degreesToRadians(rotation->floatValue()))
+		.translated(p.x + s.x * .5f, p.y + s.y * .5f);
+
+	bounds = Rectangle<float>(0, 0, 1, 1).transformedBy(transform);
+}
+
+void CompositionLayer::updateBlendFactors()
+{
+	blendIsDirty = false;
+	glSourceFactor = getGLBlendFactor(blendFunctionSourceFactor->getValueDataAsEnum<blendOption>());
+	glDestinationFactor = getGLBlendFactor(blendFunctionDestinationFactor->getValueDataAsEnum<blendOption>());
+}
+
+GLenum CompositionLayer::getGLBlendFactor(blendOption o)
+{
+	switch (o)
+	{
+	case ZERO: return GL_ZERO;
+	case ONE: return GL_ONE;
+	case SRC_ALPHA: return GL_SRC_ALPHA;
+	case ONE_MINUS_SRC_ALPHA: return GL_ONE_MINUS_SRC_ALPHA;
+	case DST_ALPHA: return GL_DST_ALPHA;
+	case ONE_MINUS_DST_ALPHA: return GL_ONE_MINUS_DST_ALPHA;
+	case SRC_COLOR: return GL_SRC_COLOR;
+	case ONE_MINUS_SRC_COLOR: return GL_ONE_MINUS_SRC_COLOR;
+	case DST_COLOR: return GL_DST_COLOR;
+	case ONE_MINUS_DST_COLOR: return GL_ONE_MINUS_DST_COLOR;
+	}
+
+	return GL_ONE;
+}
+
 void CompositionLayer::onContainerParameterChangedInternal(Parameter* p)
 {
-	if (p == blendFunction) {
+	//dirty flags first, so the GL thread never sees the redraw before the new transform
+	if (p == position || p == size || p == rotation) transformIsDirty = true;
+	else if (p == blendFunctionSourceFactor || p == blendFunctionDestinationFactor) blendIsDirty = true;
+	else if (p == blendFunction) {
 		blendPreset preset = blendFunction->getValueDataAsEnum<blendPreset>();
 		if (preset == CUSTOM) {
 			blendFunctionSourceFactor->setControllableFeedbackOnly(false);
@@ -162,6 +217,8 @@ void CompositionLayer::onContainerParameterChangedInternal(Parameter* p)
 			}
 		}
 	}
+
+	needsRedraw = true;
 }
 
 void CompositionLayer::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
@@ -182,7 +239,7 @@ void CompositionLayer::setMedia(Media* m)
 	}
 
 	media = m;
-
+	needsRedraw = true;
 
 	if (media != nullptr)
 	{
@@ -35,6 +35,25 @@ public:
 	EnumParameter* blendFunctionSourceFactor;
 	EnumParameter* blendFunctionDestinationFactor;
 
+	//Cached for the compositor, recomputed on the GL thread after the parameters changed
+	std::atomic<bool> transformIsDirty;
+	std::atomic<bool> blendIsDirty;
+	AffineTransform transform; //unit square to canvas pixels
+	Rectangle<float> bounds; //in canvas pixels, rotation included
+	GLenum glSourceFactor;
+	GLenum glDestinationFactor;
+
+	//What was drawn last, for the compositor to only redraw what changed
+	std::atomic<bool> needsRedraw;
+	bool wasDrawn;
+	Rectangle<float> drawnBounds;
+	GLuint drawnTexture;
+	int64 drawnContentGeneration;
+
+	void updateTransform();
+	void updateBlendFactors();
+	static GLenum getGLBlendFactor(blendOption o);
+
 	virtual void onContainerParameterChangedInternal(Parameter* p);
 	virtual void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
@@ -20,10 +20,13 @@ public:
     ColorParameter* backgroundColor;
 
     CompositionLayerManager layers;
+    CompositionRenderer renderer;
 
     void clearItem() override;
 
+    void initFrameBuffer() override;
     void renderGLInternal() override;
+    void closeGLInternal() override;
 
     std::shared_ptr<Graphics> myGraphics = nullptr;
     std::shared_ptr<Graphics> workGraphics = nullptr;
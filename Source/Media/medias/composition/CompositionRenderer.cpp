@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+	CompositionRenderer.cpp
+	Created: 21 Oct 2026 3:16:27pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+CompositionRenderer::CompositionRenderer() :
+	canvasSizeLocation(-1),
+	VAO(0),
+	instanceVBO(0),
+	instanceBufferSize(0),
+	maxTextures(COMPOSITION_MAX_BATCH_TEXTURES),
+	glIsInit(false),
+	numDrawnLayers(0),
+	numBatches(0),
+	needsFullRedraw(true)
+{
+}
+
+CompositionRenderer::~CompositionRenderer()
+{
+}
+
+bool CompositionRenderer::render(CompositionLayerManager* layers, int width, int height, Colour background)
+{
+	if (!glIsInit) initGL();
+	if (shader == nullptr) return false;
+
+	Rectangle<int> canvas(0, 0, width, height);
+	Rectangle<float> dirtyArea = collectDirtyArea(layers, canvas.toFloat(), background);
+	if (dirtyArea.isEmpty()) return false;
+
+	//one more pixel for the linear filtering of the edges
+	Rectangle<int> area = dirtyArea.getSmallestIntegerContainer().expanded(1).getIntersection(canvas);
+	lastRedrawnArea = area;
+
+	bool isPartial = area != canvas;
+	if (isPartial)
+	{
+		glEnable(GL_SCISSOR_TEST);
+		glScissor(area.getX(), height - area.getBottom(), area.getWidth(), area.getHeight()); //GL rows are bottom first
+	}
+
+	glClearColor(background.getFloatRed(), background.getFloatGreen(), background.getFloatBlue(), background.getFloatAlpha());
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	buildBatches(layers, area.toFloat());
+	if (!batches.isEmpty()) drawBatches(width, height);
+
+	if (isPartial) glDisable(GL_SCISSOR_TEST);
+	return true;
+}
+
+void CompositionRenderer::initGL()
+{
+	glIsInit = true;
+
+	GLint maxUnits = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+	maxTextures = jlimit(1, COMPOSITION_MAX_BATCH_TEXTURES, (int)maxUnits);
+
+	//A unit quad as a triangle strip, placed by the instance transform. Texture rows are bottom first, canvas rows top first.
+	const char* vertexShaderCode = R"(
+			#version 330
+			layout(location = 0) in vec4 row0;
+			layout(location = 1) in vec4 row1;
+			layout(location = 2) in vec4 uvRect;
+			uniform vec2 canvasSize;
+			out vec2 uv;
+			out float alpha;
+			flat out int textureUnit;
+
+			void main() {
+				vec2 c = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+				vec2 p = vec2(dot(row0.xyz, vec3(c, 1.0)), dot(row1.xyz, vec3(c, 1.0)));
+				gl_Position = vec4(p.x / canvasSize.x * 2.0 - 1.0, 1.0 - p.y / canvasSize.y * 2.0, 0.0, 1.0);
+				uv = mix(uvRect.xy, uvRect.zw, vec2(c.x, 1.0 - c.y));
+				alpha = row0.w;
+				textureUnit = int(row1.w);
+			}
+		)";
+
+	//GLSL 330 only indexes sampler arrays with constants, hence the switch
+	String fragmentShaderCode = R"(
+			#version 330
+			uniform sampler2D textures[)" + String(maxTextures) + R"(];
+			in vec2 uv;
+			in float alpha;
+			flat in int textureUnit;
+			out vec4 fragColor;
+
+			vec4 sampleLayer() {
+				switch (textureUnit) {
+		)";
+
+	for (int i = 0; i < maxTextures; i++) fragmentShaderCode += "\t\t\t\tcase " + String(i) + ": return texture(textures[" + String(i) + "], uv);\n";
+
+	fragmentShaderCode += R"(
+				}
+				return vec4(0.0);
+			}
+
+			void main() {
+				fragColor = sampleLayer() * vec4(1.0, 1.0, 1.0, alpha);
+			}
+		)";
+
+	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	if (!shader->addVertexShader(vertexShaderCode) || !shader->addFragmentShader(fragmentShaderCode) || !shader->link())
+	{
+		LOGERROR("Composition shader failed : " << shader->getLastError());
+		shader.reset();
+		return;
+	}
+
+	shader->use();
+	canvasSizeLocation = glGetUniformLocation(shader->getProgramID(), "canvasSize");
+
+	GLint units[COMPOSITION_MAX_BATCH_TEXTURES];
+	for (int i = 0; i < maxTextures; i++) units[i] = i;
+	glUniform1iv(glGetUniformLocation(shader->getProgramID(), "textures"), maxTextures, units);
+	glUseProgram(0);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &instanceVBO);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	for (GLuint i = 0; i < 3; i++)
+	{
+		glEnableVertexAttribArray(i);
+		glVertexAttribDivisor(i, 1);
+	}
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CompositionRenderer::releaseGL()
+{
+	shader.reset();
+	if (instanceVBO != 0) glDeleteBuffers(1, &instanceVBO);
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	instanceVBO = 0;
+	VAO = 0;
+	instanceBufferSize = 0;
+	glIsInit = false;
+	needsFullRedraw = true;
+}
+
+Rectangle<float> CompositionRenderer::collectDirtyArea(CompositionLayerManager* layers, const Rectangle<float>& canvas, Colour background)
+{
+	bool fullRedraw = needsFullRedraw || background != drawnBackground;
+
+	//Added, removed or reordered layers
+	if (drawnLayers.size() != layers->items.size() || !std::equal(drawnLayers.begin(), drawnLayers.end(), layers->items.begin()))
+	{
+		drawnLayers.clearQuick();
+		drawnLayers.addArray(layers->items);
+		fullRedraw = true;
+	}
+
+	needsFullRedraw = false;
+	drawnBackground = background;
+
+	Rectangle<float> dirtyArea;
+	for (auto& l : layers->items)
+	{
+		bool visible = isLayerVisible(l, canvas);
+		GLuint texture = visible ? (GLuint)l->media->getTextureID() : 0;
+		int64 generation = visible ? l->media->contentGeneration : -1;
+
+		//bounds are compared too, a moved layer is a change even if its redraw flag was consumed earlier
+		bool changed = l->needsRedraw.exchange(false) || visible != l->wasDrawn
+			|| (visible && (texture != l->drawnTexture || generation != l->drawnContentGeneration || l->bounds != l->drawnBounds));
+
+		if (changed)
+		{
+			//where it was and where it is now
+			if (l->wasDrawn) dirtyArea = dirtyArea.getUnion(l->drawnBounds);
+			if (visible) dirtyArea = dirtyArea.getUnion(l->bounds);
+		}
+
+		l->wasDrawn = visible;
+		l->drawnBounds = l->bounds;
+		l->drawnTexture = texture;
+		l->drawnContentGeneration = generation;
+	}
+
+	if (fullRedraw) return canvas;
+	return dirtyArea.getIntersection(canvas);
+}
+
+bool CompositionRenderer::isLayerVisible(CompositionLayer* l, const Rectangle<float>& area)
+{
+	if (!l->enabled->boolValue()) return false;
+
+	Media* m = l->media;
+	if (m == nullptr || !m->enabled->boolValue()) return false;
+
+	if (l->transformIsDirty) l->updateTransform();
+	if (!l->bounds.intersects(area)) return false;
+
+	if (l->blendIsDirty) l->updateBlendFactors();
+	if (l->glSourceFactor == GL_ZERO && l->glDestinationFactor == GL_ONE) return false; //leaves the canvas as is
+
+	//The layer alpha only scales the source's .a, a transparent layer leaves the canvas as is only when the source is weighted by it and the destination kept
+	bool alphaWeighted = l->glSourceFactor == GL_SRC_ALPHA && (l->glDestinationFactor == GL_ONE || l->glDestinationFactor == GL_ONE_MINUS_SRC_ALPHA);
+	if (alphaWeighted && l->alpha->floatValue() <= 0) return false;
+
+	return m->getTextureID() != 0;
+}
+
+void CompositionRenderer::buildBatches(CompositionLayerManager* layers, const Rectangle<float>& area)
+{
+	instances.clearQuick();
+	batches.clearQuick();
+
+	//Last layer is drawn first, the first one ends up on top
+	for (int i = layers->items.size() - 1; i >= 0; i--)
+	{
+		CompositionLayer* l = layers->items[i];
+		if (!isLayerVisible(l, area)) continue;
+
+		float alpha = l->alpha->floatValue();
+		GLuint texture = (GLuint)l->media->getTextureID();
+
+		Batch* b = batches.isEmpty() ? nullptr : &batches.getReference(batches.size() - 1);
+		int unit = -1;
+		if (b != nullptr && b->sourceFactor == l->glSourceFactor && b->destinationFactor == l->glDestinationFactor) unit = getTextureUnit(*b, texture);
+
+		if (unit < 0)
+		{
+			batches.add({ l->glSourceFactor, l->glDestinationFactor, instances.size(), 0, {}, 0 });
+			b = &batches.getReference(batches.size() - 1);
+			unit = getTextureUnit(*b, texture);
+		}
+
+		const AffineTransform& t = l->transform;
+		instances.add({
+			{ t.mat00, t.mat01, t.mat02, alpha },
+			{ t.mat10, t.mat11, t.mat12, (float)unit },
+			{ 0, 0, 1, 1 }
+			});
+		b->count++;
+	}
+
+	numDrawnLayers = instances.size();
+	numBatches = batches.size();
+}
+
+void CompositionRenderer::drawBatches(int width, int height)
+{
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+	//Orphan the previous frame's data so the driver doesn't wait for it
+	size_t size = (size_t)instances.size() * sizeof(Instance);
+	if (size > instanceBufferSize) instanceBufferSize = size * 2;
+	glBufferData(GL_ARRAY_BUFFER, instanceBufferSize, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, instances.getRawDataPointer());
+
+	shader->use();
+	glUniform2f(canvasSizeLocation, (float)width, (float)height);
+	glEnable(GL_BLEND);
+
+	for (auto& b : batches)
+	{
+		glBlendFunc(b.sourceFactor, b.destinationFactor);
+
+		for (int i = 0; i < b.numTextures; i++)
+		{
+			glActiveTexture(GL_TEXTURE0 + i);
+			glBindTexture(GL_TEXTURE_2D, b.textures[i]);
+		}
+
+		const size_t offset = (size_t)b.start * sizeof(Instance);
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (const void*)(offset + offsetof(Instance, row0)));
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (const void*)(offset + offsetof(Instance, row1)));
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (const void*)(offset + offsetof(Instance, uvs)));
+
+		glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, b.count);
+	}
+
+	for (int i = maxTextures - 1; i >= 0; i--)
+	{
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	glUseProgram(0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+int CompositionRenderer::getTextureUnit(Batch& b, GLuint texture)
+{
+	for (int i = 0; i < b.numTextures; i++) if (b.textures[i] == texture) return i;
+	if (b.numTextures >= maxTextures) return -1;
+
+	b.textures[b.numTextures] = texture;
+	return b.numTextures++;
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+	CompositionRenderer.h
+	Created: 21 Oct 2026 3:16:27pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define COMPOSITION_MAX_BATCH_TEXTURES 16
+
+/*
+	Draws the layers of a composition with as few draw calls as possible.
+	Invisible layers are culled, then consecutive layers sharing the same blend factors are drawn as one instanced draw,
+	each instance carrying its transform, alpha, uvs and the texture unit of its media.
+	The framebuffer is kept between frames : only the area covered by the layers that changed is cleared and redrawn, under a scissor.
+*/
+class CompositionRenderer
+{
+public:
+	CompositionRenderer();
+	~CompositionRenderer();
+
+	struct Instance
+	{
+		float row0[4]; //transform first row, alpha
+		float row1[4]; //transform second row, texture unit
+		float uvs[4]; //u0 v0 u1 v1
+	};
+
+	struct Batch
+	{
+		GLenum sourceFactor;
+		GLenum destinationFactor;
+		int start;
+		int count;
+		GLuint textures[COMPOSITION_MAX_BATCH_TEXTURES];
+		int numTextures;
+	};
+
+	std::unique_ptr<OpenGLShaderProgram> shader;
+	GLint canvasSizeLocation;
+	GLuint VAO;
+	GLuint instanceVBO;
+	size_t instanceBufferSize;
+	int maxTextures;
+	bool glIsInit;
+
+	//Rebuilt every frame, only reallocated when the composition grows
+	Array<Instance> instances;
+	Array<Batch> batches;
+
+	int numDrawnLayers;
+	int numBatches;
+
+	//Dirty tracking, anything that isn't tied to a single layer redraws everything
+	bool needsFullRedraw;
+	Array<CompositionLayer*> drawnLayers;
+	Colour drawnBackground;
+	Rectangle<int> lastRedrawnArea;
+
+	//Called from the media's render, with its framebuffer bound. Returns false if nothing changed and the framebuffer was left as is.
+	bool render(CompositionLayerManager* layers, int width, int height, Colour background);
+
+	void initGL();
+	void releaseGL();
+
+	Rectangle<float> collectDirtyArea(CompositionLayerManager* layers, const Rectangle<float>& canvas, Colour background);
+	bool isLayerVisible(CompositionLayer* l, const Rectangle<float>& area);
+
+	void buildBatches(CompositionLayerManager* layers, const Rectangle<float>& area);
+	void drawBatches(int width, int height);
+	int getTextureUnit(Batch& b, GLuint texture);
+
+	JUCE_DECLARE_NON_COPYABLE(CompositionRenderer)
+};
@@ -8,4 +8,47 @@
   ==============================================================================
 */
 
-#include "GridColumn.h"
+#include "Media/MediaIncludes.h"
+
+GridColumn::GridColumn(var params) :
+	BaseItem(getTypeString()),
+	grid(nullptr)
+{
+	itemDataType = "GridColumn";
+	launchTrigger = addTrigger("Launch", "Launch the items of this column in all layers, layers without one are stopped");
+}
+
+GridColumn::~GridColumn()
+{
+}
+
+void GridColumn::onContainerTriggerTriggered(Trigger* t)
+{
+	if (t == launchTrigger)
+	{
+		if (grid != nullptr) grid->launchColumn(grid->columns.items.indexOf(this));
+	}
+}
+
+
+GridColumnManager::GridColumnManager(GridMedia* grid) :
+	BaseManager("Columns"),
+	grid(grid)
+{
+	itemDataType = "GridColumn";
+	selectItemWhenCreated = false;
+}
+
+GridColumnManager::~GridColumnManager()
+{
+}
+
+void GridColumnManager::addItemInternal(GridColumn* column, var data)
+{
+	column->grid = grid;
+}
+
+void GridColumnManager::removeItemInternal(GridColumn* column)
+{
+	column->grid = nullptr;
+}
@@ -9,3 +9,34 @@
 */
 
 #pragma once
+
+class GridMedia;
+
+//A scene : launching it launches the item at its index in every layer, on the same frame
+class GridColumn :
+	public BaseItem
+{
+public:
+	GridColumn(var params = var());
+	~GridColumn();
+
+	Trigger* launchTrigger;
+	GridMedia* grid;
+
+	void onContainerTriggerTriggered(Trigger* t) override;
+
+	DECLARE_TYPE("Grid Column")
+};
+
+class GridColumnManager :
+	public BaseManager<GridColumn>
+{
+public:
+	GridColumnManager(GridMedia* grid);
+	~GridColumnManager();
+
+	GridMedia* grid;
+
+	void addItemInternal(GridColumn* column, var data) override;
+	void removeItemInternal(GridColumn* column) override;
+};
@@ -8,4 +8,132 @@
   ==============================================================================
 */
 
-#include "GridItem.h"
+#include "Media/MediaIncludes.h"
+
+#define GRIDITEM_TARGET_MEDIA_ID 0
+
+GridItem::GridItem(var params) :
+	BaseItem(getTypeString()),
+	media(nullptr),
+	layer(nullptr),
+	isPlaying(false),
+	isQueued(false),
+	isPreloaded(false),
+	wasPlaying(false),
+	isPrerolled(false)
+{
+	itemDataType = "GridItem";
+
+	targetMedia = addTargetParameter("Media", "The media played when this item is launched", MediaManager::getInstance());
+	targetMedia->maxDefaultSearchLevel = 0;
+	targetMedia->targetType = TargetParameter::CONTAINER;
+
+	launchTrigger = addTrigger("Launch", "Switch the layer to this item, on the next beat or bar if the grid is quantized");
+
+	state = addEnumParameter("State", "Playing, queued for the next launch time, preloaded because it's likely to be launched next, or idle");
+	state->addOption("Idle", IDLE)->addOption("Preloaded", PRELOADED)->addOption("Queued", QUEUED)->addOption("Playing", PLAYING);
+	state->setControllableFeedbackOnly(true);
+	state->isSavable = false;
+}
+
+GridItem::~GridItem()
+{
+}
+
+void GridItem::clearItem()
+{
+	BaseItem::clearItem();
+	setMedia(nullptr);
+}
+
+void GridItem::setMedia(Media* m)
+{
+	if (m == media) return;
+
+	if (media != nullptr && !mediaRef.wasObjectDeleted())
+	{
+		if (isPrerolled || wasPlaying) media->handleExit();
+		unregisterUseMedia(GRIDITEM_TARGET_MEDIA_ID);
+	}
+
+	media = m;
+	mediaRef = media;
+	isPrerolled = false;
+	wasPlaying = false;
+
+	if (media != nullptr)
+	{
+		registerUseMedia(GRIDITEM_TARGET_MEDIA_ID, media);
+		if (isQueued || isPreloaded) preroll();
+		media->updateBeingUsed();
+	}
+}
+
+void GridItem::preroll()
+{
+	if (media == nullptr || isPrerolled) return;
+	media->handleEnter(0, false);
+	isPrerolled = true;
+}
+
+void GridItem::setStates(bool queued, bool preloaded)
+{
+	bool playing = isPlaying;
+
+	isQueued = queued;
+	isPreloaded = preloaded;
+
+	if (media != nullptr)
+	{
+		//switched on the GL thread, the layer has just started it at its launch offset
+		if (playing) isPrerolled = false;
+
+		if (wasPlaying && !playing) media->handleStop();
+
+		if (!playing)
+		{
+			if (queued || preloaded)
+			{
+				if (wasPlaying) isPrerolled = false; //back to the start for its next launch
+				preroll();
+			}
+			else if (isPrerolled || wasPlaying)
+			{
+				media->handleExit();
+				isPrerolled = false;
+			}
+		}
+
+		media->updateBeingUsed();
+	}
+
+	wasPlaying = playing;
+	state->setValueWithData(playing ? PLAYING : queued ? QUEUED : preloaded ? PRELOADED : IDLE);
+}
+
+void GridItem::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == targetMedia)
+	{
+		setMedia(targetMedia->getTargetContainerAs<Media>());
+	}
+	else if (p == enabled)
+	{
+		if (media != nullptr) media->updateBeingUsed();
+	}
+}
+
+void GridItem::onContainerTriggerTriggered(Trigger* t)
+{
+	if (t == launchTrigger)
+	{
+		if (layer != nullptr) layer->launch(this);
+	}
+}
+
+bool GridItem::isUsingMedia(Media* m)
+{
+	if (!enabled->boolValue()) return false;
+	if (!isPlaying && !isQueued && !isPreloaded) return false;
+	return MediaTarget::isUsingMedia(m);
+}
@@ -9,3 +9,45 @@
 */
 
 #pragma once
+
+class GridLayer;
+
+//A clip slot : the media a layer switches to when this item is launched
+class GridItem :
+	public BaseItem,
+	public MediaTarget
+{
+public:
+	GridItem(var params = var());
+	virtual ~GridItem();
+
+	enum State { IDLE, PRELOADED, QUEUED, PLAYING };
+
+	TargetParameter* targetMedia;
+	Trigger* launchTrigger;
+	EnumParameter* state;
+
+	Media* media;
+	WeakReference<Inspectable> mediaRef;
+	GridLayer* layer;
+
+	//Switched on the GL thread at launch time
+	std::atomic<bool> isPlaying;
+
+	//Message thread only
+	bool isQueued;
+	bool isPreloaded;
+	bool wasPlaying;
+	bool isPrerolled; //entered at its start and paused, ready to play on the launch frame
+
+	void clearItem() override;
+	void setMedia(Media* m);
+	void preroll();
+	void setStates(bool queued, bool preloaded);
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+	void onContainerTriggerTriggered(Trigger* t) override;
+	bool isUsingMedia(Media* m) override;
+
+	DECLARE_TYPE("Grid Item")
+};
@@ -8,4 +8,168 @@
   ==============================================================================
 */
 
-#include "GridLayer.h"
+#include "Media/MediaIncludes.h"
+
+GridLayer::GridLayer(var params) :
+	BaseItem(getTypeString()),
+	items(this),
+	grid(nullptr),
+	activeItem(nullptr),
+	queuedItem(nullptr),
+	hasQueuedLaunch(false),
+	queuedLaunchTime(0),
+	itemToStart(nullptr),
+	restartItem(false),
+	itemLaunchTime(0)
+{
+	saveAndLoadRecursiveData = true;
+	itemDataType = "GridLayer";
+
+	opacity = addFloatParameter("Opacity", "Opacity of the playing item", 1, 0, 1);
+	stopTrigger = addTrigger("Stop", "Stop the playing item, on the next beat or bar if the grid is quantized");
+
+	addChildControllableContainer(&items);
+}
+
+GridLayer::~GridLayer()
+{
+	cancelPendingUpdate();
+}
+
+void GridLayer::clearItem()
+{
+	BaseItem::clearItem();
+	cancelPendingUpdate();
+}
+
+void GridLayer::launch(GridItem* item)
+{
+	double now = Time::getMillisecondCounterHiRes();
+	queueLaunch(item, grid != nullptr ? grid->getNextLaunchTime(now) : now);
+}
+
+void GridLayer::queueLaunch(GridItem* item, double launchTime)
+{
+	//Prerolled before being published, the GL thread may start it on the very next frame
+	if (item != nullptr && !item->isPlaying) item->preroll();
+
+	{
+		GenericScopedLock lock(launchLock);
+		queuedItem = item;
+		queuedLaunchTime = launchTime;
+		hasQueuedLaunch = true;
+	}
+
+	updateStates();
+}
+
+void GridLayer::itemRemoved(GridItem* item)
+{
+	{
+		GenericScopedLock lock(launchLock);
+		if (activeItem == item) activeItem = nullptr;
+		if (queuedItem == item)
+		{
+			queuedItem = nullptr;
+			hasQueuedLaunch = false;
+		}
+		if (itemToStart == item) itemToStart = nullptr;
+	}
+
+	triggerAsyncUpdate();
+}
+
+void GridLayer::updateStates()
+{
+	GridItem* active = nullptr;
+	GridItem* queued = nullptr;
+	{
+		GenericScopedLock lock(launchLock);
+		active = activeItem;
+		if (hasQueuedLaunch) queued = queuedItem;
+	}
+
+	//The likely next launches are the items right after the playing one, or the first ones if nothing plays
+	int numItems = items.items.size();
+	int activeIndex = items.items.indexOf(active);
+	int numPreloads = grid != nullptr ? grid->preloadCount->intValue() : 1;
+
+	for (int i = 0; i < numItems; i++)
+	{
+		GridItem* item = items.items[i];
+
+		bool preload = false;
+		if (activeIndex >= 0)
+		{
+			int distance = (i - activeIndex + numItems) % numItems;
+			preload = distance >= 1 && distance <= numPreloads;
+		}
+		else preload = i < numPreloads;
+
+		item->setStates(item == queued, preload);
+	}
+}
+
+void GridLayer::renderGL(double time, double frameTime, int width, int height)
+{
+	GenericScopedLock lock(launchLock);
+
+	//The frame closest to the launch time switches, even on a disabled layer
+	if (hasQueuedLaunch && time + frameTime * .5 >= queuedLaunchTime)
+	{
+		bool isRestart = queuedItem != nullptr && queuedItem == activeItem;
+		if (activeItem != nullptr) activeItem->isPlaying = false;
+		activeItem = queuedItem;
+		queuedItem = nullptr;
+		hasQueuedLaunch = false;
+
+		if (activeItem != nullptr) activeItem->isPlaying = true;
+		itemToStart = activeItem;
+		restartItem = isRestart;
+		itemLaunchTime = queuedLaunchTime;
+
+		triggerAsyncUpdate();
+	}
+
+	if (activeItem == nullptr || !enabled->boolValue() || !activeItem->enabled->boolValue()) return;
+
+	Media* m = activeItem->media;
+	if (m == nullptr || !m->frameBuffer.isValid()) return;
+	if (grid != nullptr) grid->takeFrameTiming(m);
+
+	glColor4f(1, 1, 1, opacity->floatValue());
+	glBindTexture(GL_TEXTURE_2D, m->getTextureID());
+	Draw2DTexRect(0, 0, width, height);
+}
+
+void GridLayer::onContainerTriggerTriggered(Trigger* t)
+{
+	if (t == stopTrigger) launch(nullptr);
+}
+
+void GridLayer::handleAsyncUpdate()
+{
+	GridItem* startedItem = nullptr;
+	bool isRestart = false;
+	double launchTime = 0;
+	{
+		GenericScopedLock lock(launchLock);
+		startedItem = itemToStart;
+		isRestart = restartItem;
+		launchTime = itemLaunchTime;
+		itemToStart = nullptr;
+	}
+
+	if (startedItem != nullptr && startedItem->media != nullptr)
+	{
+		//The message loop starts it a bit after the switch, it catches up to where it would be if it had started at the launch time
+		double elapsed = jmax(0.0, (Time::getMillisecondCounterHiRes() - launchTime) / 1000.0);
+		double frameTime = 1.0 / jmax(RMPSettings::getInstance()->fpsLimit->intValue(), 1);
+
+		//Prerolled at its start, within a frame it just plays from there. Launching the playing item again restarts it.
+		if (!isRestart && elapsed < frameTime) startedItem->media->handleStart();
+		else startedItem->media->handleEnter(elapsed, true);
+	}
+
+	updateStates();
+}
@@ -9,3 +9,50 @@
 */
 
 #pragma once
+
+class GridMedia;
+
+/*
+	A row of the grid. Only one of its items plays at a time, the grid draws it with the layer's opacity.
+	Launches are queued from the message thread and switched on the GL thread, on the first frame that reaches the launch time.
+	The switched item's media is then started back on the message thread, from where it would be if it had started at the launch time.
+*/
+class GridLayer :
+	public BaseItem,
+	public AsyncUpdater
+{
+public:
+	GridLayer(var params = var());
+	~GridLayer();
+
+	FloatParameter* opacity;
+	Trigger* stopTrigger;
+
+	GridLayerItemManager items;
+	GridMedia* grid;
+
+	SpinLock launchLock;
+	GridItem* activeItem;
+	GridItem* queuedItem; //nullptr with a queued launch stops the layer
+	bool hasQueuedLaunch;
+	double queuedLaunchTime;
+	GridItem* itemToStart; //switched on the GL thread, started on the message thread
+	bool restartItem;
+	double itemLaunchTime;
+
+	void clearItem() override;
+
+	//Message thread
+	void launch(GridItem* item);
+	void queueLaunch(GridItem* item, double launchTime);
+	void itemRemoved(GridItem* item);
+	void updateStates();
+
+	//GL thread, switches to the queued item if its time has come and draws the playing one. Holds the launch lock while drawing, removed items wait for it.
+	void renderGL(double time, double frameTime, int width, int height);
+
+	void onContainerTriggerTriggered(Trigger* t) override;
+	void handleAsyncUpdate() override;
+
+	DECLARE_TYPE("Grid Layer")
+};
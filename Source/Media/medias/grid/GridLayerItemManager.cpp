@@ -8,4 +8,28 @@
   ==============================================================================
 */
 
-#include "GridLayerItemManager.h"
+#include "Media/MediaIncludes.h"
+
+GridLayerItemManager::GridLayerItemManager(GridLayer* layer) :
+	BaseManager("Items"),
+	layer(layer)
+{
+	itemDataType = "GridItem";
+	selectItemWhenCreated = false;
+}
+
+GridLayerItemManager::~GridLayerItemManager()
+{
+}
+
+void GridLayerItemManager::addItemInternal(GridItem* item, var data)
+{
+	item->layer = layer;
+	layer->triggerAsyncUpdate(); //preloads depend on the item order
+}
+
+void GridLayerItemManager::removeItemInternal(GridItem* item)
+{
+	layer->itemRemoved(item);
+	item->layer = nullptr;
+}
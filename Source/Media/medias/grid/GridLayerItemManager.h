@@ -9,3 +9,16 @@
 */
 
 #pragma once
+
+class GridLayerItemManager :
+	public BaseManager<GridItem>
+{
+public:
+	GridLayerItemManager(GridLayer* layer);
+	~GridLayerItemManager();
+
+	GridLayer* layer;
+
+	void addItemInternal(GridItem* item, var data) override;
+	void removeItemInternal(GridItem* item) override;
+};
@@ -8,4 +8,27 @@
   ==============================================================================
 */
 
-#include "GridLayerManager.h"
+#include "Media/MediaIncludes.h"
+
+GridLayerManager::GridLayerManager(GridMedia* grid) :
+	BaseManager("Layers"),
+	grid(grid)
+{
+	itemDataType = "GridLayer";
+	selectItemWhenCreated = false;
+}
+
+GridLayerManager::~GridLayerManager()
+{
+}
+
+void GridLayerManager::addItemInternal(GridLayer* layer, var data)
+{
+	layer->grid = grid;
+	layer->triggerAsyncUpdate();
+}
+
+void GridLayerManager::removeItemInternal(GridLayer* layer)
+{
+	layer->grid = nullptr;
+}
@@ -9,3 +9,16 @@
 */
 
 #pragma once
+
+class GridLayerManager :
+	public BaseManager<GridLayer>
+{
+public:
+	GridLayerManager(GridMedia* grid);
+	~GridLayerManager();
+
+	GridMedia* grid;
+
+	void addItemInternal(GridLayer* layer, var data) override;
+	void removeItemInternal(GridLayer* layer) override;
+};
@@ -11,10 +11,119 @@
 #include "Media/MediaIncludes.h"
 
 GridMedia::GridMedia(var params) :
-    Media(getTypeString(), params)
+	Media(getTypeString(), params, true),
+	layers(this),
+	columns(this),
+	clockStartTime(Time::getMillisecondCounterHiRes()),
+	clockBPM(120),
+	renderedBeat(0)
 {
+	bpm = addFloatParameter("BPM", "Tempo of the launch clock", 120, 20, 300);
+	beatsPerBar = addIntParameter("Beats Per Bar", "Number of beats in a bar", 4, 1, 16);
+	quantization = addEnumParameter("Quantization", "When launched items actually start");
+	quantization->addOption("Next Bar", BAR)->addOption("Next Beat", BEAT)->addOption("Immediate", NONE);
+	tapTempo = addTrigger("Tap Tempo", "Tap on the beats to set the tempo, the last tap is the first beat of a bar");
+	restartClock = addTrigger("Restart Clock", "Start a new bar now");
+	preloadCount = addIntParameter("Preload Count", "How many items after the playing one are prerolled in each layer", 1, 0, 8);
+
+	currentBeat = addIntParameter("Current Beat", "Beat of the bar the clock is at", 1, 1, 16);
+	currentBeat->setControllableFeedbackOnly(true);
+	currentBeat->isSavable = false;
+
+	addChildControllableContainer(&layers);
+	addChildControllableContainer(&columns);
+
+	alwaysRedraw = true;
 }
 
 GridMedia::~GridMedia()
 {
 }
+
+double GridMedia::getNextLaunchTime(double now)
+{
+	Quantization q = quantization->getValueDataAsEnum<Quantization>();
+	if (q == NONE) return now;
+
+	double unit = getBeatDuration() * (q == BAR ? beatsPerBar->intValue() : 1);
+	double units = (now - clockStartTime) / unit;
+
+	//a launch right on the boundary, within a millisecond, doesn't wait for the next one
+	return clockStartTime + std::ceil(units - 1.0 / unit) * unit;
+}
+
+void GridMedia::launchColumn(int index)
+{
+	if (index < 0) return;
+
+	//one launch time for all layers so they switch on the same frame
+	double launchTime = getNextLaunchTime(Time::getMillisecondCounterHiRes());
+	for (auto& l : layers.items) l->queueLaunch(l->items.items[index], launchTime);
+}
+
+void GridMedia::tap()
+{
+	double now = Time::getMillisecondCounterHiRes();
+
+	//a long pause starts a new tap sequence
+	if (!tapTimes.isEmpty() && now - tapTimes.getLast() > 2000) tapTimes.clearQuick();
+	tapTimes.add(now);
+	if (tapTimes.size() > 5) tapTimes.remove(0);
+
+	if (tapTimes.size() >= 2)
+	{
+		double interval = (tapTimes.getLast() - tapTimes.getFirst()) / (tapTimes.size() - 1);
+		bpm->setValue(60000.0 / interval);
+	}
+
+	clockStartTime = now;
+}
+
+void GridMedia::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == bpm)
+	{
+		//keep the beat position, only the speed changes
+		double now = Time::getMillisecondCounterHiRes();
+		double beats = (now - clockStartTime) / getBeatDuration();
+		clockBPM = bpm->floatValue();
+		clockStartTime = now - beats * getBeatDuration();
+	}
+}
+
+void GridMedia::onContainerTriggerTriggered(Trigger* t)
+{
+	Media::onContainerTriggerTriggered(t);
+
+	if (t == tapTempo) tap();
+	else if (t == restartClock) clockStartTime = Time::getMillisecondCounterHiRes();
+}
+
+void GridMedia::renderGLInternal()
+{
+	double t = GlContextHolder::getInstance()->timeAtRender;
+	double frameTime = 1000.0 / RMPSettings::getInstance()->fpsLimit->intValue();
+
+	int beat = (int)std::floor((t - clockStartTime) / getBeatDuration()) % beatsPerBar->intValue() + 1;
+	if (beat >= 1 && beat != renderedBeat)
+	{
+		renderedBeat = beat;
+		WeakReference<ControllableContainer> ref(this);
+		MessageManager::callAsync([ref, beat]()
+			{
+				if (GridMedia* gm = dynamic_cast<GridMedia*>(ref.get())) gm->currentBeat->setValue(beat);
+			});
+	}
+
+	int width = frameBuffer.getWidth();
+	int height = frameBuffer.getHeight();
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	//Last layer is the bottom one, like compositions
+	for (int i = layers.items.size() - 1; i >= 0; i--) layers.items[i]->renderGL(t, frameTime, width, height);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glColor4f(1, 1, 1, 1);
+}
@@ -10,12 +10,46 @@
 
 #pragma once
 
+/*
+	Clip launcher. Each layer plays one of its items at a time, launches wait for the next beat or bar of the grid's clock.
+	Items that are queued or likely to be launched next are prerolled, so they are ready on the launch frame.
+	Layers are drawn in a single pass, each one's playing media straight into the grid's framebuffer.
+*/
 class GridMedia :
-    public Media
+	public Media
 {
 public:
-    GridMedia(var params = var());
-    ~GridMedia();
+	GridMedia(var params = var());
+	~GridMedia();
+
+	enum Quantization { NONE, BEAT, BAR };
+
+	FloatParameter* bpm;
+	IntParameter* beatsPerBar;
+	EnumParameter* quantization;
+	Trigger* tapTempo;
+	Trigger* restartClock;
+	IntParameter* preloadCount;
+	IntParameter* currentBeat;
+
+	GridLayerManager layers;
+	GridColumnManager columns;
+
+	//Clock, in Time::getMillisecondCounterHiRes milliseconds, like the GL render time. Set on the message thread, read on the GL thread.
+	std::atomic<double> clockStartTime;
+	std::atomic<double> clockBPM;
+	int renderedBeat; //GL thread, currentBeat is only updated when it changes
+	Array<double> tapTimes;
+
+	double getBeatDuration() const { return 60000.0 / clockBPM; }
+	double getNextLaunchTime(double now);
+	void launchColumn(int index);
+	void tap();
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+	void onContainerTriggerTriggered(Trigger* t) override;
+
+	void renderGLInternal() override;
 
 	DECLARE_TYPE("Grid")
-};
\ No newline at end of file
+};
@@ -11,19 +11,35 @@
 #include "Media/MediaIncludes.h"
 
 NDIMedia::NDIMedia(var params) :
-	ImageMedia(getTypeString(), params)
+	Media(getTypeString(), params),
+	frameWidth(0),
+	frameHeight(0),
+	lastTimestamp(0),
+	lastTimecode(0),
+	hasNewFrame(false),
+	frameIsDrawn(false)
 {
 	color = addColorParameter("Color", "", Colour(255, 0, 0));
 	ndiParam = new NDIDeviceParameter("NDI Source");
 	addParameter(ndiParam);
 
+	bandwidth = addEnumParameter("Bandwidth", "Full Quality for outputs. Preview receives a low resolution stream, for monitoring or analysis. Medias on the same source and bandwidth share one connection.");
+	bandwidth->addOption("Full Quality", NDIReceiver::HIGHEST)->addOption("Preview", NDIReceiver::LOWEST);
+
 	customFPSTick = true;
+
+	//pulled every frame, the shader overwrites the whole framebuffer when there is something new
+	alwaysRedraw = true;
+	autoClearFrameBufferOnRender = false;
 }
 
 NDIMedia::~NDIMedia()
 {
-	if (ndiDevice != nullptr) ndiDevice->removeNDIInputListener(this);
+	stopTimer();
+	unregisterRenderer();
 
+	GenericScopedLock lock(receiverLock);
+	receiver = nullptr;
 }
 
 void NDIMedia::clearItem()
@@ -33,7 +49,7 @@ void NDIMedia::clearItem()
 
 void NDIMedia::onContainerParameterChangedInternal(Parameter* p)
 {
-	if (p == ndiParam) {
+	if (p == ndiParam || p == bandwidth) {
 		updateDevice();
 	}
 }
@@ -42,36 +58,106 @@ void NDIMedia::updateDevice()
 {
 	if (isClearing) return;
 
-	if (ndiParam->inputDevice != ndiDevice)
+	NDIReceiver::Bandwidth b = bandwidth->getValueDataAsEnum<NDIReceiver::Bandwidth>();
+	bool isUpToDate = ndiParam->inputDevice == ndiDevice && (ndiDevice == nullptr ? receiver == nullptr : receiver != nullptr && receiver->bandwidth == b);
+	if (isUpToDate)
 	{
-		if (ndiDevice != nullptr) ndiDevice->removeNDIInputListener(this);
-		ndiDevice = ndiParam->inputDevice;
+		stopTimer();
+		return;
+	}
 
-		if (ndiDevice != nullptr)
-		{
-			ndiDevice->addNDIInputListener(this);
-			NLOG(niceName, "Now listening to NDI Device : " << ndiDevice->name);
-		}
+	ndiDevice = ndiParam->inputDevice;
+	NDIReceiver::Ptr newReceiver = NDIManager::getInstance()->getReceiver(ndiDevice, b);
+
+	//The old receiver is released here, or by the GL thread if it is pulling from it right now
+	NDIReceiver::Ptr oldReceiver;
+	{
+		GenericScopedLock lock(receiverLock);
+		oldReceiver = receiver;
+		receiver = newReceiver;
 	}
 
+	if (newReceiver != nullptr) NLOG(niceName, "Now listening to NDI Device : " << ndiDevice->name);
+	else frameWidth = frameHeight = 0;
+
+	//A receiver that couldn't be created is tried again until it works or the source changes
+	if (ndiDevice != nullptr && newReceiver == nullptr) startTimer(2000);
+	else stopTimer();
 }
 
-void NDIMedia::videoFrameReceived(NDIlib_video_frame_v2_t* frame)
+void NDIMedia::timerCallback()
 {
-	const uint8_t* frameData = frame->p_data;
-	int width = frame->xres;
-	int height = frame->yres;
+	updateDevice();
+}
 
-	// Créer une image JUCE et copier les données
-	FPSTick();
+void NDIMedia::initFrameBuffer()
+{
+	Media::initFrameBuffer();
+	frameIsDrawn = false;
+}
 
-	if (image.getWidth() != width || image.getHeight() != height) {
-		initImage(width, height);
+void NDIMedia::preRenderGLInternal()
+{
+	NDIReceiver::Ptr r;
+	{
+		GenericScopedLock lock(receiverLock);
+		r = receiver;
 	}
 
-	std::memcpy(bitmapData->data, frameData, width * height * 4);
+	hasNewFrame = false;
+	if (r == nullptr) return;
 
-	shouldRedraw = true;
+	NDIlib_video_frame_v2_t frame;
+	r->captureVideo(frame);
+
+	//The framesync repeats the last frame when no new one arrived
+	bool isNew = frame.timestamp != lastTimestamp || frame.timecode != lastTimecode;
+	if (frame.p_data != nullptr && isNew)
+	{
+		frameWidth = frame.xres;
+		frameHeight = frame.yres;
+		lastTimestamp = frame.timestamp;
+		lastTimecode = frame.timecode;
+
+		//Copied to the PBO, the frame can go back to the framesync right after
+		if (uploader.upload(frame))
+		{
+			hasNewFrame = true;
+			frameTiming.arrivalTime = Time::getMillisecondCounterHiRes(); //pulled, so only known when it's picked
+			frameTiming.uploadTime = frameTiming.arrivalTime;
+			FPSTick();
+		}
+	}
+
+	r->freeVideo(frame);
+}
+
+void NDIMedia::renderGLInternal()
+{
+	if (!hasNewFrame && frameIsDrawn)
+	{
+		contentIsUnchanged = true;
+		return;
+	}
+
+	uploader.draw(frameBuffer.getWidth(), frameBuffer.getHeight());
+	frameIsDrawn = true;
+}
+
+void NDIMedia::closeGLInternal()
+{
+	uploader.releaseGL();
+	frameIsDrawn = false;
 }
 
+Point<int> NDIMedia::getMediaSize()
+{
+	//Until the first frame gives the size, a 1 pixel framebuffer keeps the media rendering, so it pulls
+	if (frameWidth == 0 || frameHeight == 0)
+	{
+		GenericScopedLock lock(receiverLock);
+		return receiver != nullptr ? Point<int>(1, 1) : Point<int>(0, 0);
+	}
 
+	return Point<int>(frameWidth, frameHeight);
+}
@@ -11,23 +11,49 @@
 #pragma once
 
 
+/*
+    Pulls frames from a pooled receiver at the render clock, through the receiver's framesync.
+    A frame is only uploaded when it is a new one, repeats leave the framebuffer as it is.
+*/
 class NDIMedia :
-    public ImageMedia,
-    public NDIInputDevice::NDIInputListener
+    public Media,
+    public Timer
 {
 public:
     NDIMedia(var params = var());
     ~NDIMedia();
 
     NDIDeviceParameter* ndiParam;
+    EnumParameter* bandwidth;
     NDIInputDevice* ndiDevice = nullptr;
     ColorParameter* color;
 
+    //Set from the message thread, used on the GL thread
+    SpinLock receiverLock;
+    NDIReceiver::Ptr receiver;
+
+    std::atomic<int> frameWidth;
+    std::atomic<int> frameHeight;
+
+    //GL thread
+    NDIFrameUploader uploader;
+    int64 lastTimestamp;
+    int64 lastTimecode;
+    bool hasNewFrame;
+    bool frameIsDrawn;
+
     void clearItem() override;
     void onContainerParameterChangedInternal(Parameter* p) override;
 
     void updateDevice();
-    void videoFrameReceived(NDIlib_video_frame_v2_t* frame) override;
+    void timerCallback() override;
+
+    void initFrameBuffer() override;
+    void preRenderGLInternal() override;
+    void renderGLInternal() override;
+    void closeGLInternal() override;
+
+    Point<int> getMediaSize() override;
 
 
     DECLARE_TYPE("NDI")
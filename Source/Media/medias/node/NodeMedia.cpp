@@ -12,32 +12,28 @@
 #include "Node/NodeIncludes.h"
 
 NodeMedia::NodeMedia(var params) :
-	Media(getTypeString(), params)
+	Media(getTypeString(), params, true)
 {
 	nodes.reset(new RootNodeManager(this));
 	addChildControllableContainer(nodes.get());
+
+	alwaysRedraw = true;
 }
 
 NodeMedia::~NodeMedia()
 {
+	//Pooled buffers have to be deleted with the context current
+	unregisterRenderer();
 }
 
 
 void NodeMedia::renderGLInternal()
 {
-	//glBindTexture(GL_TEXTURE_2D, receiver->fbo->getTextureID());
-	//glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	//glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-	////draw full quad
-	//Init2DViewport(receiver->width, receiver->height);
-	//glColor3f(1, 1, 1);
-	//Draw2DTexRect(0, 0, receiver->width, receiver->height);
-
-	//glBindTexture(GL_TEXTURE_2D, 0);
+	//The graph is drawn stretched to the media size
+	nodes->glRenderer.render(frameBuffer.getWidth(), frameBuffer.getHeight());
 }
 
-Point<int> NodeMedia::getMediaSize()
+void NodeMedia::closeGLInternal()
 {
-	return Point<int>();
-}
\ No newline at end of file
+	nodes->glRenderer.releaseGL();
+}
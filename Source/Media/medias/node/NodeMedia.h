@@ -21,8 +21,8 @@ public:
 
 	std::unique_ptr<RootNodeManager> nodes;
 
-	void renderGLInternal();
-	Point<int> getMediaSize();
+	void renderGLInternal() override;
+	void closeGLInternal() override;
 
 	DECLARE_TYPE("Node")
-};
\ No newline at end of file
+};
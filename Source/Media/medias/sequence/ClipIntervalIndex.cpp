@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+	ClipIntervalIndex.cpp
+	Created: 19 Oct 2026 9:03:17pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+
+ClipIntervalIndex::ClipIntervalIndex() :
+	maxLevel(-1)
+{
+}
+
+void ClipIntervalIndex::build(const Array<MediaClip*>& clips)
+{
+	intervals.clearQuick();
+	for (auto& c : clips) intervals.add({ getActiveStart(c), getActiveEnd(c), 0, c });
+
+	std::sort(intervals.begin(), intervals.end(), [](const Interval& a, const Interval& b) { return a.start < b.start; });
+
+	int n = intervals.size();
+	maxLevel = -1;
+	if (n == 0) return;
+
+	//Leaves are the even indices, level k nodes are at (2^k - 1) + i * 2^(k+1)
+	int lastIndex = 0;
+	double lastMax = 0;
+	for (int i = 0; i < n; i += 2)
+	{
+		lastIndex = i;
+		lastMax = intervals.getReference(i).maxEnd = intervals[i].end;
+	}
+
+	int k = 1;
+	for (; (1 << k) <= n; k++)
+	{
+		int x = 1 << (k - 1);
+		for (int i = (x << 1) - 1; i < n; i += x << 2)
+		{
+			double leftMax = intervals[i - x].maxEnd;
+			double rightMax = i + x < n ? intervals[i + x].maxEnd : lastMax; //right subtree may be cut by the array end
+			intervals.getReference(i).maxEnd = jmax(intervals[i].end, leftMax, rightMax);
+		}
+
+		lastIndex = ((lastIndex >> k) & 1) ? lastIndex - x : lastIndex + x;
+		if (lastIndex < n) lastMax = jmax(lastMax, intervals[lastIndex].maxEnd);
+	}
+
+	maxLevel = k - 1;
+}
+
+void ClipIntervalIndex::clear()
+{
+	intervals.clear();
+	maxLevel = -1;
+}
+
+void ClipIntervalIndex::getClipsAtTime(double time, Array<MediaClip*>& result) const
+{
+	int n = intervals.size();
+	if (maxLevel < 0) return;
+
+	struct Node { int level; int index; bool leftDone; };
+	Node stack[64];
+	int top = 0;
+	stack[top++] = { maxLevel, (1 << maxLevel) - 1, false };
+
+	while (top > 0)
+	{
+		Node z = stack[--top];
+
+		if (z.level <= 3)
+		{
+			//small subtree, a linear scan is faster than going down
+			int i0 = z.index >> z.level << z.level;
+			int i1 = jmin(i0 + (1 << (z.level + 1)) - 1, n);
+			for (int i = i0; i < i1 && intervals[i].start <= time; i++)
+			{
+				if (time <= intervals[i].end) result.add(intervals[i].clip);
+			}
+		}
+		else if (!z.leftDone)
+		{
+			int y = z.index - (1 << (z.level - 1));
+			stack[top++] = { z.level, z.index, true };
+			if (y >= n || intervals[y].maxEnd >= time) stack[top++] = { z.level - 1, y, false };
+		}
+		else if (z.index < n && intervals[z.index].start <= time)
+		{
+			if (time <= intervals[z.index].end) result.add(intervals[z.index].clip);
+			stack[top++] = { z.level - 1, z.index + (1 << (z.level - 1)), false };
+		}
+	}
+}
+
+double ClipIntervalIndex::getActiveStart(MediaClip* clip)
+{
+	return clip->time->floatValue() - clip->preStart->floatValue();
+}
+
+double ClipIntervalIndex::getActiveEnd(MediaClip* clip)
+{
+	return clip->getEndTime() + clip->postEnd->floatValue();
+}
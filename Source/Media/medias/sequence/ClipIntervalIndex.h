@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+	ClipIntervalIndex.h
+	Created: 19 Oct 2026 9:03:17pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Static interval tree over the clips' activity ranges [start - preStart, end + postEnd].
+	Intervals are sorted by start and laid out as an implicit binary tree where each node keeps the max end of its subtree,
+	so a point query is O(log n + k) with no allocation besides the result. Rebuilt in one go when the clips are edited.
+*/
+class ClipIntervalIndex
+{
+public:
+	ClipIntervalIndex();
+	~ClipIntervalIndex() {}
+
+	void build(const Array<MediaClip*>& clips);
+	void clear();
+
+	//Fills result with the clips whose range contains time, bounds included
+	void getClipsAtTime(double time, Array<MediaClip*>& result) const;
+
+	static double getActiveStart(MediaClip* clip);
+	static double getActiveEnd(MediaClip* clip);
+
+private:
+	struct Interval
+	{
+		double start;
+		double end;
+		double maxEnd; //max end of the subtree rooted at this node
+		MediaClip* clip;
+	};
+
+	Array<Interval> intervals;
+	int maxLevel;
+};
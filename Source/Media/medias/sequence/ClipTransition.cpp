@@ -20,6 +20,7 @@ ClipTransition::ClipTransition(var params) :
 	var sParams(new DynamicObject());
 	//sParams.getDynamicObject()->setProperty("manualRender", true);
 	shaderMedia.reset(new ShaderMedia(sParams));
+	shaderMedia->releaseFrameBufferWhenIdle = true; //only rendered while overlapping the playhead
 
 	progressParam = shaderMedia->mediaParams.addFloatParameter("progression", "progression", 0, 0, 1);
 	progressParam->isRemovableByUser = false;
@@ -33,6 +33,7 @@ void MediaClipManager::addItemInternal(LayerBlock* block, var data)
 	LayerBlockManager::addItemInternal(block, data);
 	MediaClip* clip = dynamic_cast<MediaClip*>(block);
 	clip->addMediaClipListener(this);
+	mediaLayer->clipIndexChanged();
 
 	if (auto t = dynamic_cast<ClipTransition*>(clip))
 	{
@@ -60,6 +61,7 @@ void MediaClipManager::addItemsInternal(Array<LayerBlock*> blocks, var data)
 		MediaClip* clip = dynamic_cast<MediaClip*>(b);
 		clip->addMediaClipListener(this);
 	}
+	mediaLayer->clipIndexChanged();
 }
 
 void MediaClipManager::removeItemInternal(LayerBlock* block)
@@ -67,6 +69,7 @@ void MediaClipManager::removeItemInternal(LayerBlock* block)
 	LayerBlockManager::removeItemInternal(block);
 	MediaClip* clip = dynamic_cast<MediaClip*>(block);
 	clip->removeMediaClipListener(this);
+	mediaLayer->clipRemoved(clip);
 }
 
 void MediaClipManager::removeItemsInternal(Array<LayerBlock*> blocks)
@@ -76,6 +79,7 @@ void MediaClipManager::removeItemsInternal(Array<LayerBlock*> blocks)
 	{
 		MediaClip* clip = dynamic_cast<MediaClip*>(b);
 		clip->removeMediaClipListener(this);
+		mediaLayer->clipRemoved(clip);
 	}
 }
 
@@ -84,6 +88,8 @@ void MediaClipManager::onControllableFeedbackUpdate(ControllableContainer* cc, C
 	MediaClip* b = c->getParentAs<MediaClip >();
 	if (b != nullptr)
 	{
+		if (c == b->time || c == b->coreLength || c == b->loopLength || c == b->preStart || c == b->postEnd) mediaLayer->clipIndexChanged();
+
 		if (c == b->time || c == b->coreLength || c == b->loopLength)
 		{
 			if (!blocksCanOverlap) return;
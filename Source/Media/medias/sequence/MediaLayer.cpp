@@ -14,6 +14,7 @@
 MediaLayer::MediaLayer(Sequence* s, var params) :
 	SequenceLayer(s, "Media"),
 	blockManager(this),
+	clipIndexIsDirty(true),
 	positionningCC("Positionning")
 {
 	saveAndLoadRecursiveData = true;
@@ -141,13 +142,18 @@ void MediaLayer::initFrameBuffer(int width, int height)
 	heightParam->setDefaultValue(height, !heightParam->isOverriden);
 }
 
-bool MediaLayer::renderFrameBuffer(int width, int height)
+bool MediaLayer::renderFrameBuffer(int width, int height, bool renderMedias)
+{
+	Array<MediaClip*> clipsToProcess;
+	getClipsToDraw(clipsToProcess, renderMedias);
+	return drawFrameBuffer(width, height, clipsToProcess);
+}
+
+void MediaLayer::getClipsToDraw(Array<MediaClip*>& clipsToProcess, bool renderMedias)
 {
 	float time = sequence->currentTime->floatValue();
 	Array<LayerBlock*> blocks = blockManager.getBlocksAtTime(time, false);
 
-	Array<MediaClip*> clipsToProcess;
-
 	Array<ClipTransition*> transitions;
 	for (auto& b : blocks)
 	{
@@ -169,13 +175,29 @@ bool MediaLayer::renderFrameBuffer(int width, int height)
 		}
 	}
 
+	if (renderMedias)
+	{
+		//Offline, medias don't get their own GL tick in between frames. Transitions read the other clips, so they come last
+		for (auto& clip : clipsToProcess) if (dynamic_cast<ClipTransition*>(clip) == nullptr) clip->media->renderOpenGLMedia(true);
+		for (auto& t : transitions) t->media->renderOpenGLMedia(true);
+	}
+
 	if (!transitions.isEmpty())
 	{
 		clipsToProcess.clear();
 		clipsToProcess.add(transitions.getLast());
 	}
+}
 
+bool MediaLayer::canCompositeInOnePass()
+{
+	//custom factors and positionning keep their own framebuffer
+	if (positionningCC.enabled->boolValue()) return false;
+	return blendFunction->getValueDataAsEnum<BlendPreset>() != CUSTOM && transitionBlendFunction->getValueDataAsEnum<BlendPreset>() != CUSTOM;
+}
 
+bool MediaLayer::drawFrameBuffer(int width, int height, const Array<MediaClip*>& clipsToProcess)
+{
 	//if (clipsToProcess.isEmpty()) return false;
 
 	if (frameBuffer.getWidth() != width || frameBuffer.getHeight() != height) initFrameBuffer(width, height);
@@ -281,35 +303,72 @@ void MediaLayer::sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool ev
 	double t = s->currentTime->doubleValue();
 	//Array<LayerBlock*> activeBlocks = blockManager.getBlocksInRange(t, nextFrameTime);// getBlocksInRange(s->currentTime->floatValue(), s->currentTime->floatValue() + .01f, false);
 
-	for (auto& b : blockManager.items)
+	GenericScopedLock lock(clipIndexLock);
+
+	Array<MediaClip*> clipsToUpdate;
+	if (clipIndexIsDirty)
 	{
-		if (MediaClip* clip = dynamic_cast<MediaClip*>(b))
+		//clips were edited, evaluate all of them once so nothing stays active by mistake
+		for (auto& b : blockManager.items)
 		{
-			clip->setTime(t, s->isSeeking || !s->isPlaying->boolValue());
+			if (MediaClip* clip = dynamic_cast<MediaClip*>(b)) clipsToUpdate.add(clip);
+		}
 
-			bool isActive = t >= clip->time->floatValue() - clip->preStart->floatValue() && t <= clip->getEndTime() + clip->postEnd->floatValue();
+		clipIndex.build(clipsToUpdate);
+		clipIndexIsDirty = false;
+	}
+	else
+	{
+		//clips leaving the playhead, then the ones entering or staying
+		clipsToUpdate.addArray(activeClips);
+		Array<MediaClip*> clipsAtTime;
+		clipIndex.getClipsAtTime(t, clipsAtTime);
+		for (auto& clip : clipsAtTime) clipsToUpdate.addIfNotAlreadyThere(clip);
+	}
 
-			if (isActive != clip->isActive->boolValue())
+	activeClips.clearQuick();
+
+	for (auto& clip : clipsToUpdate)
+	{
+		clip->setTime(t, s->isSeeking || !s->isPlaying->boolValue());
+
+		bool isActive = t >= ClipIntervalIndex::getActiveStart(clip) && t <= ClipIntervalIndex::getActiveEnd(clip);
+
+		if (isActive != clip->isActive->boolValue())
+		{
+			//LOG("Set active " << (int)isActive);
+			//GenericScopedLock lock(renderLock);
+			clip->isActive->setValue(isActive);
+			if (isActive && s->isPlaying->boolValue())
 			{
-				//LOG("Set active " << (int)isActive);
-				//GenericScopedLock lock(renderLock);
-				clip->isActive->setValue(isActive);
-				if (isActive && s->isPlaying->boolValue())
+				if (VideoMedia* vm = dynamic_cast<VideoMedia*>(clip->media))
 				{
-					if (VideoMedia* vm = dynamic_cast<VideoMedia*>(clip->media))
 					{
-						{
-							//vm->play();
-						}
+						//vm->play();
 					}
 				}
 			}
-
-			clip->setTime(t, s->isSeeking || !s->isPlaying->boolValue());
 		}
+
+		clip->setTime(t, s->isSeeking || !s->isPlaying->boolValue());
+
+		if (isActive) activeClips.add(clip);
 	}
 }
 
+void MediaLayer::clipIndexChanged()
+{
+	GenericScopedLock lock(clipIndexLock);
+	clipIndexIsDirty = true;
+}
+
+void MediaLayer::clipRemoved(MediaClip* clip)
+{
+	GenericScopedLock lock(clipIndexLock);
+	activeClips.removeAllInstancesOf(clip);
+	clipIndexIsDirty = true;
+}
+
 void MediaLayer::sequencePlayStateChanged(Sequence* s)
 {
 	for (auto& b : blockManager.items)
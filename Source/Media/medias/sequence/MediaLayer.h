@@ -44,8 +44,20 @@ public:
 
 	SpinLock renderLock;
 
+	//Only the clips around the playhead are evaluated on time changes, the index is rebuilt on the next tick after a clip edit
+	CriticalSection clipIndexLock;
+	ClipIntervalIndex clipIndex;
+	bool clipIndexIsDirty;
+	Array<MediaClip*> activeClips;
+
+	void clipIndexChanged();
+	void clipRemoved(MediaClip* clip);
+
 	void initFrameBuffer(int width, int height);
-	bool renderFrameBuffer(int width, int height);
+	bool renderFrameBuffer(int width, int height, bool renderMedias = false);
+	bool drawFrameBuffer(int width, int height, const Array<MediaClip*>& clipsToDraw);
+	void getClipsToDraw(Array<MediaClip*>& clipsToDraw, bool renderMedias);
+	bool canCompositeInOnePass();
 	void renderGL(int depth);
 
 	void sequenceCurrentTimeChanged(Sequence* s, float prevTime, bool evaluateSkippedData) override;
@@ -0,0 +1,287 @@
+/*
+  ==============================================================================
+
+	SequenceCompositor.cpp
+	Created: 19 Oct 2026 9:41:26pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+SequenceCompositor::SequenceCompositor() :
+	VAO(0)
+{
+}
+
+SequenceCompositor::~SequenceCompositor()
+{
+}
+
+bool SequenceCompositor::isSupported(MediaLayer* l)
+{
+	if (!l->canCompositeInOnePass()) return false;
+
+	return isSupportedFactor((int)l->blendFunctionSourceFactor->getValueData())
+		&& isSupportedFactor((int)l->blendFunctionDestinationFactor->getValueData())
+		&& isSupportedFactor((int)l->transitionBlendFunctionSourceFactor->getValueData())
+		&& isSupportedFactor((int)l->transitionBlendFunctionDestinationFactor->getValueData());
+}
+
+bool SequenceCompositor::isSupportedFactor(int f)
+{
+	switch (f)
+	{
+	case GL_ZERO:
+	case GL_ONE:
+	case GL_SRC_COLOR:
+	case GL_ONE_MINUS_SRC_COLOR:
+	case GL_SRC_ALPHA:
+	case GL_ONE_MINUS_SRC_ALPHA:
+	case GL_DST_ALPHA:
+	case GL_ONE_MINUS_DST_ALPHA:
+	case GL_DST_COLOR:
+	case GL_ONE_MINUS_DST_COLOR:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+int SequenceCompositor::getRunLength(const Array<MediaLayer*>& layers, const Array<Array<MediaClip*>>& clips, int start, bool overExisting)
+{
+	int maxTextures = overExisting ? maxClipTextures - 1 : maxClipTextures;
+	int numTextures = 0;
+	int end = start;
+
+	while (end < layers.size() && isSupported(layers[end]))
+	{
+		int numClips = clips.getReference(end).size();
+		if (numTextures + numClips > maxTextures) break;
+		numTextures += numClips;
+		end++;
+	}
+
+	//A layout that didn't compile goes back to the per layer framebuffers
+	while (end > start)
+	{
+		Array<Array<MediaClip*>> runClips;
+		for (int i = start; i < end; i++) runClips.add(clips.getReference(i));
+		if (!failedLayouts.contains(getLayout(runClips, overExisting))) break;
+		end--;
+	}
+
+	return end - start;
+}
+
+String SequenceCompositor::getLayout(const Array<Array<MediaClip*>>& clips, bool overExisting)
+{
+	String layout = overExisting ? "b" : "";
+	for (auto& c : clips) layout << c.size() << ",";
+	return layout;
+}
+
+void SequenceCompositor::render(const Array<MediaLayer*>& layers, const Array<Array<MediaClip*>>& clips, int width, int height, bool overExisting)
+{
+	OpenGLShaderProgram* program = getProgram(clips, overExisting);
+	if (program == nullptr) return;
+
+	if (VAO == 0) glGenVertexArrays(1, &VAO);
+
+	//What earlier layers left in the target can't be sampled while it's drawn to, so it's copied
+	if (overExisting)
+	{
+		GLint target = 0;
+		glGetIntegerv(GL_FRAMEBUFFER_BINDING, &target);
+
+		if (baseFBO.getWidth() != width || baseFBO.getHeight() != height)
+		{
+			baseFBO.release();
+			baseFBO.initialise(GlContextHolder::getInstance()->context, width, height);
+		}
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)target);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, baseFBO.getFrameBufferID());
+		glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)target);
+	}
+
+	glViewport(0, 0, width, height);
+	glDisable(GL_BLEND);
+
+	GLuint programID = program->getProgramID();
+	glUseProgram(programID);
+	glUniform2f(glGetUniformLocation(programID, "size"), (GLfloat)width, (GLfloat)height);
+
+	int clipIndex = 0;
+	for (int i = 0; i < layers.size(); i++)
+	{
+		MediaLayer* l = layers[i];
+		String li = "[" + String(i) + "]";
+
+		Colour c = l->backgroundColor->getColor();
+		glUniform4f(glGetUniformLocation(programID, ("layerBackground" + li).toRawUTF8()), c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue(), c.getFloatAlpha());
+		glUniform1i(glGetUniformLocation(programID, ("layerSrc" + li).toRawUTF8()), (int)l->blendFunctionSourceFactor->getValueData());
+		glUniform1i(glGetUniformLocation(programID, ("layerDst" + li).toRawUTF8()), (int)l->blendFunctionDestinationFactor->getValueData());
+		glUniform1i(glGetUniformLocation(programID, ("clipSrc" + li).toRawUTF8()), (int)l->transitionBlendFunctionSourceFactor->getValueData());
+		glUniform1i(glGetUniformLocation(programID, ("clipDst" + li).toRawUTF8()), (int)l->transitionBlendFunctionDestinationFactor->getValueData());
+
+		for (auto& clip : clips.getReference(i))
+		{
+			String ci = "[" + String(clipIndex) + "]";
+
+			glActiveTexture(GL_TEXTURE0 + clipIndex);
+			glBindTexture(GL_TEXTURE_2D, clip->media->frameBuffer.getTextureID());
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+			glUniform1i(glGetUniformLocation(programID, ("clipTex" + ci).toRawUTF8()), clipIndex);
+			glUniform1f(glGetUniformLocation(programID, ("clipFade" + ci).toRawUTF8()), (GLfloat)clip->getFadeMultiplier());
+			clipIndex++;
+		}
+	}
+
+	int numUnits = clipIndex;
+	if (overExisting)
+	{
+		glActiveTexture(GL_TEXTURE0 + numUnits);
+		glBindTexture(GL_TEXTURE_2D, baseFBO.getTextureID());
+		glUniform1i(glGetUniformLocation(programID, "baseTex"), numUnits);
+		numUnits++;
+	}
+
+	glBindVertexArray(VAO);
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	glBindVertexArray(0);
+
+	for (int i = numUnits - 1; i >= 0; i--)
+	{
+		glActiveTexture(GL_TEXTURE0 + i);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	glUseProgram(0);
+	glEnable(GL_BLEND);
+}
+
+void SequenceCompositor::releaseGL()
+{
+	programs.clear();
+	programLayouts.clear();
+	failedLayouts.clear();
+	baseFBO.release();
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	VAO = 0;
+}
+
+OpenGLShaderProgram* SequenceCompositor::getProgram(const Array<Array<MediaClip*>>& clips, bool overExisting)
+{
+	String layout = getLayout(clips, overExisting);
+
+	int index = programLayouts.indexOf(layout);
+	if (index >= 0) return programs[index];
+
+	if (programs.size() >= maxPrograms)
+	{
+		programs.clear();
+		programLayouts.clear();
+	}
+
+	const char* vertexShaderCode = R"(
+			#version 330
+			void main() {
+				vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+				gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+			}
+		)";
+
+	std::unique_ptr<OpenGLShaderProgram> program(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	if (!program->addVertexShader(vertexShaderCode) || !program->addFragmentShader(createFragmentShader(clips, overExisting)) || !program->link())
+	{
+		LOGERROR("Sequence compositor shader failed for layout " << layout << " : " << program->getLastError());
+		failedLayouts.add(layout);
+		return nullptr;
+	}
+
+	programLayouts.add(layout);
+	return programs.add(program.release());
+}
+
+String SequenceCompositor::createFragmentShader(const Array<Array<MediaClip*>>& clips, bool overExisting)
+{
+	int numLayers = jmax(clips.size(), 1);
+	int numClips = 0;
+	for (auto& c : clips) numClips += c.size();
+
+	String s;
+	s << "#version 330\n"
+		<< "uniform vec2 size;\n"
+		<< "uniform vec4 layerBackground[" << numLayers << "];\n"
+		<< "uniform int layerSrc[" << numLayers << "];\n"
+		<< "uniform int layerDst[" << numLayers << "];\n"
+		<< "uniform int clipSrc[" << numLayers << "];\n"
+		<< "uniform int clipDst[" << numLayers << "];\n";
+
+	if (numClips > 0)
+	{
+		s << "uniform sampler2D clipTex[" << numClips << "];\n"
+			<< "uniform float clipFade[" << numClips << "];\n";
+	}
+
+	if (overExisting) s << "uniform sampler2D baseTex;\n";
+
+	//Same factors as glBlendFunc, with the clamp an 8 bit framebuffer would apply after each blend.
+	//Layers with any other factor are never composited here, see isSupportedFactor.
+	s << R"(
+out vec4 fragColor;
+
+vec4 factor(int f, vec4 src, vec4 dst)
+{
+	switch (f)
+	{
+	case 0x0000: return vec4(0.0);					//GL_ZERO
+	case 0x0001: return vec4(1.0);					//GL_ONE
+	case 0x0300: return src;						//GL_SRC_COLOR
+	case 0x0301: return vec4(1.0) - src;			//GL_ONE_MINUS_SRC_COLOR
+	case 0x0302: return vec4(src.a);				//GL_SRC_ALPHA
+	case 0x0303: return vec4(1.0 - src.a);			//GL_ONE_MINUS_SRC_ALPHA
+	case 0x0304: return vec4(dst.a);				//GL_DST_ALPHA
+	case 0x0305: return vec4(1.0 - dst.a);			//GL_ONE_MINUS_DST_ALPHA
+	case 0x0306: return dst;						//GL_DST_COLOR
+	case 0x0307: return vec4(1.0) - dst;			//GL_ONE_MINUS_DST_COLOR
+	}
+	return vec4(0.0); //unreachable
+}
+
+vec4 blend(vec4 src, vec4 dst, int srcFactor, int dstFactor)
+{
+	return clamp(src * factor(srcFactor, src, dst) + dst * factor(dstFactor, src, dst), 0.0, 1.0);
+}
+
+void main()
+{
+	vec2 uv = gl_FragCoord.xy / size;
+	vec4 layer;
+)";
+
+	s << (overExisting ? "\tvec4 result = texture(baseTex, uv);\n" : "\tvec4 result = vec4(0.0);\n");
+
+	int clipIndex = 0;
+	for (int i = 0; i < clips.size(); i++)
+	{
+		s << "\n\tlayer = layerBackground[" << i << "];\n";
+		for (int j = 0; j < clips.getReference(i).size(); j++)
+		{
+			s << "\tlayer = blend(texture(clipTex[" << clipIndex << "], uv) * vec4(1.0, 1.0, 1.0, clipFade[" << clipIndex << "]), layer, clipSrc[" << i << "], clipDst[" << i << "]);\n";
+			clipIndex++;
+		}
+		s << "\tresult = blend(layer, result, layerSrc[" << i << "], layerDst[" << i << "]);\n";
+	}
+
+	s << "\n\tfragColor = result;\n}\n";
+	return s;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+	SequenceCompositor.h
+	Created: 19 Oct 2026 9:41:26pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class MediaLayer;
+
+/*
+	Composites runs of consecutive layers of a sequence in one shader pass, straight into the sequence's framebuffer.
+	Clip fades, transition blends, layer backgrounds and layer blends are evaluated per pixel in the same order
+	the per-layer framebuffers would apply them, so each layer isn't written and read back at full resolution.
+	One program is generated per layout (number of clips in each layer) and cached.
+	Layers it can't handle (custom blends, positionning) are drawn through their own framebuffer between the runs,
+	the runs after them start from a copy of what is already drawn.
+*/
+class SequenceCompositor
+{
+public:
+	SequenceCompositor();
+	~SequenceCompositor();
+
+	static const int maxClipTextures = 16;
+	static const int maxPrograms = 32;
+
+	OwnedArray<OpenGLShaderProgram> programs;
+	StringArray programLayouts;
+	StringArray failedLayouts;
+
+	GLuint VAO;
+	OpenGLFrameBuffer baseFBO;
+
+	static bool isSupported(MediaLayer* l);
+	static bool isSupportedFactor(int f);
+
+	//Layers in draw order, each with the clips it would draw. Returns how many layers from start fit in one pass, 0 if the first one doesn't.
+	//Over existing content, one texture unit goes to the copy of the framebuffer.
+	int getRunLength(const Array<MediaLayer*>& layers, const Array<Array<MediaClip*>>& clips, int start, bool overExisting);
+
+	//Draws in the bound framebuffer, which is overwritten unless overExisting is set
+	void render(const Array<MediaLayer*>& layers, const Array<Array<MediaClip*>>& clips, int width, int height, bool overExisting);
+
+	void releaseGL();
+
+	OpenGLShaderProgram* getProgram(const Array<Array<MediaClip*>>& clips, bool overExisting);
+	static String getLayout(const Array<Array<MediaClip*>>& clips, bool overExisting);
+	static String createFragmentShader(const Array<Array<MediaClip*>>& clips, bool overExisting);
+};
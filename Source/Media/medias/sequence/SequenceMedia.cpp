@@ -25,15 +25,197 @@ String RMPSequence::getPanelName() const
 
 
 SequenceMedia::SequenceMedia(var params)
-	: Media(getTypeString(), params, true)
+	: Media(getTypeString(), params, true),
+	offlineCC("Offline Render"),
+	offlineState(OFFLINE_IDLE),
+	offlineCancelled(false),
+	offlineFrame(0),
+	offlineNumFrames(0),
+	offlineStartTime(0),
+	offlineFrameTime(0),
+	offlineStartMillis(0)
 {
 	sequence.addSequenceListener(this);
 	addChildControllableContainer(&sequence);
 	alwaysRedraw = true;
+
+	offlineStart = offlineCC.addFloatParameter("Start Time", "Time in the sequence where the render starts", 0, 0);
+	offlineEnd = offlineCC.addFloatParameter("End Time", "Time in the sequence where the render ends. 0 means the end of the sequence", 0, 0);
+	offlineFPS = offlineCC.addFloatParameter("FPS", "Frames per second of the render, independent from the realtime fps", 30, 1, 240);
+	offlineRenderTrigger = offlineCC.addTrigger("Render", "Render the sequence into this media's Recorder, as fast as possible");
+	offlineCancelTrigger = offlineCC.addTrigger("Cancel", "Stop the render, frames already rendered are kept");
+	offlineProgress = offlineCC.addFloatParameter("Progress", "Progress of the render", 0, 0, 1);
+	offlineProgress->setControllableFeedbackOnly(true);
+	offlineProgress->isSavable = false;
+	offlineCC.editorIsCollapsed = true;
+	addChildControllableContainer(&offlineCC);
 }
 
 SequenceMedia::~SequenceMedia()
 {
+	stopTimer();
+	unregisterRenderer();
+}
+
+void SequenceMedia::onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c)
+{
+	Media::onControllableFeedbackUpdateInternal(cc, c);
+
+	if (cc == &offlineCC)
+	{
+		if (c == offlineRenderTrigger) startOfflineRender();
+		else if (c == offlineCancelTrigger) cancelOfflineRender();
+	}
+}
+
+void SequenceMedia::startOfflineRender()
+{
+	if (offlineState != OFFLINE_IDLE)
+	{
+		NLOGWARNING(niceName, "An offline render is already running");
+		return;
+	}
+
+	double endTime = offlineEnd->floatValue() > 0 ? jmin(offlineEnd->floatValue(), sequence.totalTime->floatValue()) : sequence.totalTime->floatValue();
+	double startTime = jlimit<double>(0, endTime, offlineStart->floatValue());
+	double fps = offlineFPS->floatValue();
+
+	offlineNumFrames = (int64)floor((endTime - startTime) * fps);
+	if (offlineNumFrames <= 0)
+	{
+		NLOGWARNING(niceName, "Nothing to render between " << startTime << " and " << endTime);
+		return;
+	}
+
+	sequence.pauseTrigger->trigger();
+
+	recorder.startRecording(fps);
+	if (!recorder.isRecording) return;
+	recorder.record->setValue(true);
+
+	setOfflineMode(true);
+
+	offlineFrame = 0;
+	offlineStartTime = startTime;
+	offlineFrameTime = 1.0 / fps;
+	offlineStartMillis = Time::getMillisecondCounterHiRes();
+	offlineProgress->setValue(0);
+	offlineCancelled = false;
+
+	NLOG(niceName, "Offline render started, " << offlineNumFrames << " frames at " << fps << " fps");
+	offlineState = OFFLINE_SEEKING;
+	startTimer(1);
+}
+
+void SequenceMedia::cancelOfflineRender()
+{
+	if (offlineState == OFFLINE_IDLE || offlineState == OFFLINE_FLUSHING || offlineCancelled) return;
+	offlineCancelled = true; //the timer flushes once the GL thread has handed back
+	NLOG(niceName, "Offline render cancelled at frame " << offlineFrame);
+}
+
+void SequenceMedia::finishOfflineRender()
+{
+	setOfflineMode(false);
+	recorder.record->setValue(false);
+
+	double elapsed = (Time::getMillisecondCounterHiRes() - offlineStartMillis) / 1000.0;
+	double rendered = offlineFrame * offlineFrameTime;
+	NLOG(niceName, "Offline render done, " << rendered << "s rendered in " << elapsed << "s (x" << String(rendered / jmax(elapsed, .001), 2) << ")");
+}
+
+void SequenceMedia::timerCallback()
+{
+	//Each state has a single owner, the message thread here for SEEKING and DECODING
+	if (offlineState == OFFLINE_SEEKING)
+	{
+		offlineProgress->setValue(offlineFrame * 1.0 / offlineNumFrames);
+
+		if (offlineCancelled || offlineFrame >= offlineNumFrames || !recorder.isRecording)
+		{
+			stopTimer();
+			offlineState = OFFLINE_FLUSHING;
+			return;
+		}
+
+		sequence.setCurrentTime(offlineStartTime + offlineFrame * offlineFrameTime, true, true);
+		offlineState = OFFLINE_DECODING;
+	}
+
+	if (offlineState == OFFLINE_DECODING && isOfflineFrameReady()) offlineState = OFFLINE_RENDERING;
+}
+
+bool SequenceMedia::isOfflineFrameReady()
+{
+	bool ready = true;
+
+	//every media is polled, so they all get their frame in the same wait
+	Array<MediaLayer*> mediaLayers = sequence.layerManager->getItemsWithType<MediaLayer>();
+	for (auto& l : mediaLayers)
+	{
+		for (auto& b : l->blockManager.items)
+		{
+			if (MediaClip* clip = dynamic_cast<MediaClip*>(b))
+			{
+				if (clip->media != nullptr && clip->media != this && !clip->media->isOfflineFrameReady()) ready = false;
+			}
+		}
+	}
+
+	return ready;
+}
+
+void SequenceMedia::renderOfflineFrame()
+{
+	//One frame per GL tick, the other medias and outputs render as usual
+	if (offlineState == OFFLINE_RENDERING)
+	{
+		//offline frames are never dropped, the next tick tries again when the encoders are behind
+		if (!recorder.isReadyForFrame()) return;
+
+		forceRedraw = true;
+		renderOpenGLMedia(true);
+		offlineFrame++;
+		offlineState = OFFLINE_SEEKING;
+		return;
+	}
+
+	if (offlineState == OFFLINE_FLUSHING)
+	{
+		recorder.collectFrames();
+		if (recorder.reader.getNumPending() > 0) return;
+
+		offlineState = OFFLINE_IDLE;
+
+		WeakReference<ControllableContainer> ref(this);
+		MessageManager::callAsync([ref]()
+			{
+				if (SequenceMedia* sm = dynamic_cast<SequenceMedia*>(ref.get())) sm->finishOfflineRender();
+			});
+	}
+}
+
+void SequenceMedia::setOfflineMode(bool offline)
+{
+	Media::setOfflineMode(offline);
+
+	Array<MediaLayer*> mediaLayers = sequence.layerManager->getItemsWithType<MediaLayer>();
+	for (auto& l : mediaLayers)
+	{
+		for (auto& b : l->blockManager.items)
+		{
+			if (MediaClip* clip = dynamic_cast<MediaClip*>(b))
+			{
+				if (clip->media != nullptr && clip->media != this) clip->media->setOfflineMode(offline);
+			}
+		}
+	}
+}
+
+void SequenceMedia::renderOpenGL()
+{
+	if (offlineState == OFFLINE_IDLE) Media::renderOpenGL();
+	else renderOfflineFrame();
 }
 
 void SequenceMedia::renderGLInternal()
@@ -48,22 +230,68 @@ void SequenceMedia::renderGLInternal()
 	frameBuffer.releaseAsRenderingTarget();
 
 	Array<MediaLayer*> mediaLayers = sequence.layerManager->getItemsWithType<MediaLayer>();
+
+	Array<MediaLayer*> layersToDraw;
+	Array<Array<MediaClip*>> clipsToDraw;
 	for (int i = mediaLayers.size() - 1; i >= 0; i--) //reverse so first in list is the last one processed
 	{
 		if (!mediaLayers[i]->enabled->boolValue()) continue;
-		
+
 		GenericScopedLock<SpinLock> lock(mediaLayers[i]->renderLock);
-		bool hasContent = mediaLayers[i]->renderFrameBuffer(width->intValue(), height->intValue()); //generate framebuffers
+		Array<MediaClip*> clips;
+		mediaLayers[i]->getClipsToDraw(clips, isRenderingOffline);
+		for (auto& c : clips) takeFrameTiming(c->media);
+		layersToDraw.add(mediaLayers[i]);
+		clipsToDraw.add(clips);
+	}
+
+	//Consecutive layers the compositor supports are drawn in one pass, the others through their own framebuffer
+	bool hasDrawn = false;
+	int i = 0;
+	while (i < layersToDraw.size())
+	{
+		int runLength = compositor.getRunLength(layersToDraw, clipsToDraw, i, hasDrawn);
+		if (runLength > 0)
+		{
+			Array<MediaLayer*> runLayers;
+			Array<Array<MediaClip*>> runClips;
+			for (int j = i; j < i + runLength; j++)
+			{
+				runLayers.add(layersToDraw[j]);
+				runClips.add(clipsToDraw.getReference(j));
+			}
+
+			frameBuffer.makeCurrentRenderingTarget();
+			compositor.render(runLayers, runClips, width->intValue(), height->intValue(), hasDrawn);
+			frameBuffer.releaseAsRenderingTarget();
+
+			hasDrawn = true;
+			i += runLength;
+			continue;
+		}
 
-		if (!hasContent) continue;
+		GenericScopedLock<SpinLock> lock(layersToDraw[i]->renderLock);
+		bool hasContent = layersToDraw[i]->drawFrameBuffer(width->intValue(), height->intValue(), clipsToDraw.getReference(i)); //generate framebuffers
 
-		frameBuffer.makeCurrentRenderingTarget();
-		mediaLayers[i]->renderGL(-i);
-		frameBuffer.releaseAsRenderingTarget();
+		if (hasContent)
+		{
+			frameBuffer.makeCurrentRenderingTarget();
+			Init2DViewport(width->intValue(), height->intValue());
+			layersToDraw[i]->renderGL(-mediaLayers.indexOf(layersToDraw[i]));
+			frameBuffer.releaseAsRenderingTarget();
+			hasDrawn = true;
+		}
+
+		i++;
 	}
 	glDisable(GL_BLEND);
 }
 
+void SequenceMedia::closeGLInternal()
+{
+	compositor.releaseGL();
+}
+
 void SequenceMedia::sequenceCurrentTimeChanged(Sequence* sequence, float time, bool evaluateSkippedData)
 {
 	shouldRedraw = true;
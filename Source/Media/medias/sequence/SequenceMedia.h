@@ -21,16 +21,50 @@ public:
 
 class SequenceMedia :
 	public Media,
-	public Sequence::SequenceListener
+	public Sequence::SequenceListener,
+	public Timer
 {
 public:
 	SequenceMedia(var params = var());
 	~SequenceMedia();
 
 	RMPSequence sequence;
+	SequenceCompositor compositor;
 
+	ControllableContainer offlineCC;
+	FloatParameter* offlineStart;
+	FloatParameter* offlineEnd;
+	FloatParameter* offlineFPS;
+	Trigger* offlineRenderTrigger;
+	Trigger* offlineCancelTrigger;
+	FloatParameter* offlineProgress;
 
+	/*
+		Offline render steps : the message thread seeks the sequence and waits for the clip medias to have the frame (SEEKING, DECODING),
+		the GL thread then renders it on its next tick (RENDERING) and hands back. FLUSHING waits on the GL thread for the last readbacks.
+	*/
+	enum OfflineState { OFFLINE_IDLE, OFFLINE_SEEKING, OFFLINE_DECODING, OFFLINE_RENDERING, OFFLINE_FLUSHING };
+	std::atomic<int> offlineState;
+	std::atomic<bool> offlineCancelled;
+	int64 offlineFrame;
+	int64 offlineNumFrames;
+	double offlineStartTime;
+	double offlineFrameTime;
+	double offlineStartMillis;
+
+	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
+
+	void startOfflineRender();
+	void cancelOfflineRender();
+	void finishOfflineRender();
+	void renderOfflineFrame();
+	void setOfflineMode(bool offline) override;
+	bool isOfflineFrameReady() override;
+	void timerCallback() override;
+
+	void renderOpenGL() override;
 	void renderGLInternal() override;
+	void closeGLInternal() override;
 	void sequenceCurrentTimeChanged(Sequence* sequence, float time, bool evaluateSkippedData) override;
 
 	DECLARE_TYPE("Sequence")
@@ -11,6 +11,14 @@
 #include "Media/MediaIncludes.h"
 #include "ShaderMedia.h"
 
+const String ShaderMedia::vertexShaderSource = R"(
+			#version 330
+			in vec3 position;
+			void main() {
+				gl_Position = vec4(position, 1.0);
+			}
+		)";
+
 ShaderMedia::ShaderMedia(var params) :
 	Media(getTypeString(), params, true),
 	Thread("ShaderToy Loader"),
@@ -22,6 +30,8 @@ ShaderMedia::ShaderMedia(var params) :
 	lastFrameTime(0),
 	VBO(0),
 	VAO(0),
+	standardUBO(0),
+	pendingPassesAreISF(false),
 	useMouse4D(false),
 	sourceMedias("Source Medias")
 {
@@ -69,6 +79,9 @@ ShaderMedia::ShaderMedia(var params) :
 ShaderMedia::~ShaderMedia()
 {
 	stopThread(1000);
+
+	//Pass targets have to be deleted with the context current
+	unregisterRenderer();
 }
 
 void ShaderMedia::onContainerParameterChangedInternal(Parameter* p)
@@ -134,10 +147,34 @@ void ShaderMedia::initGLInternal()
 
 	glGenBuffers(1, &VBO);
 	glGenVertexArrays(1, &VAO);
+
+	//The quad never changes, it's uploaded once
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void ShaderMedia::closeGLInternal()
+{
+	if (VBO != 0) glDeleteBuffers(1, &VBO);
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	if (standardUBO != 0) glDeleteBuffers(1, &standardUBO);
+	VBO = 0;
+	VAO = 0;
+	standardUBO = 0;
+
+	for (auto& p : passes) p->releaseGL();
+	clearPendingPasses();
 }
 
 void ShaderMedia::preRenderGLInternal()
 {
+	//Jobs are polled before new ones are requested : polling in the frame of the request would make the driver finish the compile right away
+	updatePendingCompile();
 	if (shouldReloadShader) reloadShader();
 	if (fragmentShaderToLoad.isNotEmpty()) loadFragmentShader(fragmentShaderToLoad);
 }
@@ -159,101 +196,155 @@ void ShaderMedia::renderGLInternal()
 	if (isLoadingShader) return;
 
 	//GenericScopedLock lock(shaderLock);
-	if (shader == nullptr) return;
+	if (passes.isEmpty()) return;
 
 	Point<int> size = getMediaSize();
+	Point<float> mousePos = mouseInputPos->getPoint() * Point<float>(size.x, size.y);
 
-	shader->use();
+	//Intermediate passes render in their own targets, then the output pass goes back to the media's framebuffer
+	GLint mediaFrameBuffer = 0;
+	if (passes.size() > 1) glGetIntegerv(GL_FRAMEBUFFER_BINDING, &mediaFrameBuffer);
 
+	for (auto& p : passes)
+	{
+		if (p->isOutput) continue;
 
-	Point<float> mousePos = mouseInputPos->getPoint() * Point<float>(size.x, size.y);
+		Point<int> passSize = p->getSize(size);
+		p->beginRender(passSize);
+		drawPass(p, passSize, mousePos, t, delta);
+		p->endRender();
+	}
+
+	if (passes.size() > 1) glBindFramebuffer(GL_FRAMEBUFFER, mediaFrameBuffer);
+
+	//Draw
+	Init2DViewport(size.x, size.y);
+
+	Colour bgColor = backgroundColor->getColor();
+	glClearColor(bgColor.getFloatRed(), bgColor.getFloatGreen(), bgColor.getFloatBlue(), bgColor.getFloatAlpha());
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	drawPass(passes.getLast(), size, mousePos, t, delta);
+
+	currentFrame++;
+}
+
+void ShaderMedia::drawPass(ShaderPass* pass, Point<int> size, Point<float> mousePos, double t, float delta)
+{
+	pass->program->use();
+
+	if (pass->bindings.isDirty) updatePassBindings(pass);
 
-	//Set uniforms
-	if (useResolution3D) shader->setUniform(resolutionUniformName.toStdString().c_str(), size.x, size.y, 0.f);
-	else if (resolutionUniformName.isNotEmpty())	shader->setUniform(resolutionUniformName.toStdString().c_str(), size.x, size.y);
-	if (timeUniformName.isNotEmpty()) shader->setUniform(timeUniformName.toStdString().c_str(), (float)t);
-	if (timeDeltaUniformName.isNotEmpty()) shader->setUniform(timeDeltaUniformName.toStdString().c_str(), delta);
-	if (frameUniformName.isNotEmpty()) shader->setUniform(frameUniformName.toStdString().c_str(), currentFrame);
+	ShaderUniformTable* uniforms = pass->uniforms.get();
+	const ShaderPassBindings& b = pass->bindings;
 
+	//Set uniforms, only the values that differ from what the program already has are uploaded
+	if (uniforms->hasStandardBlock)
+	{
+		ShaderUniformTable::StandardInputs inputs;
+		inputs.resolution[0] = size.x;
+		inputs.resolution[1] = size.y;
+		inputs.time = (float)t;
+		inputs.mouse[0] = mousePos.x;
+		inputs.mouse[1] = mousePos.y;
+		inputs.mouse[2] = mouseClick->floatValue();
+		inputs.timeDelta = delta;
+		inputs.frameRate = delta > 0 ? 1.0f / delta : 0;
+		inputs.frame = currentFrame;
+
+		if (standardUBO == 0)
+		{
+			glGenBuffers(1, &standardUBO);
+			glBindBuffer(GL_UNIFORM_BUFFER, standardUBO);
+			glBufferData(GL_UNIFORM_BUFFER, sizeof(inputs), &inputs, GL_DYNAMIC_DRAW);
+			lastStandardInputs = inputs;
+		}
+		else
+		{
+			glBindBuffer(GL_UNIFORM_BUFFER, standardUBO);
+			if (memcmp(&inputs, &lastStandardInputs, sizeof(inputs)) != 0)
+			{
+				glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(inputs), &inputs);
+				lastStandardInputs = inputs;
+			}
+		}
 
-	if (mouseUniformName.isNotEmpty())
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		glBindBufferBase(GL_UNIFORM_BUFFER, ShaderUniformTable::standardBlockBinding, standardUBO);
+	}
+	else
 	{
-		if (useMouse4D) shader->setUniform(mouseUniformName.toStdString().c_str(), mousePos.x, mousePos.y, mouseClick->floatValue(), 0.f);
-		else if (mouseUniformName.isNotEmpty()) shader->setUniform(mouseUniformName.toStdString().c_str(), mousePos.x, mousePos.y);
+		GLfloat resolution[3] = { (GLfloat)size.x, (GLfloat)size.y, 0 };
+		GLfloat mouse[4] = { mousePos.x, mousePos.y, mouseClick->floatValue(), 0 };
+
+		uniforms->setFloats(b.standardIndices[ShaderPassBindings::RESOLUTION_UNIFORM], resolution, useResolution3D ? 3 : 2);
+		uniforms->setFloat(b.standardIndices[ShaderPassBindings::TIME_UNIFORM], (float)t);
+		uniforms->setFloat(b.standardIndices[ShaderPassBindings::TIME_DELTA_UNIFORM], delta);
+		uniforms->setInt(b.standardIndices[ShaderPassBindings::FRAME_UNIFORM], currentFrame);
+		uniforms->setFloats(b.standardIndices[ShaderPassBindings::MOUSE_UNIFORM], mouse, useMouse4D ? 4 : 2);
 	}
 
+	uniforms->setInt(b.standardIndices[ShaderPassBindings::PASS_INDEX_UNIFORM], pass->passIndex);
+
 
 	ShaderType st = shaderType->getValueDataAsEnum<ShaderType>();
+	bool isISF = st == ShaderISFFile || st == ShaderISFURL;
 
+	int unit = textureUnitOffset;
 	int texIndex = 0;
-	int offset = 5;
-	for (auto& tp : sourceMedias.controllables)
+	for (int i = 0; i < b.sourceBindings.size(); i++)
 	{
-		TargetParameter* p = dynamic_cast<TargetParameter*>(tp);
-		if (Media* m = p->getTargetContainerAs<Media>())
+		if (Media* m = b.sourceBindings[i]->getTargetContainerAs<Media>())
 		{
-			glActiveTexture(GL_TEXTURE0 + texIndex + offset);
+			glActiveTexture(GL_TEXTURE0 + unit);
 			glBindTexture(GL_TEXTURE_2D, m->getTextureID());
 
-			String texName = textureUniformName.isEmpty() ? "" : (textureUniformName + String(texIndex));
-			if (st == ShaderISFFile || st == ShaderISFURL) texName = p->niceName;
-
-			if (texName.isNotEmpty())
+			//ShaderToy channels are numbered by the sources that are set, ISF textures are named after their parameter
+			if (isISF || textureUniformName.isNotEmpty())
 			{
-				shader->setUniform(texName.toStdString().c_str(), texIndex + offset);
+				uniforms->setInt(isISF ? b.sourceUniformIndices[i] : b.channelUniformIndices[texIndex], unit);
 				texIndex++;
+				unit++;
 			}
 		}
-	};
+	}
 
-	for (auto& cp : mediaParams.controllables)
+	for (auto& tb : b.textureBindings)
 	{
-		if (!cp->enabled) continue;
-		Parameter* p = dynamic_cast<Parameter*>(cp);
-		shader->getUniformIDFromName(p->niceName.toStdString().c_str());
-		var val = p->getValue();
-		switch (val.size())
-		{
-		case 0: shader->setUniform(p->niceName.toStdString().c_str(), (float)val); break;
-		case 1:
-			if (cp->type == Controllable::BOOL) shader->setUniform(p->niceName.toStdString().c_str(), (GLint)(int)val[0]);
-			else shader->setUniform(p->niceName.toStdString().c_str(), (float)val);
-			break;
-		case 2: shader->setUniform(p->niceName.toStdString().c_str(), (float)val[0], (float)val[1]); break;
-		case 3: shader->setUniform(p->niceName.toStdString().c_str(), (float)val[0], (float)val[1], (float)val[2]); break;
-		case 4: shader->setUniform(p->niceName.toStdString().c_str(), (float)val[0], (float)val[1], (float)val[2], (float)val[3]); break;
-		}
+		GLuint textureID = 0;
+		if (tb.pass != nullptr) textureID = tb.pass->getTextureID();
+		else if (Media* m = tb.parameter->getTargetContainerAs<Media>()) textureID = m->getTextureID();
+
+		glActiveTexture(GL_TEXTURE0 + unit);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+		uniforms->setInt(tb.uniformIndex, unit);
+		unit++;
 	}
 
-	//Draw
-	Init2DViewport(size.x, size.y);
-
-	Colour bgColor = backgroundColor->getColor();
-	glClearColor(bgColor.getFloatRed(), bgColor.getFloatGreen(), bgColor.getFloatBlue(), bgColor.getFloatAlpha());
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-
+	for (auto& pb : b.parameterBindings)
+	{
+		if (!pb.parameter->enabled) continue;
+		var val = pb.parameter->getValue();
+		GLfloat values[4] = { 0, 0, 0, 0 };
+		int numValues = jlimit(1, 4, val.size());
+		if (val.isArray()) for (int i = 0; i < numValues; i++) values[i] = (float)val[i];
+		else values[0] = (float)val;
+		uniforms->setFloats(pb.uniformIndex, values, numValues);
+	}
 
 	glBindVertexArray(VAO);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
+	glBindVertexArray(0);
 
 	glUseProgram(0);
 
-	for (int i = 0; i < texIndex; i++)
+	for (int i = textureUnitOffset; i < unit; i++)
 	{
-		glActiveTexture(GL_TEXTURE0 + texIndex + offset);
+		glActiveTexture(GL_TEXTURE0 + i);
 		glBindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	glActiveTexture(GL_TEXTURE0);
-
-	currentFrame++;
 }
 
 void ShaderMedia::reloadShader()
@@ -292,13 +383,14 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 	LOG("load fragment shader");
 
 	isLoadingShader = true;
-	shaderLoaded->setValue(false);
-
-	//unload shader
-	shader.reset();
 
 	if (fragmentShader.isEmpty())
 	{
+		//unload shader
+		for (auto& p : passes) p->releaseGL();
+		passes.clear();
+		clearPendingPasses();
+		shaderLoaded->setValue(false);
 		isLoadingShader = false;
 		return;
 
@@ -345,12 +437,45 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 
 	fullShader = parseUniforms(fullShader);
 
-	shader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
-
-	String fShader = versionLine;
+	//Standard inputs go in a uniform block when the GLSL version has them, see ShaderUniformTable::StandardInputs for the layout
+	bool useInputsBlock = versionLine.fromFirstOccurrenceOf("#version", false, false).trim().getIntValue() >= 140;
 
 	st = shaderType->getValueDataAsEnum<ShaderType>();
 
+	clearPendingPasses();
+
+	switch (st)
+	{
+	case ShaderToyFile:
+	case ShaderToyURL:
+		createShaderToyPasses(fullShader, versionLine, useInputsBlock);
+		break;
+
+	case ShaderISFFile:
+	case ShaderISFURL:
+		createISFPasses(buildFragmentShader(st, versionLine, fullShader, useInputsBlock));
+		break;
+
+	default:
+		pendingPasses.add(new ShaderPass("Output", true))->fragmentSource = buildFragmentShader(st, versionLine, fullShader, useInputsBlock);
+		break;
+	}
+
+
+	//Medias with the same final source share the same program, only the first one compiles it.
+	//The current passes keep rendering until all the new ones are linked.
+	for (auto& p : pendingPasses) p->compileJob = ShaderProgramCache::getInstance()->requestProgram(vertexShaderSource, p->fragmentSource);
+	pendingPassesAreISF = fragmentIsISF;
+
+	shaderOfflineData = fragmentShaderToLoad;
+	fragmentShaderToLoad = "";
+	isLoadingShader = false;
+}
+
+String ShaderMedia::buildFragmentShader(ShaderType st, const String& versionLine, const String& code, bool useInputsBlock)
+{
+	String fShader = versionLine;
+
 	switch (st)
 	{
 	case ShaderToyFile:
@@ -361,21 +486,35 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 			precision mediump float;
 			#endif
 
+			)"
+			+ String(useInputsBlock ? R"(
+			layout(std140) uniform ShaderInputs {
+				vec3  iResolution;
+				float iTime;
+				vec4  iMouse;
+				vec4  iDate;
+				float iTimeDelta;
+				float iFrameRate;
+				int   iFrame;
+			};
+			)" : R"(
 			uniform vec3      iResolution;           // viewport resolution (in pixels)
 			uniform float     iTime;                 // shader playback time (in seconds)
 			uniform float     iTimeDelta;            // render time (in seconds)
 			uniform float     iFrameRate;            // shader frame rate
 			uniform int       iFrame;                // shader playback frame
-			uniform float     iChannelTime[4];       // channel playback time (in seconds)
-			uniform vec3      iChannelResolution[4]; // channel resolution (in pixels)
 			uniform vec4      iMouse;                // mouse pixel coords. xy: current (if MLB down), zw: click
 			uniform vec4      iDate;                 // (year, month, day, time in seconds)
+			)")
+			+ R"(
+			uniform float     iChannelTime[4];       // channel playback time (in seconds)
+			uniform vec3      iChannelResolution[4]; // channel resolution (in pixels)
 			uniform sampler2D iChannel0;             // input channel. XX = 2D/Cube
 			uniform sampler2D iChannel1;             // input channel. XX = 2D/Cube
 			uniform sampler2D iChannel2;             // input channel. XX = 2D/Cube
 			uniform sampler2D iChannel3;             // input channel. XX = 2D/Cube
 			)"
-			+ fullShader
+			+ code
 			+ R"(
 
 			void main()
@@ -412,7 +551,7 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 		useMouse4D = false;
 		useResolution3D = false;
 
-		fShader += fullShader;
+		fShader += code;
 
 	}
 	break;
@@ -421,12 +560,27 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 	case ShaderISFURL:
 	{
 		fShader += R"(
-			int PASSINDEX;
+			uniform int PASSINDEX;
+			)"
+			+ String(useInputsBlock ? R"(
+			layout(std140) uniform ShaderInputs {
+				vec2  RENDERSIZE;
+				float isf_unused0;
+				float TIME;
+				vec4  isf_unused1;
+				vec4  DATE;
+				float TIMEDELTA;
+				float isf_unused2;
+				int   FRAMEINDEX;
+			};
+			)" : R"(
 			uniform vec2 RENDERSIZE;
 			uniform float TIME;
 			uniform float TIMEDELTA;
 			uniform int FRAMEINDEX;
 			uniform vec4 DATE;	
+			)")
+			+ R"(
 			uniform vec2 isf_FragNormCoord;
 
 			vec4 IMG_PIXEL(sampler2D img, vec2 coord) {
@@ -443,7 +597,7 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 			}
 
 			)"
-			+ fullShader
+			+ code
 			;
 
 		resolutionUniformName = "RENDERSIZE";
@@ -461,70 +615,316 @@ void ShaderMedia::loadFragmentShader(const String& fragmentShader)
 	break;
 	}
 
+	return fShader;
+}
+
+void ShaderMedia::createShaderToyPasses(const String& code, const String& versionLine, bool useInputsBlock)
+{
+	/*
+		Multipass ShaderToys are split with directive lines, what comes before the first one is shared by all passes :
+		//#common									code added to every pass
+		//#pass Buffer A [scale=0.5] [float=0]		Buffer A to D then Image, rendered in that order
+		//#channel 0 Buffer A						iChannel0 of the pass reads Buffer A, or "Source N" for the Nth source media
+	*/
+	struct PassCode
+	{
+		String name;
+		String code;
+		StringArray channels;
+		float scale = 1;
+		bool isFloat = true;
+	};
 
-	const char* vertexShaderCode = R"(
-			#version 330
-			in vec3 position;
-			void main() {
-				gl_Position = vec4(position, 1.0);
+	Array<PassCode> passCodes;
+	String sharedCode;
+	int currentPass = -1;
+
+	StringArray lines;
+	lines.addLines(code);
+
+	for (auto& l : lines)
+	{
+		String t = l.trim();
+		if (t.startsWith("//#common"))
+		{
+			currentPass = -1;
+			continue;
+		}
+
+		if (t.startsWith("//#pass"))
+		{
+			PassCode pc;
+			StringArray tokens;
+			tokens.addTokens(t.fromFirstOccurrenceOf("//#pass", false, false).trim(), " ", "\"");
+
+			StringArray nameTokens;
+			for (auto& tk : tokens)
+			{
+				if (tk.startsWith("scale=")) pc.scale = jmax(tk.fromFirstOccurrenceOf("=", false, false).getFloatValue(), .01f);
+				else if (tk.startsWith("float=")) pc.isFloat = tk.fromFirstOccurrenceOf("=", false, false).getIntValue() != 0;
+				else if (tk.isNotEmpty()) nameTokens.add(tk);
 			}
-		)";
 
-	if (!shader->addVertexShader(vertexShaderCode))
+			pc.name = nameTokens.joinIntoString(" ");
+			passCodes.add(pc);
+			currentPass = passCodes.size() - 1;
+			continue;
+		}
+
+		if (t.startsWith("//#channel") && currentPass >= 0)
+		{
+			String args = t.fromFirstOccurrenceOf("//#channel", false, false).trim();
+			int channel = args.upToFirstOccurrenceOf(" ", false, false).getIntValue();
+			if (!isPositiveAndBelow(channel, 4)) continue;
+
+			StringArray& channels = passCodes.getReference(currentPass).channels;
+			while (channels.size() <= channel) channels.add("");
+			channels.set(channel, args.fromFirstOccurrenceOf(" ", false, false).trim());
+			continue;
+		}
+
+		if (currentPass >= 0) passCodes.getReference(currentPass).code += l + "\n";
+		else sharedCode += l + "\n";
+	}
+
+	if (passCodes.isEmpty())
+	{
+		pendingPasses.add(new ShaderPass("Image", true))->fragmentSource = buildFragmentShader(ShaderToyFile, versionLine, code, useInputsBlock);
+		return;
+	}
+
+	//Buffers in alphabetical order, then the image
+	std::stable_sort(passCodes.begin(), passCodes.end(), [](const PassCode& a, const PassCode& b)
+		{
+			bool aIsImage = a.name == "Image";
+			bool bIsImage = b.name == "Image";
+			if (aIsImage != bIsImage) return bIsImage;
+			return a.name.compare(b.name) < 0;
+		});
+
+	for (auto& pc : passCodes)
+	{
+		bool isOutput = pc.name == "Image";
+		ShaderPass* p = pendingPasses.add(new ShaderPass(pc.name, isOutput));
+		p->isFloat = pc.isFloat && !isOutput;
+		p->scale = pc.scale;
+		p->channels = pc.channels;
+		p->fragmentSource = buildFragmentShader(ShaderToyFile, versionLine, sharedCode + pc.code, useInputsBlock);
+	}
+
+	pendingPasses.getLast()->isOutput = true; //without an Image pass, the last buffer is shown
+}
+
+void ShaderMedia::createISFPasses(const String& fragment)
+{
+	//All ISF passes share the same program, PASSINDEX tells them apart
+	std::unique_ptr<ShaderPass> output;
+
+	for (int i = 0; i < isfPasses.size(); i++)
+	{
+		var pd = isfPasses[i];
+		String target = pd.getProperty("TARGET", "").toString();
+
+		if (target.isEmpty())
+		{
+			if (output == nullptr)
+			{
+				output.reset(new ShaderPass("Output", true));
+				output->passIndex = i;
+			}
+			continue;
+		}
+
+		ShaderPass* p = pendingPasses.add(new ShaderPass(target, false));
+		p->passIndex = i;
+		p->isPersistent = pd.getProperty("PERSISTENT", false);
+		p->isFloat = pd.getProperty("FLOAT", false);
+		p->widthExpression = pd.getProperty("WIDTH", "").toString();
+		p->heightExpression = pd.getProperty("HEIGHT", "").toString();
+	}
+
+	if (output == nullptr)
 	{
-		NLOGERROR(niceName, "Vertex shader compilation failed: " << shader->getLastError());
+		output.reset(new ShaderPass("Output", true));
+		output->passIndex = jmax(isfPasses.size() - 1, 0);
 	}
 
-	if (!shader->addFragmentShader(fShader))
+	pendingPasses.add(output.release());
+	for (auto& p : pendingPasses) p->fragmentSource = fragment;
+}
+
+void ShaderMedia::updatePendingCompile()
+{
+	if (pendingPasses.isEmpty()) return;
+
+	bool allDone = true;
+	for (auto& p : pendingPasses)
 	{
-		NLOGERROR(niceName, "Fragment shader compilation failed: " << shader->getLastError());
-		//LOGERROR(fShader);
+		if (!ShaderProgramCache::getInstance()->updateJob(p->compileJob.get())) allDone = false;
 	}
 
-	if (!shader->link())
+	if (!allDone) return;
+
+	StringArray errors;
+	for (auto& p : pendingPasses)
 	{
-		NLOGERROR(niceName, "Fragment shader link failed: " << shader->getLastError());
+		if (p->compileJob->state != ShaderProgramCache::CompileJob::READY) errors.add((pendingPasses.size() > 1 ? p->name + " : " : "") + p->compileJob->error);
 	}
 
-	if (shader->getLastError().isEmpty())
+	if (errors.isEmpty())
 	{
-		NLOG(niceName, "Shader compiled and linked successfully");
+		for (auto& p : pendingPasses)
+		{
+			p->program = p->compileJob->program;
+			p->uniforms = p->compileJob->uniforms;
+			p->compileJob.reset();
+			if (ShaderPass* previous = getPass(p->name)) p->takeTargetsFrom(previous);
+		}
+
+		for (auto& p : passes) p->releaseGL();
+		passes.clear();
+		passes.swapWith(pendingPasses);
+
+		{
+			GenericScopedLock lock(programSourcesLock);
+			programSources.clear();
+			for (auto& p : passes) programSources.add(p->fragmentSource);
+		}
+
+		NLOG(niceName, "Shader compiled and linked successfully" << (passes.size() > 1 ? " (" + String(passes.size()) + " passes)" : ""));
 		shaderLoaded->setValue(true);
+		shouldGeneratePreviewImage = true;
+
+		if (pendingPassesAreISF) updateISFSourceMedias();
 	}
 	else
 	{
-		shader.reset();
+		for (auto& e : errors) NLOGERROR(niceName, e);
+		if (!passes.isEmpty()) NLOGWARNING(niceName, "Keeping the previous shader");
+		clearPendingPasses();
 	}
 
+	ShaderProgramCache::getInstance()->purgeUnused(); //the previous programs may not be used anymore
+}
+
+StringArray ShaderMedia::getProgramSources()
+{
+	GenericScopedLock lock(programSourcesLock);
+	return programSources;
+}
 
-	shaderOfflineData = fragmentShaderToLoad;
-	fragmentShaderToLoad = "";
-	isLoadingShader = false;
+void ShaderMedia::clearPendingPasses()
+{
+	for (auto& p : pendingPasses) p->releaseGL();
+	pendingPasses.clear();
+}
 
+ShaderPass* ShaderMedia::getPass(const String& name) const
+{
+	for (auto& p : passes) if (p->name == name) return p;
+	return nullptr;
+}
 
-	if (shaderLoaded->boolValue() && fragmentIsISF)
+void ShaderMedia::updatePassBindings(ShaderPass* pass)
+{
+	ShaderPassBindings& b = pass->bindings;
+	ShaderUniformTable* u = pass->uniforms.get();
+	b.isDirty = false;
+
+	b.standardIndices[ShaderPassBindings::RESOLUTION_UNIFORM] = u->indexOf(resolutionUniformName);
+	b.standardIndices[ShaderPassBindings::TIME_UNIFORM] = u->indexOf(timeUniformName);
+	b.standardIndices[ShaderPassBindings::TIME_DELTA_UNIFORM] = u->indexOf(timeDeltaUniformName);
+	b.standardIndices[ShaderPassBindings::FRAME_UNIFORM] = u->indexOf(frameUniformName);
+	b.standardIndices[ShaderPassBindings::MOUSE_UNIFORM] = u->indexOf(mouseUniformName);
+	b.standardIndices[ShaderPassBindings::PASS_INDEX_UNIFORM] = u->indexOf("PASSINDEX");
+
+	b.sourceBindings.clearQuick();
+	b.sourceUniformIndices.clearQuick();
+	b.channelUniformIndices.clearQuick();
+	b.textureBindings.clearQuick();
+
+	if (pass->channels.isEmpty())
 	{
-		//update source medias with isf names
-		while (sourceMedias.controllables.size() > isfTextureNames.size())
+		for (auto& c : sourceMedias.controllables)
 		{
-			sourceMedias.controllables.removeLast();
+			if (TargetParameter* p = dynamic_cast<TargetParameter*>(c))
+			{
+				b.channelUniformIndices.add(textureUniformName.isEmpty() ? -1 : u->indexOf(textureUniformName + String(b.sourceBindings.size())));
+				b.sourceUniformIndices.add(u->indexOf(p->niceName));
+				b.sourceBindings.add(p);
+			}
 		}
-
-		for (int i = 0; i < sourceMedias.controllables.size(); i++)
+	}
+	else
+	{
+		for (int i = 0; i < pass->channels.size(); i++)
 		{
-			TargetParameter* p = (TargetParameter*)sourceMedias.controllables[i];
-			p->setNiceName(isfTextureNames[i]);
+			String channel = pass->channels[i];
+			int uniformIndex = u->indexOf(textureUniformName + String(i));
+			if (channel.isEmpty() || uniformIndex < 0) continue;
+
+			if (channel.startsWith("Source"))
+			{
+				int sourceIndex = channel.fromFirstOccurrenceOf("Source", false, false).trim().getIntValue();
+				if (TargetParameter* p = dynamic_cast<TargetParameter*>(sourceMedias.controllables[sourceIndex])) b.textureBindings.add({ p, nullptr, uniformIndex });
+			}
+			else if (ShaderPass* source = getPass(channel))
+			{
+				b.textureBindings.add({ nullptr, source, uniformIndex });
+			}
 		}
+	}
+
+	//ISF pass targets are samplers named after them
+	for (auto& p : passes)
+	{
+		if (p->isOutput) continue;
+		int uniformIndex = u->indexOf(p->name);
+		if (uniformIndex >= 0) b.textureBindings.add({ nullptr, p, uniformIndex });
+	}
 
-		while (sourceMedias.controllables.size() < isfTextureNames.size())
+	//Parameters that don't match an active uniform are not evaluated at all
+	b.parameterBindings.clearQuick();
+	for (auto& c : mediaParams.controllables)
+	{
+		if (Parameter* p = dynamic_cast<Parameter*>(c))
 		{
-			String n = isfTextureNames[sourceMedias.controllables.size()];
-			TargetParameter* p = sourceMedias.addTargetParameter(n, "Source Media for texture  " + n, MediaManager::getInstance());
-			p->targetType = TargetParameter::CONTAINER;
-			p->maxDefaultSearchLevel = 0;
-			p->saveValueOnly = false;
+			int index = u->indexOf(p->niceName);
+			if (index >= 0) b.parameterBindings.add({ p, index });
 		}
+	}
+}
+
+void ShaderMedia::childStructureChanged(ControllableContainer* cc)
+{
+	Media::childStructureChanged(cc);
+	if (cc == &mediaParams || cc == &sourceMedias)
+	{
+		for (auto& p : passes) p->bindings.isDirty = true;
+	}
+}
+
+void ShaderMedia::updateISFSourceMedias()
+{
+	//update source medias with isf names
+	while (sourceMedias.controllables.size() > isfTextureNames.size())
+	{
+		sourceMedias.controllables.removeLast();
+	}
+
+	for (int i = 0; i < sourceMedias.controllables.size(); i++)
+	{
+		TargetParameter* p = (TargetParameter*)sourceMedias.controllables[i];
+		p->setNiceName(isfTextureNames[i]);
+	}
 
+	while (sourceMedias.controllables.size() < isfTextureNames.size())
+	{
+		String n = isfTextureNames[sourceMedias.controllables.size()];
+		TargetParameter* p = sourceMedias.addTargetParameter(n, "Source Media for texture  " + n, MediaManager::getInstance());
+		p->targetType = TargetParameter::CONTAINER;
+		p->maxDefaultSearchLevel = 0;
+		p->saveValueOnly = false;
 	}
 }
 
@@ -576,6 +976,7 @@ String ShaderMedia::parseUniforms(const String& fragmentShader)
 
 	detectedUniforms.clear();
 	isfTextureNames.clear();
+	isfPasses = var();
 
 	ShaderType st = shaderType->getValueDataAsEnum<ShaderType>();
 
@@ -674,6 +1075,14 @@ String ShaderMedia::parseUniforms(const String& fragmentShader)
 					}
 				}
 
+				//Pass targets are read as textures named after them
+				isfPasses = json["PASSES"];
+				for (int i = 0; i < isfPasses.size(); i++)
+				{
+					String target = isfPasses[i].getProperty("TARGET", "").toString();
+					if (target.isNotEmpty()) uniformsDeclaration += "uniform sampler2D " + target + ";\n";
+				}
+
 				result = result.substring(jsonData[0].length());
 				result = uniformsDeclaration + result;
 
@@ -925,14 +1334,9 @@ void ShaderMedia::run()
 						}
 					}
 
-					if (data["Shader"]["renderpass"].size() > 1)
-					{
-						LOGWARNING("ShaderToy has more than one render pass, not supported right now");
-					}
-					else
-					{
-						shaderStr = data["Shader"]["renderpass"][0]["code"].toString();
-					}
+					var renderPasses = data["Shader"]["renderpass"];
+					if (renderPasses.size() > 1) shaderStr = getShaderToyPassesCode(renderPasses);
+					else shaderStr = renderPasses[0]["code"].toString();
 				}
 			}
 			else if (st == ShaderISFURL)
@@ -955,10 +1359,66 @@ void ShaderMedia::run()
 	}
 }
 
+String ShaderMedia::getShaderToyPassesCode(var renderPasses)
+{
+	//Buffer inputs point to the output id of another pass, older shaders use placeholder textures instead
+	HashMap<String, String> outputNames;
+	for (int i = 0; i < renderPasses.size(); i++)
+	{
+		var outputs = renderPasses[i]["outputs"];
+		if (outputs.size() > 0) outputNames.set(outputs[0]["id"].toString(), renderPasses[i]["name"].toString());
+	}
+
+	String result;
+	for (int i = 0; i < renderPasses.size(); i++)
+	{
+		var rp = renderPasses[i];
+		String type = rp["type"].toString();
+
+		if (type == "common") result += "//#common\n";
+		else if (type == "buffer" || type == "image")
+		{
+			result += "//#pass " + (type == "image" ? String("Image") : rp["name"].toString()) + "\n";
+
+			var inputs = rp["inputs"];
+			for (int j = 0; j < inputs.size(); j++)
+			{
+				var input = inputs[j];
+				int channel = input["channel"];
+				String inputType = input.getProperty("ctype", input.getProperty("type", "")).toString();
+
+				String source = "Source " + String(channel);
+				if (inputType == "buffer")
+				{
+					String id = input["id"].toString();
+					if (outputNames.contains(id)) source = outputNames[id];
+					else source = "Buffer " + String::charToString((juce_wchar)('A' + input["src"].toString().fromLastOccurrenceOf("buffer", false, false).getIntValue()));
+				}
+
+				result += "//#channel " + String(channel) + " " + source + "\n";
+			}
+		}
+		else
+		{
+			LOGWARNING("ShaderToy " << type << " passes are not supported, skipping " << rp["name"].toString());
+			continue;
+		}
+
+		result += rp["code"].toString() + "\n";
+	}
+
+	return result;
+}
+
 var ShaderMedia::getJSONData(bool includeNonOverriden)
 {
 	var data = Media::getJSONData(includeNonOverriden);
 	data.getDynamicObject()->setProperty("shaderCache", shaderOfflineData);
+
+	var sourcesData;
+	for (auto& s : getProgramSources()) sourcesData.append(s);
+	if (sourcesData.size() > 0) data.getDynamicObject()->setProperty("programSources", sourcesData);
+
 	data.getDynamicObject()->setProperty(sourceMedias.shortName, sourceMedias.getJSONData());
 	return data;
 }
@@ -984,4 +1444,9 @@ void ShaderMedia::loadJSONDataItemInternal(var data)
 	}
 
 	if (data.getDynamicObject()->hasProperty("shaderCache")) shaderOfflineData = data.getDynamicObject()->getProperty("shaderCache");
+
+	var sourcesData = data.getProperty("programSources", var());
+	GenericScopedLock lock(programSourcesLock);
+	programSources.clear();
+	for (int i = 0; i < sourcesData.size(); i++) programSources.add(sourcesData[i].toString());
 }
@@ -67,13 +67,25 @@ public:
 	double firstFrameTime = 0;
 
 	//SpinLock shaderLock;
-	std::unique_ptr<OpenGLShaderProgram> shader;
+	//Rendered in order, the last one in the media's framebuffer. Programs are owned by the ShaderProgramCache.
+	OwnedArray<ShaderPass> passes;
+	OwnedArray<ShaderPass> pendingPasses; //compiling, they replace all the passes at once when they're all linked
+	bool pendingPassesAreISF;
+
+	static const int textureUnitOffset = 5;
+
+	GLuint standardUBO;
+	ShaderUniformTable::StandardInputs lastStandardInputs;
 	GLuint VBO, VAO;
 
 	bool autoLoadShader;
 	bool shouldReloadShader;
 	String fragmentShaderToLoad;
 	String shaderOfflineData; //for online shader, store the data to be able to reload it offline
+
+	static const String vertexShaderSource;
+	CriticalSection programSourcesLock;
+	StringArray programSources; //fragment sources of the linked passes, saved so the engine can warm the program cache up on load
 	bool isLoadingShader;
 
 	String textureUniformName;
@@ -85,6 +97,7 @@ public:
 	String frameUniformName;
 
 	StringArray isfTextureNames;
+	var isfPasses;
 
 	const float vertices[24] = {
 	-1.0f, -1.0f, 0.0f,
@@ -98,11 +111,24 @@ public:
 	void onContainerParameterChangedInternal(Parameter* p) override;
 	void onControllableFeedbackUpdateInternal(ControllableContainer* cc, Controllable* c) override;
 
+	void childStructureChanged(ControllableContainer* cc) override;
+
 	void initGLInternal() override;
 	void preRenderGLInternal() override;
 	void renderGLInternal() override;
+	void closeGLInternal() override;
 	void reloadShader();
 	void loadFragmentShader(const String& fragmentShader);
+	String buildFragmentShader(ShaderType st, const String& versionLine, const String& code, bool useInputsBlock);
+	void createShaderToyPasses(const String& code, const String& versionLine, bool useInputsBlock);
+	void createISFPasses(const String& fragment);
+	void updatePendingCompile();
+	void clearPendingPasses();
+	StringArray getProgramSources();
+	void updatePassBindings(ShaderPass* pass);
+	void drawPass(ShaderPass* pass, Point<int> size, Point<float> mousePos, double time, float delta);
+	ShaderPass* getPass(const String& name) const;
+	void updateISFSourceMedias();
 	String insertShaderIncludes(const String& fragmentShader);
 	String parseUniforms(const String& fragmentShader);
 
@@ -111,6 +137,7 @@ public:
 	void addUniformControllable(UniformInfo info);
 
 	void run() override;
+	static String getShaderToyPassesCode(var renderPasses);
 
 	var getJSONData(bool includeNonOverriden = false) override;
 	void loadJSONDataItemInternal(var data) override;
@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+	ShaderPass.cpp
+	Created: 20 Oct 2026 11:48:05am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+ShaderPass::ShaderPass(const String& name, bool isOutput) :
+	name(name),
+	isOutput(isOutput),
+	passIndex(0),
+	isFloat(false),
+	isPersistent(true),
+	scale(1),
+	currentTarget(0),
+	width(0),
+	height(0)
+{
+}
+
+ShaderPass::~ShaderPass()
+{
+}
+
+Point<int> ShaderPass::getSize(Point<int> mediaSize) const
+{
+	if (isOutput) return mediaSize;
+
+	auto evaluate = [mediaSize](const String& expression, int defaultValue)
+		{
+			if (expression.isEmpty()) return defaultValue;
+
+			//The result is rounded anyway, so rounding functions that Expression doesn't know can be dropped
+			String e = expression.replace("$WIDTH", String(mediaSize.x)).replace("$HEIGHT", String(mediaSize.y))
+				.replace("floor", "").replace("ceil", "").replace("round", "");
+
+			String error;
+			Expression expr(e, error);
+			if (error.isNotEmpty()) return defaultValue;
+
+			double result = expr.evaluate(Expression::Scope(), error);
+			return error.isEmpty() ? (int)result : defaultValue;
+		};
+
+	int w = evaluate(widthExpression, roundToInt(mediaSize.x * scale));
+	int h = evaluate(heightExpression, roundToInt(mediaSize.y * scale));
+	return Point<int>(jmax(w, 1), jmax(h, 1));
+}
+
+void ShaderPass::beginRender(Point<int> size)
+{
+	if (size.x != width || size.y != height) initTargets(size.x, size.y);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, targets[1 - currentTarget].frameBufferID);
+	glViewport(0, 0, width, height);
+
+	//Persistent passes read their last frame through their own sampler, the full screen draw overwrites the write target
+	if (!isPersistent)
+	{
+		glClearColor(0, 0, 0, 0);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+}
+
+void ShaderPass::endRender()
+{
+	currentTarget = 1 - currentTarget;
+}
+
+void ShaderPass::initTargets(int w, int h)
+{
+	releaseGL();
+
+	for (auto& t : targets)
+	{
+		glGenTextures(1, &t.textureID);
+		glBindTexture(GL_TEXTURE_2D, t.textureID);
+		glTexImage2D(GL_TEXTURE_2D, 0, isFloat ? GL_RGBA32F : GL_RGBA8, w, h, 0, GL_RGBA, isFloat ? GL_FLOAT : GL_UNSIGNED_BYTE, nullptr);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		glGenFramebuffers(1, &t.frameBufferID);
+		glBindFramebuffer(GL_FRAMEBUFFER, t.frameBufferID);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t.textureID, 0);
+		glClearColor(0, 0, 0, 0);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	width = w;
+	height = h;
+	currentTarget = 0;
+}
+
+void ShaderPass::takeTargetsFrom(ShaderPass* other)
+{
+	//Keeps the feedback content when the shader is edited live
+	if (other->isFloat != isFloat) return;
+
+	releaseGL();
+	for (int i = 0; i < 2; i++)
+	{
+		targets[i] = other->targets[i];
+		other->targets[i] = Target();
+	}
+
+	currentTarget = other->currentTarget;
+	width = other->width;
+	height = other->height;
+	other->width = 0;
+	other->height = 0;
+}
+
+void ShaderPass::releaseGL()
+{
+	for (auto& t : targets)
+	{
+		if (t.frameBufferID != 0) glDeleteFramebuffers(1, &t.frameBufferID);
+		if (t.textureID != 0) glDeleteTextures(1, &t.textureID);
+		t = Target();
+	}
+
+	width = 0;
+	height = 0;
+}
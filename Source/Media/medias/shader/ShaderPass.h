@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+	ShaderPass.h
+	Created: 20 Oct 2026 11:48:05am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ShaderPass;
+
+//Uniforms of a pass resolved against its program, rebuilt when the program or the media's parameters change
+struct ShaderPassBindings
+{
+	enum StandardUniform { RESOLUTION_UNIFORM, TIME_UNIFORM, TIME_DELTA_UNIFORM, FRAME_UNIFORM, MOUSE_UNIFORM, PASS_INDEX_UNIFORM, STANDARD_UNIFORM_MAX };
+
+	struct ParameterBinding { Parameter* parameter; int uniformIndex; };
+
+	//Either a source media or the result of another pass of the same media
+	struct TextureBinding { TargetParameter* parameter; ShaderPass* pass; int uniformIndex; };
+
+	bool isDirty = true;
+	int standardIndices[STANDARD_UNIFORM_MAX];
+	Array<ParameterBinding> parameterBindings;
+
+	//Source medias bound in order, when the pass doesn't map its channels explicitly
+	Array<TargetParameter*> sourceBindings;
+	Array<int> sourceUniformIndices;
+	Array<int> channelUniformIndices;
+
+	Array<TextureBinding> textureBindings;
+};
+
+/*
+	One render pass of a ShaderMedia : a ShaderToy buffer (A to D) or image, or one entry of ISF PASSES.
+	Intermediate passes render in their own pair of textures, swapped every frame so a pass reads its own previous frame
+	and the passes after it read its current one, like ShaderToy buffers. The output pass renders in the media's framebuffer.
+*/
+class ShaderPass
+{
+public:
+	ShaderPass(const String& name, bool isOutput);
+	~ShaderPass();
+
+	String name;
+	bool isOutput;
+	int passIndex;
+
+	bool isFloat;
+	bool isPersistent;
+	float scale;
+	String widthExpression; //ISF WIDTH / HEIGHT, with $WIDTH and $HEIGHT
+	String heightExpression;
+
+	//ShaderToy channel sources, "Buffer A" to "Buffer D" or "Source N". Empty means the source medias in order
+	StringArray channels;
+
+	String fragmentSource;
+	std::shared_ptr<OpenGLShaderProgram> program;
+	std::shared_ptr<ShaderUniformTable> uniforms;
+	std::shared_ptr<ShaderProgramCache::CompileJob> compileJob;
+	ShaderPassBindings bindings;
+
+	struct Target
+	{
+		GLuint frameBufferID = 0;
+		GLuint textureID = 0;
+	};
+
+	Target targets[2];
+	int currentTarget;
+	int width;
+	int height;
+
+	Point<int> getSize(Point<int> mediaSize) const;
+
+	//Latest finished render of this pass
+	GLuint getTextureID() const { return targets[currentTarget].textureID; }
+
+	void beginRender(Point<int> size);
+	void endRender();
+
+	void initTargets(int w, int h);
+	void takeTargetsFrom(ShaderPass* other);
+	void releaseGL();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ShaderPass)
+};
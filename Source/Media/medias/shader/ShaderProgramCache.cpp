@@ -0,0 +1,387 @@
+/*
+  ==============================================================================
+
+	ShaderProgramCache.cpp
+	Created: 19 Oct 2026 10:34:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+#include "Engine/MGEngine.h"
+
+using namespace juce::gl;
+
+juce_ImplementSingleton(ShaderProgramCache);
+
+ShaderProgramCache::ShaderProgramCache() :
+	glCapsAreInit(false),
+	parallelCompileIsSupported(false),
+	binariesAreSupported(false)
+{
+}
+
+ShaderProgramCache::~ShaderProgramCache()
+{
+	//Programs have to be deleted with the context current
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr && GlContextHolder::getInstance()->context.isAttached())
+	{
+		GlContextHolder::getInstance()->context.executeOnGLThread([this](OpenGLContext&) { clear(); }, true);
+	}
+	else
+	{
+		clear();
+	}
+}
+
+std::shared_ptr<ShaderProgramCache::CompileJob> ShaderProgramCache::requestProgram(const String& vertexSource, const String& fragmentSource)
+{
+	initGLCaps();
+
+	std::shared_ptr<CompileJob> job = std::make_shared<CompileJob>();
+	job->vertexSource = vertexSource;
+	job->fragmentSource = fragmentSource;
+
+	GenericScopedLock lock(cacheLock);
+
+	if (findProgram(job.get()))
+	{
+		job->state = CompileJob::READY;
+		return job;
+	}
+
+	int64 hash = (vertexSource + fragmentSource).hashCode64();
+	auto it = pendingJobs.find(hash);
+	if (it != pendingJobs.end() && it->second->vertexSource == vertexSource && it->second->fragmentSource == fragmentSource) return it->second;
+
+	startCompile(job.get());
+	if (job->state == CompileJob::COMPILING) pendingJobs[hash] = job;
+	return job;
+}
+
+bool ShaderProgramCache::updateJob(CompileJob* job)
+{
+	if (job->state != CompileJob::COMPILING) return true;
+
+	//Without the parallel compile extension, there's no way to know if the driver is done without waiting for it.
+	//Callers only poll from the frame after the request, most drivers compile in the background in the meantime.
+	if (parallelCompileIsSupported)
+	{
+		GLint isComplete = GL_FALSE;
+		glGetProgramiv(job->programID, GL_COMPLETION_STATUS_KHR, &isComplete);
+		if (isComplete == GL_FALSE) return false;
+	}
+
+	GenericScopedLock lock(cacheLock);
+	finishCompile(job);
+
+	for (auto it = pendingJobs.begin(); it != pendingJobs.end(); it++)
+	{
+		if (it->second.get() != job) continue;
+		pendingJobs.erase(it);
+		break;
+	}
+
+	return true;
+}
+
+void ShaderProgramCache::warmUp(const String& vertexSource, const StringArray& fragmentSources)
+{
+	std::vector<std::shared_ptr<CompileJob>> jobs;
+	for (auto& s : fragmentSources) jobs.push_back(requestProgram(vertexSource, s));
+
+	GenericScopedLock lock(cacheLock);
+	warmUpJobs.swap(jobs);
+	jobs.clear();
+	purgeUnused(); //programs of the previous project that no media uses anymore
+}
+
+void ShaderProgramCache::purgeUnused()
+{
+	GenericScopedLock lock(cacheLock);
+
+	for (auto it = entries.begin(); it != entries.end();)
+	{
+		if (it->second.program.use_count() <= 1) it = entries.erase(it);
+		else it++;
+	}
+
+	//Jobs that every media gave up on, because it was deleted or reloaded another shader in the meantime
+	for (auto it = pendingJobs.begin(); it != pendingJobs.end();)
+	{
+		if (it->second.use_count() <= 1)
+		{
+			releaseJob(it->second.get());
+			it = pendingJobs.erase(it);
+		}
+		else it++;
+	}
+}
+
+void ShaderProgramCache::clear()
+{
+	GenericScopedLock lock(cacheLock);
+	for (auto& j : pendingJobs) releaseJob(j.second.get());
+	pendingJobs.clear();
+	warmUpJobs.clear();
+	entries.clear();
+}
+
+void ShaderProgramCache::initGLCaps()
+{
+	if (glCapsAreInit) return;
+	glCapsAreInit = true;
+
+	if (glMaxShaderCompilerThreadsKHR != nullptr && OpenGLHelpers::isExtensionSupported("GL_KHR_parallel_shader_compile"))
+	{
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF); //let the driver decide
+		parallelCompileIsSupported = true;
+	}
+	else if (glMaxShaderCompilerThreadsARB != nullptr && OpenGLHelpers::isExtensionSupported("GL_ARB_parallel_shader_compile"))
+	{
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		parallelCompileIsSupported = true;
+	}
+
+	if (!parallelCompileIsSupported) LOG("Parallel shader compilation is not supported by this driver, long shaders may still stall the render");
+
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+	binariesAreSupported = numFormats > 0 && glProgramBinary != nullptr && glGetProgramBinary != nullptr;
+
+	if (!binariesAreSupported)
+	{
+		LOG("Shader binaries are not supported by this driver, shaders will be compiled from source");
+		return;
+	}
+
+	//A driver update changes the version string, so old binaries are never looked up again and expire below
+	driverID = String((const char*)glGetString(GL_VENDOR)) + "|" + String((const char*)glGetString(GL_RENDERER)) + "|" + String((const char*)glGetString(GL_VERSION));
+	cacheFolder = File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("MapGyver").getChildFile("ShaderCache");
+	cacheFolder.createDirectory();
+
+	Time expiry = Time::getCurrentTime() - RelativeTime::days(maxBinaryAgeDays);
+	for (auto& f : cacheFolder.findChildFiles(File::findFiles, false, "*.bin"))
+	{
+		if (f.getLastModificationTime() < expiry) f.deleteFile();
+	}
+}
+
+bool ShaderProgramCache::isDiskCacheEnabled()
+{
+	if (RMPSettings::getInstanceWithoutCreating() == nullptr || !RMPSettings::getInstance()->shaderDiskCache->boolValue()) return false;
+	return binariesAreSupported;
+}
+
+bool ShaderProgramCache::findProgram(CompileJob* job)
+{
+	int64 hash = (job->vertexSource + job->fragmentSource).hashCode64();
+
+	auto it = entries.find(hash);
+	if (it != entries.end() && it->second.vertexSource == job->vertexSource && it->second.fragmentSource == job->fragmentSource)
+	{
+		job->program = it->second.program;
+		job->uniforms = it->second.uniforms;
+		return true;
+	}
+
+	job->program = loadBinary(job->vertexSource, job->fragmentSource);
+	if (job->program == nullptr) return false;
+
+	addEntry(job);
+	return true;
+}
+
+void ShaderProgramCache::startCompile(CompileJob* job)
+{
+	//Status queries are what makes the driver wait for the compiler, so none are made here
+	auto createShader = [](GLenum type, const String& source)
+		{
+			GLuint id = glCreateShader(type);
+			const GLchar* code = source.toRawUTF8();
+			glShaderSource(id, 1, &code, nullptr);
+			glCompileShader(id);
+			return id;
+		};
+
+	job->vertexID = createShader(GL_VERTEX_SHADER, job->vertexSource);
+	job->fragmentID = createShader(GL_FRAGMENT_SHADER, job->fragmentSource);
+
+	//Linked straight into the program that will be handed out, nothing is compiled again once it's done
+	job->program = std::make_shared<OpenGLShaderProgram>(GlContextHolder::getInstance()->context);
+	job->programID = job->program->getProgramID();
+	glAttachShader(job->programID, job->vertexID);
+	glAttachShader(job->programID, job->fragmentID);
+	if (binariesAreSupported) glProgramParameteri(job->programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(job->programID);
+}
+
+void ShaderProgramCache::finishCompile(CompileJob* job)
+{
+	auto getShaderError = [](GLuint id) -> String
+		{
+			GLint status = GL_FALSE;
+			glGetShaderiv(id, GL_COMPILE_STATUS, &status);
+			if (status != GL_FALSE) return {};
+
+			GLchar log[4096] = { 0 };
+			GLsizei length = 0;
+			glGetShaderInfoLog(id, sizeof(log), &length, log);
+			return String(log, (size_t)length);
+		};
+
+	GLint linkStatus = GL_FALSE;
+	glGetProgramiv(job->programID, GL_LINK_STATUS, &linkStatus);
+
+	if (linkStatus == GL_FALSE)
+	{
+		String vertexError = getShaderError(job->vertexID);
+		String fragmentError = getShaderError(job->fragmentID);
+
+		if (vertexError.isNotEmpty()) job->error = "Vertex shader compilation failed: " + vertexError;
+		else if (fragmentError.isNotEmpty()) job->error = "Fragment shader compilation failed: " + fragmentError;
+		else
+		{
+			GLchar log[4096] = { 0 };
+			GLsizei length = 0;
+			glGetProgramInfoLog(job->programID, sizeof(log), &length, log);
+			job->error = "Fragment shader link failed: " + String(log, (size_t)length);
+		}
+
+		job->state = CompileJob::FAILED;
+		releaseJob(job);
+		return;
+	}
+
+	if (isDiskCacheEnabled())
+	{
+		MemoryBlock binary;
+		GLenum format = 0;
+		if (getBinary(job->programID, binary, format)) saveBinary(binary, format, job->vertexSource, job->fragmentSource);
+	}
+
+	job->state = CompileJob::READY;
+	releaseJob(job);
+	addEntry(job);
+}
+
+void ShaderProgramCache::releaseJob(CompileJob* job)
+{
+	//The shaders are only needed until the link. The program is kept if it linked, it's deleted with the last media using it.
+	if (job->programID != 0 && job->vertexID != 0) glDetachShader(job->programID, job->vertexID);
+	if (job->programID != 0 && job->fragmentID != 0) glDetachShader(job->programID, job->fragmentID);
+	if (job->vertexID != 0) glDeleteShader(job->vertexID);
+	if (job->fragmentID != 0) glDeleteShader(job->fragmentID);
+	if (job->state != CompileJob::READY) job->program.reset();
+	job->programID = 0;
+	job->vertexID = 0;
+	job->fragmentID = 0;
+}
+
+std::shared_ptr<OpenGLShaderProgram> ShaderProgramCache::createFromBinary(const MemoryBlock& binary, GLenum format)
+{
+	std::shared_ptr<OpenGLShaderProgram> program = std::make_shared<OpenGLShaderProgram>(GlContextHolder::getInstance()->context);
+	glProgramBinary(program->getProgramID(), format, binary.getData(), (GLsizei)binary.getSize());
+
+	GLint status = GL_FALSE;
+	glGetProgramiv(program->getProgramID(), GL_LINK_STATUS, &status);
+	if (status == GL_FALSE) return nullptr;
+
+	return program;
+}
+
+void ShaderProgramCache::addEntry(CompileJob* job)
+{
+	job->uniforms = std::make_shared<ShaderUniformTable>(job->program->getProgramID());
+
+	//On a hash collision, the newest program takes the slot
+	int64 hash = (job->vertexSource + job->fragmentSource).hashCode64();
+	entries[hash] = { job->vertexSource, job->fragmentSource, job->program, job->uniforms };
+}
+
+File ShaderProgramCache::getBinaryFile(const String& vertexSource, const String& fragmentSource) const
+{
+	int64 hash = (driverID + vertexSource + fragmentSource).hashCode64();
+	return cacheFolder.getChildFile(String::toHexString(hash) + ".bin");
+}
+
+std::shared_ptr<OpenGLShaderProgram> ShaderProgramCache::loadBinary(const String& vertexSource, const String& fragmentSource)
+{
+	if (!isDiskCacheEnabled()) return nullptr;
+
+	File f = getBinaryFile(vertexSource, fragmentSource);
+	if (!f.existsAsFile()) return nullptr;
+
+	FileInputStream is(f);
+	if (!is.openedOk()) return nullptr;
+
+	//The sources are stored along the binary, a hash collision or an outdated file is just a miss
+	if (is.readInt() != binaryFileVersion
+		|| is.readString() != driverID
+		|| is.readString() != vertexSource
+		|| is.readString() != fragmentSource)
+	{
+		return nullptr;
+	}
+
+	GLenum format = (GLenum)is.readInt();
+	int size = is.readInt();
+	if (size <= 0 || size > is.getNumBytesRemaining()) return nullptr;
+
+	MemoryBlock binary;
+	is.readIntoMemoryBlock(binary, size);
+
+	std::shared_ptr<OpenGLShaderProgram> program = createFromBinary(binary, format);
+	if (program == nullptr)
+	{
+		//Rejected by the driver, it will be compiled from source and saved again
+		f.deleteFile();
+		return nullptr;
+	}
+
+	f.setLastModificationTime(Time::getCurrentTime());
+	return program;
+}
+
+void ShaderProgramCache::saveBinary(const MemoryBlock& binary, GLenum format, const String& vertexSource, const String& fragmentSource)
+{
+	File f = getBinaryFile(vertexSource, fragmentSource);
+	f.deleteFile();
+
+	FileOutputStream os(f);
+	if (!os.openedOk())
+	{
+		LOGWARNING("Could not write shader binary to " << f.getFullPathName());
+		return;
+	}
+
+	os.writeInt(binaryFileVersion);
+	os.writeString(driverID);
+	os.writeString(vertexSource);
+	os.writeString(fragmentSource);
+	os.writeInt((int)format);
+	os.writeInt((int)binary.getSize());
+	os.write(binary.getData(), binary.getSize());
+}
+
+bool ShaderProgramCache::getBinary(GLuint programID, MemoryBlock& binary, GLenum& format)
+{
+	GLint size = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &size);
+	if (size <= 0) return false;
+
+	binary.setSize((size_t)size);
+	GLsizei written = 0;
+	glGetProgramBinary(programID, size, &written, &format, binary.getData());
+	if (written <= 0) return false;
+
+	binary.setSize((size_t)written);
+	return true;
+}
+
+void ShaderProgramCache::clearDiskCache()
+{
+	File folder = File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("MapGyver").getChildFile("ShaderCache");
+	for (auto& f : folder.findChildFiles(File::findFiles, false, "*.bin")) f.deleteFile();
+}
@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+	ShaderProgramCache.h
+	Created: 19 Oct 2026 10:34:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Linked programs shared by every ShaderMedia, keyed by the hash of their final vertex and fragment sources.
+	Many medias using the same GLSL (like all the crossfade transitions of a sequence) compile it only once.
+	Linked programs are also saved to disk as driver binaries, so the next launches skip the driver compiler.
+	New programs are compiled asynchronously : the request returns a job that the media polls every frame, starting with the next one,
+	and keeps rendering its previous program until the job is done.
+	Must be used from the GL thread.
+*/
+class ShaderProgramCache
+{
+public:
+	juce_DeclareSingleton(ShaderProgramCache, true);
+
+	ShaderProgramCache();
+	~ShaderProgramCache();
+
+	struct Entry
+	{
+		String vertexSource;
+		String fragmentSource;
+		std::shared_ptr<OpenGLShaderProgram> program;
+		std::shared_ptr<ShaderUniformTable> uniforms;
+	};
+
+	struct CompileJob
+	{
+		enum State { COMPILING, READY, FAILED };
+
+		String vertexSource;
+		String fragmentSource;
+		State state = COMPILING;
+
+		//Raw GL objects while the driver compiles, the program is linked in place and handed out once it's done
+		GLuint vertexID = 0;
+		GLuint fragmentID = 0;
+		GLuint programID = 0;
+
+		std::shared_ptr<OpenGLShaderProgram> program;
+		std::shared_ptr<ShaderUniformTable> uniforms;
+		String error;
+	};
+
+	CriticalSection cacheLock;
+	std::map<int64, Entry> entries;
+	std::map<int64, std::shared_ptr<CompileJob>> pendingJobs; //medias asking for a source that is already compiling share the job
+	std::vector<std::shared_ptr<CompileJob>> warmUpJobs; //keep the loaded project's programs alive until its medias ask for them
+
+	bool glCapsAreInit;
+	bool parallelCompileIsSupported;
+
+	//Disk cache, binaries are only valid for the exact driver that produced them
+	bool binariesAreSupported;
+	String driverID;
+	File cacheFolder;
+
+	static const int binaryFileVersion = 1;
+	static const int maxBinaryAgeDays = 60;
+
+	//The job is already finished when the program is in memory or on disk. Failures are not cached.
+	std::shared_ptr<CompileJob> requestProgram(const String& vertexSource, const String& fragmentSource);
+
+	//Loads or starts compiling the programs a project used when it was saved, replacing the previous project's ones
+	void warmUp(const String& vertexSource, const StringArray& fragmentSources);
+
+	//Returns true once the job is finished, never blocks while the driver is still compiling (if it can tell)
+	bool updateJob(CompileJob* job);
+
+	//Deletes the programs that are not used by any media anymore
+	void purgeUnused();
+	void clear();
+
+	void initGLCaps();
+	bool isDiskCacheEnabled();
+	bool findProgram(CompileJob* job);
+	void startCompile(CompileJob* job);
+	void finishCompile(CompileJob* job);
+	void releaseJob(CompileJob* job);
+	std::shared_ptr<OpenGLShaderProgram> createFromBinary(const MemoryBlock& binary, GLenum format);
+	void addEntry(CompileJob* job);
+
+	File getBinaryFile(const String& vertexSource, const String& fragmentSource) const;
+	std::shared_ptr<OpenGLShaderProgram> loadBinary(const String& vertexSource, const String& fragmentSource);
+	void saveBinary(const MemoryBlock& binary, GLenum format, const String& vertexSource, const String& fragmentSource);
+	static bool getBinary(GLuint programID, MemoryBlock& binary, GLenum& format);
+	static void clearDiskCache();
+};
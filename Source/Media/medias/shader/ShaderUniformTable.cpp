@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+	ShaderUniformTable.cpp
+	Created: 20 Oct 2026 10:12:37am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Media/MediaIncludes.h"
+
+using namespace juce::gl;
+
+ShaderUniformTable::ShaderUniformTable(GLuint programID) :
+	hasStandardBlock(false)
+{
+	GLint numUniforms = 0;
+	glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &numUniforms);
+
+	for (int i = 0; i < numUniforms; i++)
+	{
+		GLchar name[256] = { 0 };
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(programID, (GLuint)i, sizeof(name), &length, &size, &type, name);
+
+		Uniform u;
+		u.name = String(name, (size_t)length).upToFirstOccurrenceOf("[", false, false); //arrays are reported as name[0]
+		u.location = glGetUniformLocation(programID, name);
+		if (u.location < 0) continue; //members of a uniform block
+
+		u.type = type;
+		u.numComponents = getNumComponents(type);
+		u.isInt = isIntType(type);
+
+		indices.set(u.name, uniforms.size());
+		uniforms.add(u);
+	}
+
+	GLuint blockIndex = glGetUniformBlockIndex(programID, standardBlockName);
+	if (blockIndex != GL_INVALID_INDEX)
+	{
+		glUniformBlockBinding(programID, blockIndex, standardBlockBinding);
+		hasStandardBlock = true;
+	}
+}
+
+int ShaderUniformTable::indexOf(const String& name) const
+{
+	if (name.isEmpty() || !indices.contains(name)) return -1;
+	return indices[name];
+}
+
+void ShaderUniformTable::setFloats(int index, const GLfloat* values, int count)
+{
+	if (index < 0) return;
+	Uniform& u = uniforms.getReference(index);
+
+	if (u.isInt)
+	{
+		GLint intValues[4] = { 0, 0, 0, 0 };
+		for (int i = 0; i < jmin(count, 4); i++) intValues[i] = (GLint)values[i];
+		setInts(index, intValues, count);
+		return;
+	}
+
+	int n = u.numComponents;
+	GLfloat v[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < jmin(count, n); i++) v[i] = values[i];
+
+	if (u.hasValue && memcmp(u.floatValues, v, sizeof(GLfloat) * n) == 0) return;
+	memcpy(u.floatValues, v, sizeof(v));
+	u.hasValue = true;
+
+	switch (n)
+	{
+	case 1: glUniform1fv(u.location, 1, v); break;
+	case 2: glUniform2fv(u.location, 1, v); break;
+	case 3: glUniform3fv(u.location, 1, v); break;
+	case 4: glUniform4fv(u.location, 1, v); break;
+	default: break; //matrices are not driven by parameters
+	}
+}
+
+void ShaderUniformTable::setInts(int index, const GLint* values, int count)
+{
+	if (index < 0) return;
+	Uniform& u = uniforms.getReference(index);
+
+	if (!u.isInt)
+	{
+		GLfloat floatValues[4] = { 0, 0, 0, 0 };
+		for (int i = 0; i < jmin(count, 4); i++) floatValues[i] = (GLfloat)values[i];
+		setFloats(index, floatValues, count);
+		return;
+	}
+
+	int n = u.numComponents;
+	GLint v[4] = { 0, 0, 0, 0 };
+	for (int i = 0; i < jmin(count, n); i++) v[i] = values[i];
+
+	if (u.hasValue && memcmp(u.intValues, v, sizeof(GLint) * n) == 0) return;
+	memcpy(u.intValues, v, sizeof(v));
+	u.hasValue = true;
+
+	switch (n)
+	{
+	case 1: glUniform1iv(u.location, 1, v); break;
+	case 2: glUniform2iv(u.location, 1, v); break;
+	case 3: glUniform3iv(u.location, 1, v); break;
+	case 4: glUniform4iv(u.location, 1, v); break;
+	default: break;
+	}
+}
+
+void ShaderUniformTable::setFloat(int index, GLfloat v)
+{
+	setFloats(index, &v, 1);
+}
+
+void ShaderUniformTable::setInt(int index, GLint v)
+{
+	setInts(index, &v, 1);
+}
+
+int ShaderUniformTable::getNumComponents(GLenum type)
+{
+	switch (type)
+	{
+	case GL_FLOAT_VEC2: case GL_INT_VEC2: case GL_BOOL_VEC2: return 2;
+	case GL_FLOAT_VEC3: case GL_INT_VEC3: case GL_BOOL_VEC3: return 3;
+	case GL_FLOAT_VEC4: case GL_INT_VEC4: case GL_BOOL_VEC4: return 4;
+	case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4: return 0;
+	default: return 1;
+	}
+}
+
+bool ShaderUniformTable::isIntType(GLenum type)
+{
+	switch (type)
+	{
+	case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+	case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+		return false;
+
+	default:
+		return true; //ints, bools and samplers
+	}
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+	ShaderUniformTable.h
+	Created: 20 Oct 2026 10:12:37am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Active uniforms of a linked program, read once at link time.
+	Setters compare against the last value uploaded to the program and skip the GL call when nothing changed.
+	The table lives with the program, so medias sharing a program also share what has been uploaded to it.
+	Setters must be called with the program in use.
+*/
+class ShaderUniformTable
+{
+public:
+	ShaderUniformTable(GLuint programID);
+	~ShaderUniformTable() {}
+
+	struct Uniform
+	{
+		String name;
+		GLint location = -1;
+		GLenum type = 0;
+		int numComponents = 1;
+		bool isInt = false;
+		bool hasValue = false;
+		GLfloat floatValues[4] = { 0, 0, 0, 0 };
+		GLint intValues[4] = { 0, 0, 0, 0 };
+	};
+
+	//Standard ShaderToy / ISF inputs, std140 layout shared by both block declarations in ShaderMedia
+	struct StandardInputs
+	{
+		GLfloat resolution[3] = { 0, 0, 0 };
+		GLfloat time = 0;
+		GLfloat mouse[4] = { 0, 0, 0, 0 };
+		GLfloat date[4] = { 0, 0, 0, 0 };
+		GLfloat timeDelta = 0;
+		GLfloat frameRate = 0;
+		GLint frame = 0;
+		GLfloat padding = 0;
+	};
+
+	static constexpr const char* standardBlockName = "ShaderInputs";
+	static const GLuint standardBlockBinding = 0;
+
+	Array<Uniform> uniforms;
+	HashMap<String, int> indices;
+	bool hasStandardBlock;
+
+	int indexOf(const String& name) const;
+
+	void setFloats(int index, const GLfloat* values, int count);
+	void setInts(int index, const GLint* values, int count);
+	void setFloat(int index, GLfloat v);
+	void setInt(int index, GLint v);
+
+	static int getNumComponents(GLenum type);
+	static bool isIntType(GLenum type);
+};
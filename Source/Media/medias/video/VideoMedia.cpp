@@ -16,8 +16,14 @@ VideoMedia::VideoMedia(var params) :
 	ImageMedia(getTypeString(), params),
 	controlsCC("Controls"),
 	audioCC("Audio"),
+	frameRate(0),
+	totalFrames(0),
 	updatingPosFromVLC(false),
 	isSeeking(false),
+	decodedTime(-1),
+	lastDecodedFrame(-1),
+	pendingFrame(-1),
+	pendingRequestTime(0),
 	lastTapTempo(0)
 	//Thread("VLC frame checker")
 {
@@ -198,9 +204,16 @@ void VideoMedia::load()
 			}
 		},
 		[this](void* data) {
+			markFrameArrival();
 			shouldRedraw = true;
 			FPSTick();
 
+			if (isRenderingOffline)
+			{
+				decodedTime = vlcPlayer->time() / 1000.0;
+				frameDecoded.signal();
+			}
+
 		});
 
 	state->setValueWithData(IDLE);
@@ -253,6 +266,12 @@ void VideoMedia::restart() {
 void VideoMedia::seek(double time)
 {
 	if (vlcPlayer == nullptr) return;
+	if (isRenderingOffline)
+	{
+		requestFrameExact(time);
+		return;
+	}
+
 	PlayerState st = state->getValueDataAsEnum<PlayerState>();
 	if (st == PLAYING || st == PAUSED)
 	{
@@ -271,6 +290,53 @@ void VideoMedia::seek(double time)
 	}
 }
 
+void VideoMedia::requestFrameExact(double time)
+{
+	pendingFrame = -1;
+	if (vlcPlayer == nullptr || frameRate <= 0) return;
+
+	if (state->getValueDataAsEnum<PlayerState>() == IDLE)
+	{
+		//VLC only decodes once started, keep it paused and step it from here
+		vlcPlayer->play();
+		vlcPlayer->setPause(true);
+		state->setValueWithData(PAUSED);
+		lastDecodedFrame = -1;
+	}
+
+	double targetTime = loop->boolValue() && length->doubleValue() > 0 ? fmod(time, length->doubleValue()) : time;
+	int64 targetFrame = jlimit<int64>(0, jmax<int64>((int64)totalFrames - 1, 0), (int64)floor(targetTime * frameRate + .0001));
+	if (targetFrame == lastDecodedFrame) return;
+
+	frameDecoded.reset();
+	if (targetFrame == lastDecodedFrame + 1) vlcPlayer->nextFrame();
+	else vlcPlayer->setTime((libvlc_time_t)(targetFrame * 1000.0 / frameRate), false); //precise seek, not the keyframe one
+
+	pendingFrame = targetFrame;
+	pendingRequestTime = Time::getMillisecondCounter();
+}
+
+bool VideoMedia::isOfflineFrameReady()
+{
+	if (pendingFrame < 0) return true;
+
+	//the event only tells a frame came, the decoded time tells if it's the requested one
+	const double frameDuration = 1.0 / frameRate;
+	if (frameDecoded.wait(0) && fabs(decodedTime - pendingFrame * frameDuration) < frameDuration * .5)
+	{
+		lastDecodedFrame = pendingFrame;
+		pendingFrame = -1;
+		return true;
+	}
+
+	if (Time::getMillisecondCounter() - pendingRequestTime < (uint32)offlineDecodeTimeout) return false;
+
+	NLOGWARNING(niceName, "Frame " << pendingFrame << " could not be decoded in time, the previous one is kept");
+	lastDecodedFrame = -1;
+	pendingFrame = -1;
+	return true;
+}
+
 void VideoMedia::tapTempo()
 {
 	double now = Time::getMillisecondCounterHiRes();
@@ -325,6 +391,17 @@ void VideoMedia::handleStart()
 	play();
 }
 
+void VideoMedia::setOfflineMode(bool offline)
+{
+	Media::setOfflineMode(offline);
+	lastDecodedFrame = -1;
+	pendingFrame = -1;
+
+	if (vlcPlayer == nullptr) return;
+	vlcPlayer->setMute(offline);
+	if (offline) pause();
+}
+
 
 
 
@@ -56,6 +56,14 @@ public:
 	bool updatingPosFromVLC;
 	bool isSeeking;
 
+	//Offline render, frames are decoded on demand while the player is paused
+	WaitableEvent frameDecoded;
+	std::atomic<double> decodedTime;
+	int64 lastDecodedFrame;
+	int64 pendingFrame; //requested and not decoded yet, -1 if none
+	uint32 pendingRequestTime;
+	static const int offlineDecodeTimeout = 2000;
+
 	double lastTapTempo;
 	Trigger* tapTempoTrigger;
 	IntParameter* beatPerCycle;
@@ -70,6 +78,7 @@ public:
 	void pause();
 	void restart();
 	void seek(double time);
+	void requestFrameExact(double time);
 	void tapTempo();
 
 	virtual void handleEnter(double time, bool play = false) override;
@@ -77,6 +86,8 @@ public:
 	virtual void handleSeek(double time) override;
 	virtual void handleStop() override;
 	virtual void handleStart() override;
+	virtual void setOfflineMode(bool offline) override;
+	virtual bool isOfflineFrameReady() override;
 
 
 	double getMediaLength() override;
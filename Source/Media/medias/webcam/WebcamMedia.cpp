@@ -54,6 +54,7 @@ void WebcamMedia::updateDevice()
 }
 
 void WebcamMedia::WebcamImageReceived(const Image& camImage) {
+	markFrameArrival();
 	initImage(camImage);
 	shouldRedraw = true;
 	FPSTick();
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+	AnalysisFrameGrabber.cpp
+	Created: 21 Oct 2026 10:48:05am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+using namespace juce::gl;
+
+void AnalysisFrameGrabber::Frame::swapWith(Frame& other)
+{
+	data.swapWith(other.data);
+	std::swap(size, other.size);
+	std::swap(width, other.width);
+	std::swap(height, other.height);
+	std::swap(frameNumber, other.frameNumber);
+	std::swap(time, other.time);
+}
+
+AnalysisFrameGrabber::AnalysisFrameGrabber() :
+	analysisWidth(160),
+	reader(3, GL_RGBA),
+	lastSourceFrameTime(-1),
+	frameNumber(0),
+	glIsInit(false),
+	hasNewFrame(false)
+{
+	GlContextHolder::getInstance()->registerOpenGlRenderer(this, 2); //after the medias
+}
+
+AnalysisFrameGrabber::~AnalysisFrameGrabber()
+{
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GlContextHolder::getInstance()->unregisterOpenGlRenderer(this);
+		if (glIsInit) GlContextHolder::getInstance()->context.executeOnGLThread([this](OpenGLContext&) { releaseGL(); }, true);
+	}
+}
+
+void AnalysisFrameGrabber::setSource(Media* m)
+{
+	GenericScopedLock lock(sourceLock);
+	source = m;
+	lastSourceFrameTime = -1;
+}
+
+bool AnalysisFrameGrabber::getLatestFrame(Frame& frame)
+{
+	GenericScopedLock lock(frameLock);
+	if (!hasNewFrame) return false;
+
+	frame.swapWith(latestFrame);
+	hasNewFrame = false;
+	return true;
+}
+
+void AnalysisFrameGrabber::newOpenGLContextCreated()
+{
+}
+
+void AnalysisFrameGrabber::renderOpenGL()
+{
+	collectFrames();
+
+	GenericScopedLock lock(sourceLock);
+
+	Media* m = dynamic_cast<Media*>(source.get());
+	if (m == nullptr || !m->frameBuffer.isValid()) return;
+
+	//Live inputs stamp their uploads, other medias are only known to have rendered
+	double sourceFrameTime = m->frameTiming.uploadTime >= 0 ? m->frameTiming.uploadTime : m->timeAtLastRender;
+	if (sourceFrameTime == lastSourceFrameTime) return;
+	if (reader.isFull()) return; //the analysis is behind, it will get a newer frame
+
+	lastSourceFrameTime = sourceFrameTime;
+	glIsInit = true;
+
+	int sourceWidth = m->frameBuffer.getWidth();
+	int sourceHeight = m->frameBuffer.getHeight();
+	int w = jlimit(1, sourceWidth, analysisWidth.load());
+	int h = jmax(1, roundToInt(w * (float)sourceHeight / sourceWidth));
+
+	if (downscaleFBO.getWidth() != w || downscaleFBO.getHeight() != h)
+	{
+		downscaleFBO.release();
+		downscaleFBO.initialise(GlContextHolder::getInstance()->context, w, h);
+	}
+
+	GLint previousFrameBuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFrameBuffer);
+
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, m->frameBuffer.getFrameBufferID());
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, downscaleFBO.getFrameBufferID());
+	glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, 0, 0, w, h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, downscaleFBO.getFrameBufferID());
+	reader.queueRead(w, h, frameNumber++, sourceFrameTime);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, previousFrameBuffer);
+}
+
+void AnalysisFrameGrabber::openGLContextClosing()
+{
+	releaseGL();
+}
+
+void AnalysisFrameGrabber::collectFrames()
+{
+	reader.collect([this](const uint8* data, const AsyncGLReader::Slot& slot)
+		{
+			size_t size = (size_t)slot.width * (size_t)slot.height * 4;
+			if (backFrame.size != size) backFrame.data.allocate(size, false);
+			backFrame.size = size;
+			backFrame.width = slot.width;
+			backFrame.height = slot.height;
+			backFrame.frameNumber = slot.frameNumber;
+			backFrame.time = slot.time;
+			memcpy(backFrame.data, data, size);
+
+			GenericScopedLock lock(frameLock);
+			latestFrame.swapWith(backFrame);
+			hasNewFrame = true;
+		});
+}
+
+void AnalysisFrameGrabber::releaseGL()
+{
+	reader.release();
+	downscaleFBO.release();
+	lastSourceFrameTime = -1;
+	glIsInit = false;
+}
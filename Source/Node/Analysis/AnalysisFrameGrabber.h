@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+	AnalysisFrameGrabber.h
+	Created: 21 Oct 2026 10:48:05am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Brings a media's frames to the CPU for the analysis nodes.
+	On the GL thread, each new frame of the source is blitted down to the analysis size and read back asynchronously.
+	Finished reads are swapped in as the latest frame, the node thread swaps it out when it processes : nothing is copied twice and nobody waits.
+*/
+class AnalysisFrameGrabber :
+	public OpenGLRenderer
+{
+public:
+	AnalysisFrameGrabber();
+	~AnalysisFrameGrabber();
+
+	struct Frame
+	{
+		HeapBlock<uint8> data; //RGBA, bottom row first as read from GL
+		size_t size = 0;
+		int width = 0;
+		int height = 0;
+		int64 frameNumber = 0;
+		double time = 0;
+
+		void swapWith(Frame& other);
+	};
+
+	//Source, set from the message thread, read on the GL thread
+	CriticalSection sourceLock;
+	WeakReference<ControllableContainer> source;
+	std::atomic<int> analysisWidth;
+
+	//GL side
+	AsyncGLReader reader;
+	OpenGLFrameBuffer downscaleFBO;
+	double lastSourceFrameTime;
+	int64 frameNumber;
+	bool glIsInit;
+	Frame backFrame;
+
+	//Shared
+	SpinLock frameLock;
+	Frame latestFrame;
+	bool hasNewFrame;
+
+	void setSource(Media* m);
+	void setAnalysisWidth(int width) { analysisWidth = width; }
+
+	//Node thread, swaps the latest frame with the given one. Returns false if no frame arrived since the last call.
+	bool getLatestFrame(Frame& frame);
+
+	void newOpenGLContextCreated() override;
+	void renderOpenGL() override;
+	void openGLContextClosing() override;
+
+	void collectFrames();
+	void releaseGL();
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisFrameGrabber)
+};
@@ -0,0 +1,369 @@
+/*
+  ==============================================================================
+
+	ImageKernels.cpp
+	Created: 21 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+#if JUCE_INTEL && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define IMAGEKERNELS_SSE2 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define IMAGEKERNELS_AVX2 1
+#endif
+#elif JUCE_ARM && (defined(__ARM_NEON__) || defined(__ARM_NEON) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define IMAGEKERNELS_NEON 1
+#endif
+
+//BT.709 weights in 1/256th, they sum to 256 so white stays 255
+#define LUMA_R 54
+#define LUMA_G 183
+#define LUMA_B 19
+
+//Pixels per block of weightedSums. A 32 bit x lane gets at most 4 * 255 * 4095 per 16 pixels, about 1.1e9 for a whole block.
+#define IMAGEKERNELS_WEIGHTED_BLOCK 4096
+
+void ImageKernels::lumaFromRGBA(const uint8* rgba, uint8* luma, int numPixels)
+{
+	int i = 0;
+
+#if IMAGEKERNELS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i weights = _mm_setr_epi16(LUMA_R, LUMA_G, LUMA_B, 0, LUMA_R, LUMA_G, LUMA_B, 0);
+
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		__m128i sums[4];
+		for (int k = 0; k < 4; k++)
+		{
+			//4 pixels, r*wr+g*wg and b*wb+a*0 for each, then the two halves are added
+			__m128i v = _mm_loadu_si128((const __m128i*)(rgba + (i + k * 4) * 4));
+			__m128 lo = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpacklo_epi8(v, zero), weights));
+			__m128 hi = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpackhi_epi8(v, zero), weights));
+			__m128i rg = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+			__m128i ba = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+			sums[k] = _mm_srli_epi32(_mm_add_epi32(rg, ba), 8);
+		}
+
+		__m128i words0 = _mm_packs_epi32(sums[0], sums[1]);
+		__m128i words1 = _mm_packs_epi32(sums[2], sums[3]);
+		_mm_storeu_si128((__m128i*)(luma + i), _mm_packus_epi16(words0, words1));
+	}
+#elif IMAGEKERNELS_NEON
+	const uint8x8_t wr = vdup_n_u8(LUMA_R);
+	const uint8x8_t wg = vdup_n_u8(LUMA_G);
+	const uint8x8_t wb = vdup_n_u8(LUMA_B);
+
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		uint8x16x4_t px = vld4q_u8(rgba + i * 4);
+
+		uint16x8_t lo = vmull_u8(vget_low_u8(px.val[0]), wr);
+		lo = vmlal_u8(lo, vget_low_u8(px.val[1]), wg);
+		lo = vmlal_u8(lo, vget_low_u8(px.val[2]), wb);
+
+		uint16x8_t hi = vmull_u8(vget_high_u8(px.val[0]), wr);
+		hi = vmlal_u8(hi, vget_high_u8(px.val[1]), wg);
+		hi = vmlal_u8(hi, vget_high_u8(px.val[2]), wb);
+
+		vst1q_u8(luma + i, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+	}
+#endif
+
+	for (; i < numPixels; i++)
+	{
+		const uint8* p = rgba + i * 4;
+		luma[i] = (uint8)((p[0] * LUMA_R + p[1] * LUMA_G + p[2] * LUMA_B) >> 8);
+	}
+}
+
+void ImageKernels::threshold(const uint8* src, uint8* dst, int numPixels, uint8 level)
+{
+	int i = 0;
+
+	//max(v, level) == v is v >= level for unsigned bytes
+#if IMAGEKERNELS_AVX2
+	const __m256i t256 = _mm256_set1_epi8((char)level);
+	for (; i + 32 <= numPixels; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_cmpeq_epi8(_mm256_max_epu8(v, t256), v));
+	}
+#endif
+
+#if IMAGEKERNELS_SSE2
+	const __m128i t = _mm_set1_epi8((char)level);
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_cmpeq_epi8(_mm_max_epu8(v, t), v));
+	}
+#elif IMAGEKERNELS_NEON
+	const uint8x16_t t = vdupq_n_u8(level);
+	for (; i + 16 <= numPixels; i += 16) vst1q_u8(dst + i, vcgeq_u8(vld1q_u8(src + i), t));
+#endif
+
+	for (; i < numPixels; i++) dst[i] = src[i] >= level ? 255 : 0;
+}
+
+void ImageKernels::thresholdToZero(const uint8* src, uint8* dst, int numPixels, uint8 level)
+{
+	int i = 0;
+
+#if IMAGEKERNELS_AVX2
+	const __m256i t256 = _mm256_set1_epi8((char)level);
+	for (; i + 32 <= numPixels; i += 32)
+	{
+		__m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(v, t256), v), v));
+	}
+#endif
+
+#if IMAGEKERNELS_SSE2
+	const __m128i t = _mm_set1_epi8((char)level);
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(v, t), v), v));
+	}
+#elif IMAGEKERNELS_NEON
+	const uint8x16_t t = vdupq_n_u8(level);
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		uint8x16_t v = vld1q_u8(src + i);
+		vst1q_u8(dst + i, vandq_u8(vcgeq_u8(v, t), v));
+	}
+#endif
+
+	for (; i < numPixels; i++) dst[i] = src[i] >= level ? src[i] : 0;
+}
+
+void ImageKernels::absDiff(const uint8* a, const uint8* b, uint8* dst, int numPixels)
+{
+	int i = 0;
+
+	//saturated subtractions, one of the two is always 0
+#if IMAGEKERNELS_AVX2
+	for (; i + 32 <= numPixels; i += 32)
+	{
+		__m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va)));
+	}
+#endif
+
+#if IMAGEKERNELS_SSE2
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		__m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+		__m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va)));
+	}
+#elif IMAGEKERNELS_NEON
+	for (; i + 16 <= numPixels; i += 16) vst1q_u8(dst + i, vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i)));
+#endif
+
+	for (; i < numPixels; i++) dst[i] = (uint8)std::abs((int)a[i] - (int)b[i]);
+}
+
+uint64 ImageKernels::sum(const uint8* src, int numPixels)
+{
+	int i = 0;
+	uint64 result = 0;
+
+#if IMAGEKERNELS_AVX2
+	{
+		const __m256i zero = _mm256_setzero_si256();
+		__m256i acc = _mm256_setzero_si256();
+		for (; i + 32 <= numPixels; i += 32) acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_loadu_si256((const __m256i*)(src + i)), zero));
+
+		alignas(32) uint64 lanes[4];
+		_mm256_store_si256((__m256i*)lanes, acc);
+		result += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	}
+#endif
+
+#if IMAGEKERNELS_SSE2
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i acc = _mm_setzero_si128();
+		for (; i + 16 <= numPixels; i += 16) acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_loadu_si128((const __m128i*)(src + i)), zero));
+
+		alignas(16) uint64 lanes[2];
+		_mm_store_si128((__m128i*)lanes, acc);
+		result += lanes[0] + lanes[1];
+	}
+#elif IMAGEKERNELS_NEON
+	{
+		uint64x2_t acc = vdupq_n_u64(0);
+		for (; i + 16 <= numPixels; i += 16) acc = vpadalq_u32(acc, vpaddlq_u16(vpaddlq_u8(vld1q_u8(src + i))));
+		result += vgetq_lane_u64(acc, 0) + vgetq_lane_u64(acc, 1);
+	}
+#endif
+
+	for (; i < numPixels; i++) result += src[i];
+	return result;
+}
+
+void ImageKernels::weightedSums(const uint8* src, int numPixels, uint64& sum, uint64& xSum)
+{
+	int i = 0;
+	sum = 0;
+	xSum = 0;
+
+	//x indices restart at each block and the 32 bit lanes are spilled into the 64 bit sums at its end,
+	//so neither the 16 bit indices nor the lanes overflow, whatever the row length : xSum += blockStart * blockSum + lanes
+#if IMAGEKERNELS_AVX2
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m256i step = _mm256_set1_epi16(16);
+		const __m256i firstIndices = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+		while (i + 16 <= numPixels)
+		{
+			int blockStart = i;
+			int blockEnd = jmin(numPixels, i + IMAGEKERNELS_WEIGHTED_BLOCK);
+			__m256i indices = firstIndices;
+			__m256i accX = _mm256_setzero_si256();
+			__m128i accSum = _mm_setzero_si128();
+
+			for (; i + 16 <= blockEnd; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				accX = _mm256_add_epi32(accX, _mm256_madd_epi16(_mm256_cvtepu8_epi16(v), indices));
+				accSum = _mm_add_epi64(accSum, _mm_sad_epu8(v, zero));
+				indices = _mm256_add_epi16(indices, step);
+			}
+
+			alignas(32) uint32 xLanes[8];
+			_mm256_store_si256((__m256i*)xLanes, accX);
+			alignas(16) uint64 sumLanes[2];
+			_mm_store_si128((__m128i*)sumLanes, accSum);
+
+			uint64 blockSum = sumLanes[0] + sumLanes[1];
+			sum += blockSum;
+			xSum += (uint64)blockStart * blockSum;
+			for (auto& l : xLanes) xSum += l;
+		}
+	}
+#elif IMAGEKERNELS_SSE2
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i step = _mm_set1_epi16(16);
+
+		while (i + 16 <= numPixels)
+		{
+			int blockStart = i;
+			int blockEnd = jmin(numPixels, i + IMAGEKERNELS_WEIGHTED_BLOCK);
+			__m128i indicesLo = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+			__m128i indicesHi = _mm_setr_epi16(8, 9, 10, 11, 12, 13, 14, 15);
+			__m128i accX = _mm_setzero_si128();
+			__m128i accSum = _mm_setzero_si128();
+
+			for (; i + 16 <= blockEnd; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				accX = _mm_add_epi32(accX, _mm_madd_epi16(_mm_unpacklo_epi8(v, zero), indicesLo));
+				accX = _mm_add_epi32(accX, _mm_madd_epi16(_mm_unpackhi_epi8(v, zero), indicesHi));
+				accSum = _mm_add_epi64(accSum, _mm_sad_epu8(v, zero));
+				indicesLo = _mm_add_epi16(indicesLo, step);
+				indicesHi = _mm_add_epi16(indicesHi, step);
+			}
+
+			alignas(16) uint32 xLanes[4];
+			_mm_store_si128((__m128i*)xLanes, accX);
+			alignas(16) uint64 sumLanes[2];
+			_mm_store_si128((__m128i*)sumLanes, accSum);
+
+			uint64 blockSum = sumLanes[0] + sumLanes[1];
+			sum += blockSum;
+			xSum += (uint64)blockStart * blockSum;
+			for (auto& l : xLanes) xSum += l;
+		}
+	}
+#elif IMAGEKERNELS_NEON
+	{
+		static const uint16 firstIndices[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+		const uint16x8_t step = vdupq_n_u16(16);
+
+		while (i + 16 <= numPixels)
+		{
+			int blockStart = i;
+			int blockEnd = jmin(numPixels, i + IMAGEKERNELS_WEIGHTED_BLOCK);
+			uint16x8_t indicesLo = vld1q_u16(firstIndices);
+			uint16x8_t indicesHi = vld1q_u16(firstIndices + 8);
+			uint32x4_t accX = vdupq_n_u32(0);
+			uint64x2_t accSum = vdupq_n_u64(0);
+
+			for (; i + 16 <= blockEnd; i += 16)
+			{
+				uint8x16_t v = vld1q_u8(src + i);
+				uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+				uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+				accX = vmlal_u16(accX, vget_low_u16(lo), vget_low_u16(indicesLo));
+				accX = vmlal_u16(accX, vget_high_u16(lo), vget_high_u16(indicesLo));
+				accX = vmlal_u16(accX, vget_low_u16(hi), vget_low_u16(indicesHi));
+				accX = vmlal_u16(accX, vget_high_u16(hi), vget_high_u16(indicesHi));
+				accSum = vpadalq_u32(accSum, vpaddlq_u16(vpaddlq_u8(v)));
+				indicesLo = vaddq_u16(indicesLo, step);
+				indicesHi = vaddq_u16(indicesHi, step);
+			}
+
+			uint64 blockSum = vgetq_lane_u64(accSum, 0) + vgetq_lane_u64(accSum, 1);
+			sum += blockSum;
+			xSum += (uint64)blockStart * blockSum;
+			xSum += (uint64)vgetq_lane_u32(accX, 0) + vgetq_lane_u32(accX, 1) + vgetq_lane_u32(accX, 2) + vgetq_lane_u32(accX, 3);
+		}
+	}
+#endif
+
+	for (; i < numPixels; i++)
+	{
+		sum += src[i];
+		xSum += (uint64)src[i] * (uint64)i;
+	}
+}
+
+int ImageKernels::skipValue(const uint8* src, int start, int numPixels, uint8 value)
+{
+	int i = start;
+
+	//skip whole blocks, the scalar loop then finds the exact index in the block that broke
+#if IMAGEKERNELS_AVX2
+	const __m256i t256 = _mm256_set1_epi8((char)value);
+	for (; i + 32 <= numPixels; i += 32)
+	{
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(src + i)), t256)) != -1) break;
+	}
+#endif
+
+#if IMAGEKERNELS_SSE2
+	const __m128i t = _mm_set1_epi8((char)value);
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(src + i)), t)) != 0xFFFF) break;
+	}
+#elif IMAGEKERNELS_NEON
+	const uint8x16_t t = vdupq_n_u8(value);
+	for (; i + 16 <= numPixels; i += 16)
+	{
+		uint64x2_t eq = vreinterpretq_u64_u8(vceqq_u8(vld1q_u8(src + i), t));
+		if ((vgetq_lane_u64(eq, 0) & vgetq_lane_u64(eq, 1)) != ~(uint64)0) break;
+	}
+#endif
+
+	for (; i < numPixels; i++) if (src[i] != value) return i;
+	return numPixels;
+}
+
+#undef LUMA_R
+#undef LUMA_G
+#undef LUMA_B
+#undef IMAGEKERNELS_WEIGHTED_BLOCK
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+	ImageKernels.h
+	Created: 21 Oct 2026 10:12:40am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	8 bit image kernels used by the analysis nodes, on contiguous spans of pixels.
+	Each one has SSE2, AVX2 and NEON paths picked at compile time, with a scalar fallback and tail.
+*/
+class ImageKernels
+{
+public:
+	//BT.709 luma of RGBA pixels
+	static void lumaFromRGBA(const uint8* rgba, uint8* luma, int numPixels);
+
+	//255 where src >= level, 0 elsewhere
+	static void threshold(const uint8* src, uint8* dst, int numPixels, uint8 level);
+
+	//src where src >= level, 0 elsewhere
+	static void thresholdToZero(const uint8* src, uint8* dst, int numPixels, uint8 level);
+
+	static void absDiff(const uint8* a, const uint8* b, uint8* dst, int numPixels);
+
+	static uint64 sum(const uint8* src, int numPixels);
+
+	//sum and sum of x * src[x], for moments. Any numPixels, the SIMD paths work in blocks of 4096 pixels.
+	static void weightedSums(const uint8* src, int numPixels, uint64& sum, uint64& xSum);
+
+	//First index from start where src differs from value, numPixels if there is none
+	static int skipValue(const uint8* src, int start, int numPixels, uint8 value);
+};
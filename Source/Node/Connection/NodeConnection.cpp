@@ -17,6 +17,7 @@ NodeConnection::NodeConnection(NodeManager* nodeManager, NodeConnectionSlot* sou
 	dest(nullptr),
 	hasSentInPrevLoop(false),
 	hasSentInThisLoop(false),
+	destIndex(-1),
 	connectionType(UNKNOWN),
 	connectionNotifier(5)
 {
@@ -108,6 +109,11 @@ void NodeConnection::inspectableDestroyed(Inspectable* i)
 	else if (dest != nullptr && i == dest->node) setSource(nullptr);
 }
 
+void NodeConnection::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == enabled && dest != nullptr && dest->node != nullptr) dest->node->notifyGraphChanged();
+}
+
 var NodeConnection::getJSONData(bool includeNonOverriden)
 {
 	var data = BaseItem::getJSONData(includeNonOverriden);
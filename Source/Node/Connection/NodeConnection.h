@@ -31,6 +31,7 @@ public:
 
 	bool hasSentInPrevLoop;
 	bool hasSentInThisLoop;
+	int destIndex; //index of the value this connection writes in its dest slot, -1 until the process thread has assigned it
 
 	virtual void setSource(NodeConnectionSlot* node);
 	virtual void setDest(NodeConnectionSlot* node);
@@ -38,6 +39,7 @@ public:
 	virtual void handleNodesUpdated();
 
 	void inspectableDestroyed(Inspectable*) override;
+	void onContainerParameterChangedInternal(Parameter* p) override;
 
 	var getJSONData(bool includeNonOverriden = false) override;
 	void loadJSONDataItemInternal(var data) override;
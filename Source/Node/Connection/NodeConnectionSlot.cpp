@@ -15,7 +15,8 @@ NodeConnectionSlot::NodeConnectionSlot(Node* node, bool isInput, String name, No
 	processOnReceive(true),
 	name(name),
 	type(type),
-	node(node)
+	node(node),
+	valuesAreDirty(true)
 {
 
 }
@@ -31,6 +32,7 @@ void NodeConnectionSlot::addConnection(NodeConnection* c)
 	if (connections.contains(c)) return;
 
 	connections.add(c);
+	valuesAreDirty = true;
 	if (isInput) c->setDest(this);
 	else c->setSource(this);
 
@@ -43,12 +45,35 @@ void NodeConnectionSlot::removeConnection(NodeConnection* c)
 	if (!connections.contains(c)) return;
 
 	connections.removeAllInstancesOf(c);
-	if (isInput) c->setDest(nullptr);
+	valuesAreDirty = true;
+	if (isInput)
+	{
+		c->destIndex = -1;
+		c->setDest(nullptr);
+	}
 	else c->setSource(nullptr);
 
 	slotListeners.call(&SlotListener::connectionRemoved, this, c);
 }
 
+void NodeConnectionSlot::clearValues()
+{
+	if (valuesAreDirty && isInput)
+	{
+		valuesAreDirty = false;
+		values.resize(connections.size());
+		for (int i = 0; i < connections.size(); i++) connections[i]->destIndex = i;
+	}
+
+	for (auto& v : values) v.hasValue = false;
+}
+
+const NodeConnectionSlot::PortValue* NodeConnectionSlot::getFirstValue() const
+{
+	for (auto& v : values) if (v.hasValue) return &v;
+	return nullptr;
+}
+
 bool NodeConnectionSlot::isConnectedTo(NodeConnectionSlot* s)
 {
 	for (auto& c : connections)
@@ -30,6 +30,24 @@ public:
 	WeakReference<Node> node;
 	Array<NodeConnection*> connections;
 
+	//Value received from one connection, typed so sending never boxes
+	struct PortValue
+	{
+		bool hasValue = false;
+		double number = 0;
+		Colour color;
+		String string;
+		OpenGLFrameBuffer* buffer = nullptr;
+	};
+
+	//Input slots only, one per connection, indexed by the connection's destIndex.
+	//Only resized by the process thread when the connections have changed, so the loop never allocates.
+	Array<PortValue> values;
+	std::atomic<bool> valuesAreDirty;
+
+	void clearValues();
+	const PortValue* getFirstValue() const;
+
 	void addConnection(NodeConnection* c);
 	void removeConnection(NodeConnection * c);
 
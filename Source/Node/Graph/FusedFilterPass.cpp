@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+	FusedFilterPass.cpp
+	Created: 20 Oct 2026 6:32:09pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+using namespace juce::gl;
+
+FusedFilterPass::FusedFilterPass(const Array<GLFilterNode*>& chain, const String& fragmentCode) :
+	chain(chain)
+{
+	filterProgram.request(fragmentCode);
+}
+
+bool FusedFilterPass::render(const Array<GLuint>& inputTextures, const Array<Point<int>>& inputSizes, Point<int> size)
+{
+	if (filterProgram.update(chain.getLast()->niceName))
+	{
+		ShaderUniformTable* table = filterProgram.uniforms.get();
+		samplerIndices.clearQuick();
+		for (int i = 0; i < chain.size(); i++)
+		{
+			String prefix = getPrefix(i);
+			chain[i]->initUniforms(table, prefix);
+			for (int j = 1; j <= getNumExtraInputs(chain[i]); j++) samplerIndices.add(table->indexOf(prefix + "input" + String(j)));
+		}
+	}
+
+	GLuint inputTexture = inputTextures.isEmpty() ? 0 : inputTextures[0];
+	Point<int> inputSize = inputSizes.isEmpty() ? size : inputSizes[0];
+	if (!filterProgram.use(inputTexture, inputSize, size)) return false;
+
+	ShaderUniformTable* table = filterProgram.uniforms.get();
+	for (int i = 0; i < samplerIndices.size(); i++)
+	{
+		glActiveTexture(GL_TEXTURE1 + i);
+		glBindTexture(GL_TEXTURE_2D, i + 1 < inputTextures.size() ? inputTextures[i + 1] : 0);
+		table->setInt(samplerIndices[i], i + 1);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	for (auto& n : chain) n->setUniforms(table);
+
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	return true;
+}
+
+int64 FusedFilterPass::getStructureHash(const Array<GLFilterNode*>& chain)
+{
+	String structure;
+	for (auto& n : chain) structure += n->getTypeString() + ">";
+	return structure.hashCode64();
+}
+
+String FusedFilterPass::generateCode(const Array<GLFilterNode*>& chain)
+{
+	String code;
+	String mainCode = "void main() {\n\tvec4 c = texture(inputTexture, uv);\n";
+
+	for (int i = 0; i < chain.size(); i++)
+	{
+		String prefix = getPrefix(i);
+		code += chain[i]->getPointwiseCode().replace("$", prefix) + "\n";
+		mainCode += "\tc = " + prefix + "apply(c);\n";
+	}
+
+	return code + mainCode + "\tfragColor = c;\n}\n";
+}
+
+String FusedFilterPass::getPrefix(int chainIndex)
+{
+	return "f" + String(chainIndex) + "_";
+}
+
+int FusedFilterPass::getNumExtraInputs(GLFilterNode* n)
+{
+	int result = 0;
+	for (auto& s : n->inSlots) if (s->type == NODE_BUFFER) result++;
+	return jmax(result - 1, 0);
+}
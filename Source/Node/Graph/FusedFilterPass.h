@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+	FusedFilterPass.h
+	Created: 20 Oct 2026 6:32:09pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class GLFilterNode;
+
+/*
+	A chain of pointwise filters rendered in one pass : each node's function is applied in order on the input color,
+	so the chain costs one read and one write of the buffer instead of one per node.
+	Inputs are the chain's input first, then the extra inputs of each node in chain order.
+*/
+class FusedFilterPass
+{
+public:
+	FusedFilterPass(const Array<GLFilterNode*>& chain, const String& fragmentCode);
+	~FusedFilterPass() {}
+
+	Array<GLFilterNode*> chain;
+	NodeFilterProgram filterProgram;
+	Array<int> samplerIndices; //extra input samplers, in input order
+
+	bool render(const Array<GLuint>& inputTextures, const Array<Point<int>>& inputSizes, Point<int> size);
+
+	//Pointwise code only depends on the node type, so chains with the same types share the same shader
+	static int64 getStructureHash(const Array<GLFilterNode*>& chain);
+	static String generateCode(const Array<GLFilterNode*>& chain);
+	static String getPrefix(int chainIndex);
+	static int getNumExtraInputs(GLFilterNode* n);
+};
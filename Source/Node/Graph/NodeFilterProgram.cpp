@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+	NodeFilterProgram.cpp
+	Created: 20 Oct 2026 6:15:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+using namespace juce::gl;
+
+NodeFilterProgram::NodeFilterProgram() :
+	inputTextureIndex(-1),
+	inputSizeIndex(-1),
+	outputSizeIndex(-1),
+	timeIndex(-1),
+	jobIsNew(false)
+{
+}
+
+void NodeFilterProgram::request(const String& fragmentCode)
+{
+	compileJob = ShaderProgramCache::getInstance()->requestProgram(getVertexShaderCode(), getFragmentHeader() + fragmentCode);
+	jobIsNew = compileJob->state == ShaderProgramCache::CompileJob::COMPILING;
+}
+
+bool NodeFilterProgram::update(const String& logName)
+{
+	if (compileJob == nullptr) return false;
+	if (jobIsNew)
+	{
+		jobIsNew = false;
+		return false;
+	}
+
+	ShaderProgramCache* cache = ShaderProgramCache::getInstance();
+	if (!cache->updateJob(compileJob.get())) return false;
+
+	bool isReady = compileJob->state == ShaderProgramCache::CompileJob::READY;
+	if (isReady)
+	{
+		program = compileJob->program;
+		uniforms = compileJob->uniforms;
+
+		inputTextureIndex = uniforms->indexOf("inputTexture");
+		inputSizeIndex = uniforms->indexOf("inputSize");
+		outputSizeIndex = uniforms->indexOf("outputSize");
+		timeIndex = uniforms->indexOf("time");
+	}
+	else
+	{
+		NLOGERROR(logName, "Filter shader failed : " << compileJob->error);
+	}
+
+	compileJob.reset();
+	cache->purgeUnused();
+	return isReady;
+}
+
+bool NodeFilterProgram::use(GLuint inputTexture, Point<int> inputSize, Point<int> size)
+{
+	if (program == nullptr) return false;
+
+	program->use();
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, inputTexture);
+	uniforms->setInt(inputTextureIndex, 0);
+
+	GLfloat inSize[2] = { (GLfloat)inputSize.x, (GLfloat)inputSize.y };
+	GLfloat outSize[2] = { (GLfloat)size.x, (GLfloat)size.y };
+	uniforms->setFloats(inputSizeIndex, inSize, 2);
+	uniforms->setFloats(outputSizeIndex, outSize, 2);
+	uniforms->setFloat(timeIndex, (GLfloat)(Time::getMillisecondCounterHiRes() / 1000.0));
+
+	return true;
+}
+
+void NodeFilterProgram::reset()
+{
+	//The cache owns the programs, it deletes them once nobody uses them
+	compileJob.reset();
+	program.reset();
+	uniforms.reset();
+}
+
+String NodeFilterProgram::getVertexShaderCode()
+{
+	return R"(
+		#version 330
+		out vec2 uv;
+		void main() {
+			vec2 p = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+			uv = p;
+			gl_Position = vec4(p * 2.0 - 1.0, 0.0, 1.0);
+		}
+	)";
+}
+
+String NodeFilterProgram::getFragmentHeader()
+{
+	return R"(
+		#version 330
+		uniform sampler2D inputTexture;
+		uniform vec2 inputSize;
+		uniform vec2 outputSize;
+		uniform float time;
+		in vec2 uv;
+		out vec4 fragColor;
+	)";
+}
@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+	NodeFilterProgram.h
+	Created: 20 Oct 2026 6:15:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Program of a filter pass, requested from the ShaderProgramCache and polled every frame until it is linked.
+	Sets the inputs every filter shader gets : inputTexture, inputSize, outputSize and time.
+*/
+class NodeFilterProgram
+{
+public:
+	NodeFilterProgram();
+	~NodeFilterProgram() {}
+
+	std::shared_ptr<ShaderProgramCache::CompileJob> compileJob;
+	std::shared_ptr<OpenGLShaderProgram> program;
+	std::shared_ptr<ShaderUniformTable> uniforms;
+
+	int inputTextureIndex;
+	int inputSizeIndex;
+	int outputSizeIndex;
+	int timeIndex;
+	bool jobIsNew; //not polled in the frame of its request, the driver would have to finish compiling right away
+
+	//The code is appended to the common header
+	void request(const String& fragmentCode);
+
+	//Returns true when a new program has just been linked, the caller then looks its own uniforms up
+	bool update(const String& logName);
+
+	//Uses the program and binds the main input on unit 0, returns false if there is no program yet
+	bool use(GLuint inputTexture, Point<int> inputSize, Point<int> size);
+	void reset();
+
+	static String getVertexShaderCode();
+	static String getFragmentHeader();
+};
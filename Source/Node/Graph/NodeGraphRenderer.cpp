@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+	NodeGraphRenderer.cpp
+	Created: 20 Oct 2026 3:40:02pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+using namespace juce::gl;
+
+NodeGraphRenderer::NodeGraphRenderer(NodeManager* manager) :
+	manager(manager),
+	isDirty(true),
+	outputStep(-1),
+	VAO(0)
+{
+}
+
+NodeGraphRenderer::~NodeGraphRenderer()
+{
+}
+
+void NodeGraphRenderer::invalidate()
+{
+	GenericScopedLock lock(graphLock);
+	isDirty = true;
+}
+
+bool NodeGraphRenderer::render(int width, int height)
+{
+	GenericScopedLock lock(graphLock);
+
+	if (isDirty)
+	{
+		for (auto& s : steps) releaseTarget(s);
+		compile();
+		isDirty = false;
+	}
+
+	if (outputStep < 0) return false;
+
+	GLint destFrameBuffer = 0;
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &destFrameBuffer);
+
+	if (VAO == 0) glGenVertexArrays(1, &VAO);
+	glDisable(GL_BLEND);
+
+	for (int i = 0; i < steps.size(); i++)
+	{
+		Step& s = steps.getReference(i);
+		s.texture = 0;
+		s.size = Point<int>();
+
+		if (s.isSource)
+		{
+			s.texture = s.node->getGLOutputTexture(s.size);
+		}
+		else
+		{
+			inputTextures.clearQuick();
+			inputSizes.clearQuick();
+			for (auto& in : s.inputs)
+			{
+				inputTextures.add(in >= 0 ? steps[in].texture : 0);
+				inputSizes.add(in >= 0 ? steps[in].size : Point<int>());
+			}
+
+			Point<int> size = s.node->getGLOutputSize(inputSizes);
+			if (!size.isOrigin()) s.target = pool.acquire(size.x, size.y);
+
+			if (s.target != nullptr)
+			{
+				s.size = size;
+				s.texture = s.target->getTextureID();
+
+				s.target->makeCurrentRenderingTarget();
+				glViewport(0, 0, size.x, size.y);
+				glBindVertexArray(VAO);
+				bool rendered = s.fused != nullptr ? s.fused->render(inputTextures, inputSizes, size) : s.node->renderGL(inputTextures, inputSizes, size);
+				glBindVertexArray(0);
+				glUseProgram(0);
+
+				if (!rendered)
+				{
+					//Shader still compiling, show the input as is meanwhile
+					glClearColor(0, 0, 0, 0);
+					glClear(GL_COLOR_BUFFER_BIT);
+					if (!inputTextures.isEmpty() && inputTextures[0] != 0)
+					{
+						Init2DMatrix(size.x, size.y);
+						glBindTexture(GL_TEXTURE_2D, inputTextures[0]);
+						glColor4f(1, 1, 1, 1);
+						Draw2DTexRect(0, 0, size.x, size.y);
+					}
+				}
+
+				for (int t = inputTextures.size() - 1; t >= 0; t--)
+				{
+					glActiveTexture(GL_TEXTURE0 + t);
+					glBindTexture(GL_TEXTURE_2D, 0);
+				}
+			}
+		}
+
+		for (auto& r : s.releaseAfter) releaseTarget(steps.getReference(r));
+	}
+
+	//Draw the result in the destination
+	glBindFramebuffer(GL_FRAMEBUFFER, destFrameBuffer);
+	glEnable(GL_BLEND);
+
+	Step& out = steps.getReference(outputStep);
+	bool hasDrawn = out.texture != 0;
+	if (hasDrawn)
+	{
+		Init2DViewport(width, height);
+		glBindTexture(GL_TEXTURE_2D, out.texture);
+		glColor4f(1, 1, 1, 1);
+		Draw2DTexRect(0, 0, width, height);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	releaseTarget(out);
+	pool.endFrame();
+
+	return hasDrawn;
+}
+
+void NodeGraphRenderer::releaseGL()
+{
+	GenericScopedLock lock(graphLock);
+
+	for (auto& s : steps)
+	{
+		s.target = nullptr;
+		if (s.fused != nullptr) s.fused->filterProgram.reset();
+	}
+	pool.clear();
+	isDirty = true; //fused passes request their program again
+
+	{
+		GenericScopedLock itemLock(manager->itemLoopLock);
+		for (auto& n : manager->items) n->releaseGL();
+	}
+
+	if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+	VAO = 0;
+}
+
+void NodeGraphRenderer::compile()
+{
+	steps.clearQuick();
+	outputStep = -1;
+
+	GenericScopedLock itemLock(manager->itemLoopLock);
+
+	OutputNode* output = nullptr;
+	for (auto& n : manager->items)
+	{
+		output = dynamic_cast<OutputNode*>(n);
+		if (output != nullptr && output->enabled->boolValue()) break;
+		output = nullptr;
+	}
+
+	if (output == nullptr) return;
+
+	HashMap<Node*, int> stepIndices;
+	Array<Node*> visiting;
+	outputStep = resolveInput(output->inBuffer, stepIndices, visiting);
+	if (outputStep < 0) return;
+
+	fuseSteps();
+
+	//Give each target back after its last reader, the output's one after it has been drawn
+	Array<int> lastReaders;
+	lastReaders.insertMultiple(0, -1, steps.size());
+	for (int i = 0; i < steps.size(); i++)
+	{
+		for (auto& in : steps[i].inputs) if (in >= 0) lastReaders.set(in, i);
+	}
+
+	for (int i = 0; i < steps.size(); i++)
+	{
+		if (i == outputStep || lastReaders[i] < 0) continue;
+		steps.getReference(lastReaders[i]).releaseAfter.add(i);
+	}
+}
+
+int NodeGraphRenderer::addStep(Node* n, HashMap<Node*, int>& stepIndices, Array<Node*>& visiting)
+{
+	if (stepIndices.contains(n)) return stepIndices[n];
+
+	if (visiting.contains(n))
+	{
+		NLOGWARNING(n->niceName, "Buffer connections are looping, ignoring the loop");
+		return -1;
+	}
+
+	visiting.add(n);
+
+	Array<NodeConnectionSlot*> bufferInputs;
+	for (auto& s : n->inSlots) if (s->type == NODE_BUFFER) bufferInputs.add(s);
+
+	int result = -1;
+	if (!n->enabled->boolValue())
+	{
+		//Disabled nodes pass their input through, like they do on the CPU
+		for (auto& s : bufferInputs)
+		{
+			if (!n->passthroughMap.contains(s)) continue;
+			result = resolveInput(s, stepIndices, visiting);
+			break;
+		}
+	}
+	else if (n->providesGLTexture() || n->hasGLPass())
+	{
+		Step s;
+		s.node = n;
+		s.isSource = n->providesGLTexture();
+		if (!s.isSource) for (auto& slot : bufferInputs) s.inputs.add(resolveInput(slot, stepIndices, visiting));
+
+		GLFilterNode* f = dynamic_cast<GLFilterNode*>(n);
+		if (f != nullptr && f->isPointwise()) s.chain.add(f);
+
+		result = steps.size();
+		steps.add(s);
+	}
+
+	visiting.removeFirstMatchingValue(n);
+	stepIndices.set(n, result);
+	return result;
+}
+
+int NodeGraphRenderer::resolveInput(NodeConnectionSlot* slot, HashMap<Node*, int>& stepIndices, Array<Node*>& visiting)
+{
+	for (auto& c : slot->connections)
+	{
+		if (!c->enabled->boolValue() || c->source == nullptr || c->source->node == nullptr) continue;
+		return addStep(c->source->node, stepIndices, visiting);
+	}
+
+	return -1;
+}
+
+void NodeGraphRenderer::fuseSteps()
+{
+	Array<int> numReaders;
+	numReaders.insertMultiple(0, 0, steps.size());
+	for (auto& s : steps) for (auto& in : s.inputs) if (in >= 0) numReaders.set(in, numReaders[in] + 1);
+	numReaders.set(outputStep, numReaders[outputStep] + 1);
+
+	//Steps are ordered from the sources, so a chain is complete when its last node is reached
+	for (int i = 0; i < steps.size(); i++)
+	{
+		Step& s = steps.getReference(i);
+		if (s.chain.isEmpty() || s.inputs.isEmpty()) continue;
+
+		int p = s.inputs[0];
+		if (p < 0 || steps[p].chain.isEmpty() || numReaders[p] != 1) continue;
+
+		Step& previous = steps.getReference(p);
+		Array<GLFilterNode*> chain = previous.chain;
+		chain.addArray(s.chain);
+
+		Array<int> inputs = previous.inputs;
+		for (int j = 1; j < s.inputs.size(); j++) inputs.add(s.inputs[j]);
+
+		s.chain = chain;
+		s.inputs = inputs;
+		previous.chain.clear();
+		previous.node = nullptr;
+	}
+
+	//Remove the steps merged in the next ones
+	Array<int> newIndices;
+	Array<Step> fusedSteps;
+	for (auto& s : steps)
+	{
+		newIndices.add(s.node != nullptr ? fusedSteps.size() : -1);
+		if (s.node != nullptr) fusedSteps.add(s);
+	}
+
+	for (auto& s : fusedSteps)
+	{
+		for (auto& in : s.inputs) if (in >= 0) in = newIndices[in];
+
+		if (s.chain.isEmpty()) continue;
+
+		int64 hash = FusedFilterPass::getStructureHash(s.chain);
+		if (fusedCodes.find(hash) == fusedCodes.end()) fusedCodes[hash] = FusedFilterPass::generateCode(s.chain);
+		s.fused = std::make_shared<FusedFilterPass>(s.chain, fusedCodes[hash]);
+	}
+
+	outputStep = newIndices[outputStep];
+	steps.swapWith(fusedSteps);
+}
+
+void NodeGraphRenderer::releaseTarget(Step& s)
+{
+	if (s.target == nullptr) return;
+	pool.release(s.target);
+	s.target = nullptr;
+}
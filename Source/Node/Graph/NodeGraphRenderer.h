@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+	NodeGraphRenderer.h
+	Created: 20 Oct 2026 3:40:02pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class NodeManager;
+class GLFilterNode;
+class FusedFilterPass;
+
+/*
+	Renders the buffer side of a node graph on the GPU, in the GL render of its NodeMedia.
+	The graph is compiled, when it changes, into a list of steps ordered from the sources to the Output node.
+	Each step renders into a target from the pool, given back as soon as the last step reading it has rendered.
+	Chains of pointwise filters where each node is only read by the next one are fused in a single step,
+	so targets are only needed at the boundaries, like blurs or nodes read by several others.
+*/
+class NodeGraphRenderer
+{
+public:
+	NodeGraphRenderer(NodeManager* manager);
+	~NodeGraphRenderer();
+
+	NodeManager* manager;
+
+	struct Step
+	{
+		Node* node = nullptr;
+		bool isSource = false;
+		Array<int> inputs; //step indices, in the order of the node's buffer slots, -1 if not connected
+		Array<int> releaseAfter; //steps whose target is not read anymore once this one has rendered
+
+		Array<GLFilterNode*> chain; //pointwise filters rendered by this step, in order
+		std::shared_ptr<FusedFilterPass> fused;
+
+		//Current frame
+		OpenGLFrameBuffer* target = nullptr;
+		GLuint texture = 0;
+		Point<int> size;
+	};
+
+	//Locked by the render and by everything that can delete a node, so steps never point to a deleted one
+	CriticalSection graphLock;
+	bool isDirty;
+
+	Array<Step> steps;
+	int outputStep;
+
+	NodeTexturePool pool;
+	GLuint VAO;
+
+	std::map<int64, String> fusedCodes; //generated shaders, by chain structure
+
+	Array<GLuint> inputTextures;
+	Array<Point<int>> inputSizes;
+
+	void invalidate();
+
+	//Called from the GL thread with the destination framebuffer bound, returns false if nothing was drawn
+	bool render(int width, int height);
+	void releaseGL();
+
+	void compile();
+	int addStep(Node* n, HashMap<Node*, int>& stepIndices, Array<Node*>& visiting);
+	int resolveInput(NodeConnectionSlot* slot, HashMap<Node*, int>& stepIndices, Array<Node*>& visiting);
+	void fuseSteps();
+	void releaseTarget(Step& s);
+};
@@ -0,0 +1,191 @@
+/*
+  ==============================================================================
+
+	NodeScheduler.cpp
+	Created: 20 Oct 2026 8:05:12pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+void NodeScheduler::WorkQueue::reset()
+{
+	GenericScopedLock l(lock);
+	nodes.clearQuick();
+	head = 0;
+}
+
+bool NodeScheduler::WorkQueue::pop(Node*& n)
+{
+	GenericScopedLock l(lock);
+	if (nodes.size() <= head) return false;
+	n = nodes.removeAndReturn(nodes.size() - 1);
+	return true;
+}
+
+bool NodeScheduler::WorkQueue::steal(Node*& n)
+{
+	GenericScopedLock l(lock);
+	if (nodes.size() <= head) return false;
+	n = nodes[head++];
+	return true;
+}
+
+
+NodeScheduler::Worker::Worker(NodeScheduler* scheduler, int queueIndex) :
+	Thread("Nodes Worker " + String(queueIndex)),
+	scheduler(scheduler),
+	queueIndex(queueIndex)
+{
+}
+
+NodeScheduler::Worker::~Worker()
+{
+	signalThreadShouldExit();
+	wakeUp.signal();
+	stopThread(1000);
+}
+
+void NodeScheduler::Worker::run()
+{
+	while (!threadShouldExit())
+	{
+		if (!wakeUp.wait(100)) continue;
+		if (threadShouldExit()) break;
+
+		scheduler->work(queueIndex);
+		if (--scheduler->numBusyWorkers == 0) scheduler->workersDone.signal();
+	}
+}
+
+
+NodeScheduler::NodeScheduler() :
+	numActiveQueues(1),
+	numBusyWorkers(0)
+{
+	queues.add(new WorkQueue());
+}
+
+NodeScheduler::~NodeScheduler()
+{
+	workers.clear();
+}
+
+void NodeScheduler::compile(const Array<Node*>& nodes)
+{
+	HashMap<Node*, int> nodeLevels;
+	Array<Node*> visiting;
+	for (auto& n : nodes) getLevel(n, nodeLevels, visiting);
+
+	for (auto& l : levels) l.clearQuick();
+	for (auto& n : nodes)
+	{
+		int level = nodeLevels[n];
+		while (levels.size() <= level) levels.add(Array<Node*>());
+		levels.getReference(level).add(n);
+	}
+
+	while (!levels.isEmpty() && levels.getLast().isEmpty()) levels.removeLast();
+}
+
+int NodeScheduler::getLevel(Node* n, HashMap<Node*, int>& nodeLevels, Array<Node*>& visiting)
+{
+	if (nodeLevels.contains(n)) return nodeLevels[n];
+	if (visiting.contains(n)) return -1; //loop, this connection is ignored for the ordering
+
+	visiting.add(n);
+
+	int level = 0;
+	for (auto& s : n->inSlots)
+	{
+		for (auto& c : s->connections)
+		{
+			if (c->source == nullptr || c->source->node == nullptr) continue;
+			level = jmax(level, getLevel(c->source->node, nodeLevels, visiting) + 1);
+		}
+	}
+
+	visiting.removeFirstMatchingValue(n);
+	nodeLevels.set(n, level);
+	return level;
+}
+
+void NodeScheduler::setNumWorkers(int numWorkers)
+{
+	if (workers.size() == numWorkers) return;
+
+	workers.clear();
+	queues.removeRange(1, queues.size() - 1);
+
+	for (int i = 1; i <= numWorkers; i++)
+	{
+		queues.add(new WorkQueue());
+		Worker* w = workers.add(new Worker(this, i));
+		w->startThread();
+	}
+}
+
+void NodeScheduler::processFrame()
+{
+	for (auto& level : levels)
+	{
+		nodesToProcess.clearQuick();
+		for (auto& n : level) if (n->isStartingNode() || n->isQueued) nodesToProcess.add(n);
+		if (!nodesToProcess.isEmpty()) processLevel(nodesToProcess);
+	}
+
+	//Loop connections feed nodes of levels that already ran, they process again in the same frame until nothing is queued anymore.
+	//Nodes that only process once per frame unqueue themselves without processing.
+	bool hasQueuedNodes = true;
+	while (hasQueuedNodes && !Thread::currentThreadShouldExit())
+	{
+		hasQueuedNodes = false;
+		for (auto& level : levels)
+		{
+			nodesToProcess.clearQuick();
+			for (auto& n : level) if (n->isQueued) nodesToProcess.add(n);
+			if (nodesToProcess.isEmpty()) continue;
+
+			hasQueuedNodes = true;
+			processLevel(nodesToProcess);
+		}
+	}
+}
+
+void NodeScheduler::processLevel(const Array<Node*>& nodes)
+{
+	numActiveQueues = jmin(workers.size() + 1, nodes.size() / minNodesPerQueue);
+
+	if (numActiveQueues <= 1)
+	{
+		for (auto& n : nodes) n->process();
+		return;
+	}
+
+	for (int i = 0; i < numActiveQueues; i++) queues[i]->reset();
+	for (int i = 0; i < nodes.size(); i++) queues[i % numActiveQueues]->nodes.add(nodes[i]);
+
+	workersDone.reset();
+	numBusyWorkers = numActiveQueues - 1;
+	for (int i = 0; i < numActiveQueues - 1; i++) workers[i]->wakeUp.signal();
+
+	work(0);
+
+	//Nodes stolen from this thread's queue may still be processing, sleep until the last worker is done instead of spinning
+	while (numBusyWorkers > 0) workersDone.wait(100);
+}
+
+void NodeScheduler::work(int queueIndex)
+{
+	Node* n = nullptr;
+	while (true)
+	{
+		bool found = queues[queueIndex]->pop(n);
+		for (int i = 1; i < numActiveQueues && !found; i++) found = queues[(queueIndex + i) % numActiveQueues]->steal(n);
+		if (!found) return;
+
+		n->process();
+	}
+}
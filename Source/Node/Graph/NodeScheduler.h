@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+	NodeScheduler.h
+	Created: 20 Oct 2026 8:05:12pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Processes the nodes of a RootNodeManager on several threads.
+	The graph is compiled in topological levels : a node only receives from nodes of lower levels,
+	so all the nodes of a level can process at the same time.
+	Each level is spread over the queues of the workers, and a worker that has emptied its queue steals from the others.
+	The calling thread works too, and small levels are processed by it alone so they never wake anyone.
+	Loop connections are ignored for the levels : what they send is processed after the last level, in the same frame.
+*/
+class NodeScheduler
+{
+public:
+	NodeScheduler();
+	~NodeScheduler();
+
+	//Owner takes from the back, thieves from the front
+	class WorkQueue
+	{
+	public:
+		SpinLock lock;
+		Array<Node*> nodes;
+		int head = 0;
+
+		void reset();
+		bool pop(Node*& n);
+		bool steal(Node*& n);
+	};
+
+	class Worker :
+		public Thread
+	{
+	public:
+		Worker(NodeScheduler* scheduler, int queueIndex);
+		~Worker();
+
+		NodeScheduler* scheduler;
+		int queueIndex;
+		WaitableEvent wakeUp;
+
+		void run() override;
+	};
+
+	Array<Array<Node*>> levels;
+	Array<Node*> nodesToProcess;
+
+	OwnedArray<WorkQueue> queues; //the first one is the calling thread's
+	OwnedArray<Worker> workers;
+	int numActiveQueues;
+	std::atomic<int> numBusyWorkers;
+	WaitableEvent workersDone; //signaled by the last worker to finish its level
+
+	static const int minNodesPerQueue = 4; //below that, waking a worker costs more than the work
+
+	void compile(const Array<Node*>& nodes);
+	int getLevel(Node* n, HashMap<Node*, int>& nodeLevels, Array<Node*>& visiting);
+
+	void setNumWorkers(int numWorkers);
+
+	//Processes the nodes that have something to process, level by level, then the ones queued again by loop connections
+	void processFrame();
+	void processLevel(const Array<Node*>& nodes);
+	void work(int queueIndex);
+};
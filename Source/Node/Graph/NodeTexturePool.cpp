@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+	NodeTexturePool.cpp
+	Created: 20 Oct 2026 3:41:18pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+NodeTexturePool::NodeTexturePool() :
+	frameCount(0)
+{
+}
+
+NodeTexturePool::~NodeTexturePool()
+{
+}
+
+OpenGLFrameBuffer* NodeTexturePool::acquire(int width, int height)
+{
+	for (auto& t : targets)
+	{
+		if (t->isUsed || t->frameBuffer.getWidth() != width || t->frameBuffer.getHeight() != height) continue;
+		t->isUsed = true;
+		t->lastUsedFrame = frameCount;
+		return &t->frameBuffer;
+	}
+
+	Target* t = targets.add(new Target());
+	if (!t->frameBuffer.initialise(GlContextHolder::getInstance()->context, width, height))
+	{
+		LOGERROR("Could not create a " << width << "x" << height << " node buffer");
+		targets.removeObject(t);
+		return nullptr;
+	}
+
+	t->isUsed = true;
+	t->lastUsedFrame = frameCount;
+	return &t->frameBuffer;
+}
+
+void NodeTexturePool::release(OpenGLFrameBuffer* frameBuffer)
+{
+	for (auto& t : targets)
+	{
+		if (&t->frameBuffer != frameBuffer) continue;
+		t->isUsed = false;
+		return;
+	}
+
+	jassertfalse;
+}
+
+void NodeTexturePool::endFrame()
+{
+	for (int i = targets.size() - 1; i >= 0; i--)
+	{
+		Target* t = targets[i];
+		if (t->isUsed || frameCount - t->lastUsedFrame < maxIdleFrames) continue;
+		t->frameBuffer.release();
+		targets.remove(i);
+	}
+
+	frameCount++;
+}
+
+void NodeTexturePool::clear()
+{
+	for (auto& t : targets) t->frameBuffer.release();
+	targets.clear();
+}
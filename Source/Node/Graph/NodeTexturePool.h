@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+	NodeTexturePool.h
+	Created: 20 Oct 2026 3:41:18pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Render targets for the intermediate buffers of a node graph.
+	A target goes back to the pool as soon as its last reader has rendered, so a long chain only needs a few of them.
+	Targets that have not been used for a while are deleted. Must be used from the GL thread.
+*/
+class NodeTexturePool
+{
+public:
+	NodeTexturePool();
+	~NodeTexturePool();
+
+	struct Target
+	{
+		OpenGLFrameBuffer frameBuffer;
+		bool isUsed = false;
+		int lastUsedFrame = 0;
+	};
+
+	OwnedArray<Target> targets;
+	int frameCount;
+
+	static const int maxIdleFrames = 120;
+
+	OpenGLFrameBuffer* acquire(int width, int height);
+	void release(OpenGLFrameBuffer* frameBuffer);
+
+	//Deletes the targets nobody asked for in the last maxIdleFrames frames
+	void endFrame();
+	void clear();
+};
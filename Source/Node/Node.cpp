@@ -18,9 +18,11 @@ Node::Node(StringRef name, NodeType type, var params) :
 	processOnlyOnce(true),
 	hasProcessed(false),
 	processOnlyWhenAllConnectedNodesHaveProcessed(false),
+	isQueued(false),
 	lastProcessTime(0),
 	deltaTime(0),
 	processTimeMS(0),
+	averageProcessTimeMS(0),
 	nodeNotifier(5)
 {
 
@@ -36,11 +38,6 @@ Node::Node(StringRef name, NodeType type, var params) :
 
 Node::~Node()
 {
-	slotNumberMap.clear();
-	slotStringMap.clear();
-	slotColorMap.clear();
-	slotBufferMap.clear();
-
 	masterReference.clear();
 }
 
@@ -74,9 +71,9 @@ void Node::process()
 
 
 	GenericScopedLock lock(processLock);
-	uint32 ms = Time::getMillisecondCounter();
+	double startTime = Time::getMillisecondCounterHiRes();
 
-	deltaTime = (ms / 1000.0) - lastProcessTime;
+	deltaTime = (startTime / 1000.0) - lastProcessTime;
 
 	try
 	{
@@ -92,9 +89,10 @@ void Node::process()
 		NLOGERROR(niceName, "Exception during process :\n" << e.what());
 	}
 
-	uint32 t = Time::getMillisecondCounter();
-	processTimeMS = t - ms;
-	lastProcessTime = (t / 1000.0);
+	double endTime = Time::getMillisecondCounterHiRes();
+	processTimeMS = endTime - startTime;
+	averageProcessTimeMS += (processTimeMS - averageProcessTimeMS) * .1;
+	lastProcessTime = endTime / 1000.0;
 
 	removeNextToProcess();
 	hasProcessed = true;
@@ -110,10 +108,10 @@ void Node::processInternalPassthrough()
 		jassert(in->type == out->type);
 		switch (in->type)
 		{
+		case NodeConnectionType::NODE_BOOL:
 		case NodeConnectionType::NODE_FLOAT:
 		case NodeConnectionType::NODE_INT:
 			sendNumber(out, getFirstNumber(in)); break;
-			break;
 
 		case NodeConnectionType::NODE_STRING:
 			sendString(out, getFirstString(in)); break;
@@ -132,6 +130,7 @@ void Node::resetForNextLoop()
 {
 	clearSlotMaps();
 	hasProcessed = false;
+	isQueued = false;
 }
 
 bool Node::isStartingNode()
@@ -145,120 +144,91 @@ bool Node::haveAllConnectedInputsProcessed()
 	return true;
 }
 
-NodeConnectionSlot* Node::addSlot(StringRef name, bool isInput, NodeConnectionType t)
+Point<int> Node::getGLOutputSize(const Array<Point<int>>& inputSizes)
 {
-	jassert(getSlotWithName(name, isInput) == nullptr);
-	NodeConnectionSlot* s = new NodeConnectionSlot(this, isInput, name, t);
-	if (isInput) inSlots.add(s);
-	else outSlots.add(s);
-
-	s->addSlotListener(this);
-	return s;
+	return inputSizes.isEmpty() ? Point<int>() : inputSizes[0];
 }
 
-
-void Node::receiveNumber(NodeConnectionSlot* slot, NodeConnection* nc, var value)
+void Node::notifyGraphChanged()
 {
-	if (slotNumberMap.find(slot) == slotNumberMap.end()) slotNumberMap[slot] = std::map<NodeConnection*, var>();
-
-	var v = copyDataOnReceive ? value.clone() : value;
-	slotNumberMap[slot][nc] = v;
-	checkAddNextToProcessForSlot(slot);
+	if (Engine::mainEngine->isClearing || isClearing) return;
+	if (RootNodeManager* r = getRootManager())
+	{
+		r->scheduleIsDirty = true;
+		r->glRenderer.invalidate();
+	}
 }
 
-void Node::receiveString(NodeConnectionSlot* slot, NodeConnection* nc, String value)
+void Node::connectionAdded(NodeConnectionSlot* s, NodeConnection* c)
 {
-	if (slotNumberMap.find(slot) == slotNumberMap.end()) slotNumberMap[slot] = std::map<NodeConnection*, var>();
-
-	slotStringMap[slot][nc] = value;
-	checkAddNextToProcessForSlot(slot);
+	notifyGraphChanged();
 }
 
-
-void Node::receiveColor(NodeConnectionSlot* slot, NodeConnection* nc, Colour value)
+void Node::connectionRemoved(NodeConnectionSlot* s, NodeConnection* c)
 {
-	if (slotNumberMap.find(slot) == slotNumberMap.end()) slotNumberMap[slot] = std::map<NodeConnection*, var>();
-
-	slotColorMap[slot][nc] = value;
-	checkAddNextToProcessForSlot(slot);
+	notifyGraphChanged();
 }
 
+void Node::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == enabled) notifyGraphChanged();
+}
 
-
-void Node::receiveBuffer(NodeConnectionSlot* slot, NodeConnection* nc, OpenGLFrameBuffer* buffer)
+NodeConnectionSlot* Node::addSlot(StringRef name, bool isInput, NodeConnectionType t)
 {
-	if (slotBufferMap.find(slot) == slotBufferMap.end()) slotBufferMap[slot] = std::map<NodeConnection*, OpenGLFrameBuffer*>();
+	jassert(getSlotWithName(name, isInput) == nullptr);
+	NodeConnectionSlot* s = new NodeConnectionSlot(this, isInput, name, t);
+	if (isInput) inSlots.add(s);
+	else outSlots.add(s);
 
-	//var v = copyDataOnReceive ? buffer.
-	slotBufferMap[slot][nc] = buffer;
-	checkAddNextToProcessForSlot(slot);
+	s->addSlotListener(this);
+	return s;
 }
 
 
 void Node::clearSlotMaps()
 {
-	slotNumberMap.clear();
-	slotStringMap.clear();
-	slotColorMap.clear();
-	slotBufferMap.clear();
+	for (auto& s : inSlots) s->clearValues();
 }
 
 
 
-void Node::sendNumber(NodeConnectionSlot* slot, var value)
+NodeConnectionSlot::PortValue* Node::getValueToSend(NodeConnection* c)
 {
-	if (slot == nullptr) return;
-	//if (slot->isEmpty()) return;
+	if (!checkConnectionCanSend(c)) return nullptr;
 
-	for (auto& c : slot->connections)
-	{
-		if (!checkConnectionCanSend(c)) continue;
-		//if (!c->dest->node->enabled->boolValue()) continue;
-		c->dest->node->receiveNumber(c->dest, c, value);
-		c->hasSentInThisLoop = true;
-	}
+	NodeConnectionSlot* dest = c->dest;
+	if (!isPositiveAndBelow(c->destIndex, dest->values.size())) return nullptr; //connected during this loop, ready on the next one
+
+	NodeConnectionSlot::PortValue* v = &dest->values.getReference(c->destIndex);
+	v->hasValue = true;
+	c->hasSentInThisLoop = true;
+	dest->node->checkAddNextToProcessForSlot(dest);
+	return v;
 }
 
-void Node::sendString(NodeConnectionSlot* slot, String value)
+void Node::sendNumber(NodeConnectionSlot* slot, double value)
 {
 	if (slot == nullptr) return;
-	//if (slot->isEmpty()) return;
+	for (auto& c : slot->connections) if (NodeConnectionSlot::PortValue* v = getValueToSend(c)) v->number = value;
+}
 
-	for (auto& c : slot->connections)
-	{
-		if (!checkConnectionCanSend(c)) continue;
-		//if (!c->dest->node->enabled->boolValue()) continue;
-		c->dest->node->receiveString(c->dest, c, value);
-		c->hasSentInThisLoop = true;
-	}
+void Node::sendString(NodeConnectionSlot* slot, const String& value)
+{
+	if (slot == nullptr) return;
+	for (auto& c : slot->connections) if (NodeConnectionSlot::PortValue* v = getValueToSend(c)) v->string = value;
 }
 
 void Node::sendColor(NodeConnectionSlot* slot, Colour value)
 {
 	if (slot == nullptr) return;
-	//if (slot->isEmpty()) return;
-
-	for (auto& c : slot->connections)
-	{
-		if (!checkConnectionCanSend(c)) continue;
-		//if (!c->dest->node->enabled->boolValue()) continue;
-		c->dest->node->receiveColor(c->dest, c, value);
-		c->hasSentInThisLoop = true;
-	}
+	for (auto& c : slot->connections) if (NodeConnectionSlot::PortValue* v = getValueToSend(c)) v->color = value;
 }
 
 void Node::sendBuffer(NodeConnectionSlot* slot, OpenGLFrameBuffer* buffer)
 {
 	if (slot == nullptr) return;
-	//if (slot->isEmpty()) return;
-
-	for (auto& c : slot->connections)
-	{
-		if (!checkConnectionCanSend(c)) continue;
-		//if (!c->dest->node->enabled->boolValue()) continue;
-		c->dest->node->receiveBuffer(c->dest, c, buffer);
-		c->hasSentInThisLoop = true;
-	}
+	for (auto& c : slot->connections) if (NodeConnectionSlot::PortValue* v = getValueToSend(c)) v->buffer = buffer;
 }
 
 bool Node::checkConnectionCanSend(NodeConnection* c)
@@ -282,56 +252,72 @@ NodeConnectionSlot* Node::getSlotWithName(StringRef name, bool isInput)
 	return nullptr;
 }
 
-var Node::getFirstNumber(NodeConnectionSlot* slot)
+double Node::getFirstNumber(NodeConnectionSlot* slot)
 {
-	if (slotNumberMap.find(slot) == slotNumberMap.end()) return 0;
-	return slotNumberMap[slot].begin()->second;
+	const NodeConnectionSlot::PortValue* v = slot->getFirstValue();
+	return v != nullptr ? v->number : 0;
 }
 
 String Node::getFirstString(NodeConnectionSlot* slot)
 {
-	if (slotStringMap.find(slot) == slotStringMap.end()) return String();
-	return slotStringMap[slot].begin()->second;
+	const NodeConnectionSlot::PortValue* v = slot->getFirstValue();
+	return v != nullptr ? v->string : String();
 }
 
 Colour Node::getFirstColor(NodeConnectionSlot* slot)
 {
-	if (slotColorMap.find(slot) == slotColorMap.end()) return Colours::black;
-	return slotColorMap[slot].begin()->second;
+	const NodeConnectionSlot::PortValue* v = slot->getFirstValue();
+	return v != nullptr ? v->color : Colours::black;
 }
 
 OpenGLFrameBuffer* Node::getFirstBuffer(NodeConnectionSlot* slot)
 {
-	if (slotBufferMap.find(slot) == slotBufferMap.end()) return nullptr;
-	return slotBufferMap[slot].begin()->second;
+	const NodeConnectionSlot::PortValue* v = slot->getFirstValue();
+	return v != nullptr ? v->buffer : nullptr;
 }
 
 
-Array<var> Node::getAllNumbers()
+Array<double> Node::getAllNumbers()
 {
-	Array<var> result;
-	for (auto ca : slotNumberMap) for (auto c : ca.second) result.add(c.second);
+	Array<double> result;
+	for (auto& s : inSlots)
+	{
+		if (s->type != NODE_BOOL && s->type != NODE_FLOAT && s->type != NODE_INT) continue;
+		for (auto& v : s->values) if (v.hasValue) result.add(v.number);
+	}
 	return result;
 }
 
 Array<String> Node::getAllStrings()
 {
 	Array<String> result;
-	for (auto ca : slotStringMap) for (auto c : ca.second) result.add(c.second);
+	for (auto& s : inSlots)
+	{
+		if (s->type != NODE_STRING) continue;
+		for (auto& v : s->values) if (v.hasValue) result.add(v.string);
+	}
 	return result;
 }
 
 Array<Colour> Node::getAllColors()
 {
 	Array<Colour> result;
-	for (auto ca : slotColorMap) for (auto c : ca.second) result.add(c.second);
+	for (auto& s : inSlots)
+	{
+		if (s->type != NODE_COLOR) continue;
+		for (auto& v : s->values) if (v.hasValue) result.add(v.color);
+	}
 	return result;
 }
 
 Array<OpenGLFrameBuffer*> Node::getAllBuffers()
 {
 	Array<OpenGLFrameBuffer*> result;
-	for (auto ca : slotBufferMap) for (auto c : ca.second) result.add(c.second);
+	for (auto& s : inSlots)
+	{
+		if (s->type != NODE_BUFFER) continue;
+		for (auto& v : s->values) if (v.hasValue) result.add(v.buffer);
+	}
 	return result;
 }
 
@@ -350,14 +336,12 @@ void Node::checkAddNextToProcessForSlot(NodeConnectionSlot* slot)
 
 void Node::addNextToProcess()
 {
-	if (Engine::mainEngine->isClearing) return;
-	getRootManager()->nextToProcess.addIfNotAlreadyThere(this);
+	isQueued = true;
 }
 
 void Node::removeNextToProcess()
 {
-	if (Engine::mainEngine->isClearing) return;
-	getRootManager()->nextToProcess.removeAllInstancesOf(this);
+	isQueued = false;
 }
 
 
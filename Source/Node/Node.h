@@ -32,23 +32,17 @@ public:
 	BoolParameter* logEnabled;
 
 	bool isInit = false;
-	bool copyDataOnReceive = false;
 
 	NodeType type;
 
 	OwnedArray<NodeConnectionSlot, CriticalSection> inSlots;
 	OwnedArray<NodeConnectionSlot, CriticalSection> outSlots;
 
-	//Buffer data
-	std::map<NodeConnectionSlot*, std::map<NodeConnection*, var>> slotNumberMap;
-	std::map<NodeConnectionSlot*, std::map<NodeConnection*, String>> slotStringMap;
-	std::map<NodeConnectionSlot*, std::map<NodeConnection*, Colour>> slotColorMap;
-	std::map<NodeConnectionSlot*, std::map<NodeConnection*, OpenGLFrameBuffer*>> slotBufferMap;
-
 	HashMap<NodeConnectionSlot*, NodeConnectionSlot*> passthroughMap;
 
 	//process
 	SpinLock processLock;
+	std::atomic<bool> isQueued; //received something, will process when the scheduler reaches its level
 	bool processOnlyOnce;
 	bool hasProcessed; //if it has already processed in this frame
 	bool processOnlyWhenAllConnectedNodesHaveProcessed;
@@ -56,7 +50,8 @@ public:
 	//Stats
 	double lastProcessTime;
 	double deltaTime;
-	int processTimeMS;
+	double processTimeMS;
+	double averageProcessTimeMS;
 
 	//ui image safety
 	SpinLock imageLock;
@@ -79,20 +74,28 @@ public:
 
 	virtual bool haveAllConnectedInputsProcessed();
 
-	//Slots
-	NodeConnectionSlot* addSlot(StringRef name, bool isInput, NodeConnectionType t);
+	//GL, buffer connections are compiled by the NodeMedia into passes rendered in its GL render
+	virtual bool providesGLTexture() const { return false; } //sources that already have a texture, like medias
+	virtual bool hasGLPass() const { return false; } //nodes rendering their output in a pooled target
+	virtual GLuint getGLOutputTexture(Point<int>& size) { return 0; }
+	virtual Point<int> getGLOutputSize(const Array<Point<int>>& inputSizes);
+	virtual bool renderGL(const Array<GLuint>& inputTextures, const Array<Point<int>>& inputSizes, Point<int> size) { return false; }
+	virtual void releaseGL() {}
 
-	//IO
-	virtual void receiveNumber(NodeConnectionSlot* slot, NodeConnection* nc, var value);
-	virtual void receiveString(NodeConnectionSlot* slot, NodeConnection* nc, String value);
-	virtual void receiveColor(NodeConnectionSlot* slot, NodeConnection* nc, Colour value);
-	virtual void receiveBuffer(NodeConnectionSlot* slot, NodeConnection* nc, OpenGLFrameBuffer* buffer);
+	void notifyGraphChanged();
+	void connectionAdded(NodeConnectionSlot*, NodeConnection*) override;
+	void connectionRemoved(NodeConnectionSlot*, NodeConnection*) override;
+	void onContainerParameterChangedInternal(Parameter* p) override;
 
+	//Slots
+	NodeConnectionSlot* addSlot(StringRef name, bool isInput, NodeConnectionType t);
 
+	//IO, values are stored in the input slots of the receivers, sending is a store and a flag
 	void clearSlotMaps();
 
-	void sendNumber(NodeConnectionSlot* slot, var value);
-	void sendString(NodeConnectionSlot* slot, String value);
+	NodeConnectionSlot::PortValue* getValueToSend(NodeConnection* c);
+	void sendNumber(NodeConnectionSlot* slot, double value);
+	void sendString(NodeConnectionSlot* slot, const String& value);
 	void sendColor(NodeConnectionSlot* slot, Colour value);
 	void sendBuffer(NodeConnectionSlot* slot, OpenGLFrameBuffer* buffer);
 
@@ -104,12 +107,12 @@ public:
 
 	NodeConnectionSlot* getSlotWithName(StringRef name, bool isInput);
 
-	var getFirstNumber(NodeConnectionSlot* slot);
+	double getFirstNumber(NodeConnectionSlot* slot);
 	String getFirstString(NodeConnectionSlot* slot);
 	Colour getFirstColor(NodeConnectionSlot* slot);
 	OpenGLFrameBuffer* getFirstBuffer(NodeConnectionSlot* slot);
 
-	Array<var> getAllNumbers();
+	Array<double> getAllNumbers();
 	Array<String> getAllStrings();
 	Array<Colour> getAllColors();
 	Array<OpenGLFrameBuffer*> getAllBuffers();
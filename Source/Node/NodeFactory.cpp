@@ -18,5 +18,16 @@ NodeFactory::NodeFactory()
 
 	defs.add(Definition::createDef<MediaNode>("Source"));
 	defs.add(Definition::createDef<ShapeNode>("Drawing"));
+	defs.add(Definition::createDef<LevelsNode>("Filter"));
+	defs.add(Definition::createDef<TintNode>("Filter"));
+	defs.add(Definition::createDef<InvertNode>("Filter"));
+	defs.add(Definition::createDef<MaskNode>("Filter"));
+	defs.add(Definition::createDef<BlurNode>("Filter"));
+	defs.add(Definition::createDef<ThresholdNode>("Analysis"));
+	defs.add(Definition::createDef<LuminanceNode>("Analysis"));
+	defs.add(Definition::createDef<MotionNode>("Analysis"));
+	defs.add(Definition::createDef<CentroidNode>("Analysis"));
+	defs.add(Definition::createDef<BlobNode>("Analysis"));
+	defs.add(Definition::createDef<OutputNode>("Output"));
 
 }
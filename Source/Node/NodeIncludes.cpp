@@ -15,6 +15,15 @@
 #include "Connection/NodeConnectionSlot.cpp"
 #include "Node.cpp"
 
+#include "Graph/NodeScheduler.cpp"
+#include "Graph/NodeTexturePool.cpp"
+#include "Graph/NodeFilterProgram.cpp"
+#include "Graph/FusedFilterPass.cpp"
+#include "Graph/NodeGraphRenderer.cpp"
+
+#include "Analysis/ImageKernels.cpp"
+#include "Analysis/AnalysisFrameGrabber.cpp"
+
 #include "Connection/NodeConnectionManager.cpp"
 #include "NodeFactory.cpp"
 #include "NodeManager.cpp"
@@ -29,4 +38,16 @@
 
 #include "nodes/Source/MediaNode.cpp"
 #include "nodes/Output/OutputNode.cpp"
-#include "nodes/Drawing/shape/ShapeNode.cpp"
\ No newline at end of file
+#include "nodes/Drawing/shape/ShapeNode.cpp"
+#include "nodes/Filter/GLFilterNode.cpp"
+#include "nodes/Filter/color/LevelsNode.cpp"
+#include "nodes/Filter/color/TintNode.cpp"
+#include "nodes/Filter/color/InvertNode.cpp"
+#include "nodes/Filter/mask/MaskNode.cpp"
+#include "nodes/Filter/blur/BlurNode.cpp"
+#include "nodes/Analysis/AnalysisNode.cpp"
+#include "nodes/Analysis/level/ThresholdNode.cpp"
+#include "nodes/Analysis/level/LuminanceNode.cpp"
+#include "nodes/Analysis/motion/MotionNode.cpp"
+#include "nodes/Analysis/tracking/CentroidNode.cpp"
+#include "nodes/Analysis/tracking/BlobNode.cpp"
\ No newline at end of file
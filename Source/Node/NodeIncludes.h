@@ -16,11 +16,21 @@ using namespace juce;
 // 
 //pcl
 #include "Common/CommonIncludes.h"
+#include "Media/MediaIncludes.h"
 
 // classes
 #include "Connection/NodeConnectionSlot.h"
 #include "Connection/NodeConnection.h"
 #include "Node.h"
+#include "Graph/NodeScheduler.h"
+
+#include "Graph/NodeTexturePool.h"
+#include "Graph/NodeFilterProgram.h"
+#include "Graph/FusedFilterPass.h"
+#include "Graph/NodeGraphRenderer.h"
+
+#include "Analysis/ImageKernels.h"
+#include "Analysis/AnalysisFrameGrabber.h"
 
 #include "Connection/NodeConnectionManager.h"
 #include "NodeFactory.h"
@@ -31,6 +41,18 @@ using namespace juce;
 #include "nodes/Output/OutputNode.h"
 #include "nodes/Source/MediaNode.h"
 #include "nodes/Drawing/shape/ShapeNode.h"
+#include "nodes/Filter/GLFilterNode.h"
+#include "nodes/Filter/color/LevelsNode.h"
+#include "nodes/Filter/color/TintNode.h"
+#include "nodes/Filter/color/InvertNode.h"
+#include "nodes/Filter/mask/MaskNode.h"
+#include "nodes/Filter/blur/BlurNode.h"
+#include "nodes/Analysis/AnalysisNode.h"
+#include "nodes/Analysis/level/ThresholdNode.h"
+#include "nodes/Analysis/level/LuminanceNode.h"
+#include "nodes/Analysis/motion/MotionNode.h"
+#include "nodes/Analysis/tracking/CentroidNode.h"
+#include "nodes/Analysis/tracking/BlobNode.h"
 
 #include "ui/ViewStatsTimer.h"
 
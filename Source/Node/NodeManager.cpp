@@ -84,11 +84,15 @@ void NodeManager::loadJSONDataManagerInternal(var data)
 RootNodeManager::RootNodeManager(NodeMedia* media) :
 	NodeManager(media),
 	Thread("Nodes"),
-	processTimeMS(1),
-	averageFPS(0)
+	processTimeMS(0),
+	averageFPS(0),
+	maxFPS(0),
+	scheduleIsDirty(true),
+	glRenderer(this)
 {
 	Engine::mainEngine->addEngineListener(this);
 	fps = addIntParameter("FPS", "Target process rate", 30, 1, 500);
+	numThreads = addIntParameter("Threads", "Number of threads processing the nodes, 0 uses all the cores", 0, 0, 64);
 }
 
 RootNodeManager::~RootNodeManager()
@@ -100,12 +104,16 @@ RootNodeManager::~RootNodeManager()
 
 void RootNodeManager::addItemInternal(Node* item, var data)
 {
+	scheduleIsDirty = true;
+	glRenderer.invalidate();
 	GenericScopedLock lock(itemLoopLock);
 	NodeManager::addItemInternal(item, data);
 }
 
 void RootNodeManager::removeItemInternal(Node* item)
 {
+	scheduleIsDirty = true;
+	glRenderer.invalidate(); //before the item lock, the render takes them in this order
 	GenericScopedLock lock(itemLoopLock);
 	NodeManager::removeItemInternal(item);
 }
@@ -121,64 +129,74 @@ void RootNodeManager::run()
 {
 	wait(1000); //safety
 
-	long lastFrameTime = Time::getMillisecondCounter();
-
-	nextToProcess.clear();
+	double lastFrameTime = Time::getMillisecondCounterHiRes();
+	double nextFrameTime = lastFrameTime;
 
 	while (!threadShouldExit())
 	{
-		long millis = Time::getMillisecondCounter();
+		double frameStart = Time::getMillisecondCounterHiRes();
 
 		try
 		{
+			GenericScopedLock lock(itemLoopLock);
+
+			if (scheduleIsDirty)
+			{
+				scheduleIsDirty = false;
+				Array<Node*> nodes;
+				nodes.addArray(items);
+				scheduler.compile(nodes);
+			}
+
+			scheduler.setNumWorkers(getNumWorkers());
+
+			for (auto& i : items) i->resetForNextLoop();
+			for (auto& i : connectionManager->items)
 			{
-				GenericScopedLock lock(itemLoopLock);
-				for (auto& i : items) i->resetForNextLoop();
-				for (auto& i : connectionManager->items)
-				{
-					i->hasSentInPrevLoop = i->hasSentInThisLoop;
-					i->hasSentInThisLoop = false;
-				}
-
-				for (auto& i : items)
-				{
-					if (i->isStartingNode()) i->process();
-				}
-				while (!threadShouldExit() && !nextToProcess.isEmpty())
-				{
-					Array<Node*> processList;
-					processList.addArray(nextToProcess);
-					for (auto& n : processList)
-					{
-						if (threadShouldExit()) return;
-						n->process();
-					}
-				}
+				i->hasSentInPrevLoop = i->hasSentInThisLoop;
+				i->hasSentInThisLoop = false;
 			}
+
+			scheduler.processFrame();
 		}
 		catch (std::exception e)
 		{
 			LOGERROR("Error during process : " << e.what());
-			nextToProcess.clear();
-
 			return;
 		}
 
-		uint32 t = Time::getMillisecondCounter();
-		processTimeMS = t - millis;
-		maxFPS = 1000 / jmax(processTimeMS, 1);
+		double t = Time::getMillisecondCounterHiRes();
+		processTimeMS = t - frameStart;
+		maxFPS = (int)(1000 / jmax(processTimeMS, .01));
 
-		int frameDiff = t - lastFrameTime;
-		averageFPS = 1000 / jmax(frameDiff, 1);
+		averageFPS = 1000 / jmax(t - lastFrameTime, .01);
 		lastFrameTime = t;
 
-		int targetFrameMS = 1000 / fps->intValue();
-		int timeToWait = targetFrameMS - processTimeMS;
-		if (timeToWait > 0) wait(timeToWait);
+		//Paced on absolute times so the rate doesn't drift, a late frame doesn't make the next ones hurry
+		nextFrameTime = jmax(nextFrameTime + 1000.0 / fps->intValue(), t);
+		waitUntil(nextFrameTime);
 	}
 
-	nextToProcess.clear();
+	scheduler.setNumWorkers(0);
+}
+
+int RootNodeManager::getNumWorkers() const
+{
+	int threads = numThreads->intValue();
+	if (threads == 0) threads = SystemStats::getNumCpus();
+	return jmax(threads - 1, 0);
+}
 
+void RootNodeManager::waitUntil(double time)
+{
+	//wait() is only precise to the millisecond, the last one is spent yielding
+	while (!threadShouldExit())
+	{
+		double remaining = time - Time::getMillisecondCounterHiRes();
+		if (remaining <= 0) return;
+		if (remaining > 2) wait((int)remaining - 1);
+		else Thread::yield();
+	}
 }
 
 void RootNodeManager::startLoadFile()
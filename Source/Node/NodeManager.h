@@ -47,18 +47,27 @@ public:
 	RootNodeManager(NodeMedia* media);
 	~RootNodeManager();
 
-	Array<Node*, CriticalSection> nextToProcess;
-
 	IntParameter* fps;
-	int processTimeMS;
-	int averageFPS;
+	IntParameter* numThreads;
+
+	//Stats, per node timings are in the nodes
+	double processTimeMS;
+	double averageFPS;
 	int maxFPS;
 
-	SpinLock itemLoopLock;
+	CriticalSection itemLoopLock;
+
+	NodeScheduler scheduler;
+	std::atomic<bool> scheduleIsDirty;
+
+	//Buffer connections, rendered by the NodeMedia on the GL thread
+	NodeGraphRenderer glRenderer;
 
 	void clear() override;
 
 	void run() override;
+	int getNumWorkers() const;
+	void waitUntil(double time);
 
 	void addItemInternal(Node* item, var data) override;
 	void removeItemInternal(Node* item) override;
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+	AnalysisNode.cpp
+	Created: 21 Oct 2026 11:30:17am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+#define ANALYSISNODE_TARGET_MEDIA_ID 0
+
+AnalysisNode::AnalysisNode(StringRef name, var params) :
+	Node(name, Node::SOURCE, params),
+	lumaSize(0),
+	frameWidth(0),
+	frameHeight(0)
+{
+	source = addTargetParameter("Media", "The media to analyse", MediaManager::getInstance());
+	source->targetType = source->CONTAINER;
+	source->maxDefaultSearchLevel = 0;
+
+	analysisWidth = addIntParameter("Analysis Width", "Width the frames are downscaled to before the analysis. Smaller is faster and less noisy.", 160, 16, 1920);
+}
+
+AnalysisNode::~AnalysisNode()
+{
+}
+
+void AnalysisNode::processInternal()
+{
+	if (!grabber.getLatestFrame(frame)) return; //nothing new since the last analysis
+
+	frameWidth = frame.width;
+	frameHeight = frame.height;
+	ensureBuffer(luma, lumaSize);
+
+	//GL rows are bottom first
+	for (int y = 0; y < frameHeight; y++)
+	{
+		const uint8* row = frame.data + (size_t)(frameHeight - 1 - y) * frameWidth * 4;
+		ImageKernels::lumaFromRGBA(row, luma + (size_t)y * frameWidth, frameWidth);
+	}
+
+	processFrame();
+}
+
+void AnalysisNode::onContainerParameterChangedInternal(Parameter* p)
+{
+	Node::onContainerParameterChangedInternal(p);
+
+	if (p == source)
+	{
+		Media* m = source->getTargetContainerAs<Media>();
+		if (m != nullptr) registerUseMedia(ANALYSISNODE_TARGET_MEDIA_ID, m);
+		else unregisterUseMedia(ANALYSISNODE_TARGET_MEDIA_ID);
+		grabber.setSource(enabled->boolValue() ? m : nullptr);
+	}
+	else if (p == enabled)
+	{
+		Media* m = source->getTargetContainerAs<Media>();
+		grabber.setSource(enabled->boolValue() ? m : nullptr);
+		if (m != nullptr) m->updateBeingUsed();
+	}
+	else if (p == analysisWidth)
+	{
+		grabber.setAnalysisWidth(analysisWidth->intValue());
+	}
+}
+
+bool AnalysisNode::isUsingMedia(Media* m)
+{
+	if (!enabled->boolValue()) return false;
+	return MediaTarget::isUsingMedia(m);
+}
+
+bool AnalysisNode::getCentroid(const uint8* image, int width, int height, Point<float>& centroid, uint64& mass)
+{
+	uint64 m00 = 0, m10 = 0, m01 = 0;
+	for (int y = 0; y < height; y++)
+	{
+		uint64 rowSum = 0, rowXSum = 0;
+		ImageKernels::weightedSums(image + (size_t)y * width, width, rowSum, rowXSum);
+		m00 += rowSum;
+		m10 += rowXSum;
+		m01 += rowSum * (uint64)y;
+	}
+
+	mass = m00;
+	if (m00 == 0) return false;
+
+	centroid.setXY((float)((m10 / (double)m00 + .5) / width), (float)((m01 / (double)m00 + .5) / height));
+	return true;
+}
+
+void AnalysisNode::ensureBuffer(HeapBlock<uint8>& buffer, size_t& bufferSize)
+{
+	size_t size = (size_t)frameWidth * (size_t)frameHeight;
+	if (bufferSize == size) return;
+	buffer.allocate(size, false);
+	bufferSize = size;
+}
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+	AnalysisNode.h
+	Created: 21 Oct 2026 11:30:17am
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Base for the nodes that turn a media's frames into control data, typically a Webcam, NDI or Video media.
+	Frames come downscaled from the GL thread, the analysis runs on the node threads and only when a new frame has arrived.
+*/
+class AnalysisNode :
+	public Node,
+	public MediaTarget
+{
+public:
+	AnalysisNode(StringRef name, var params = var());
+	virtual ~AnalysisNode();
+
+	TargetParameter* source;
+	IntParameter* analysisWidth;
+
+	AnalysisFrameGrabber grabber;
+	AnalysisFrameGrabber::Frame frame;
+
+	//Luma of the current frame, top row first
+	HeapBlock<uint8> luma;
+	size_t lumaSize;
+	int frameWidth;
+	int frameHeight;
+
+	void processInternal() override;
+	virtual void processFrame() = 0;
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+	bool isUsingMedia(Media* m) override;
+
+	//Centroid of an 8 bit image in normalized coordinates, false if the image is black
+	static bool getCentroid(const uint8* image, int width, int height, Point<float>& centroid, uint64& mass);
+
+	//Makes sure a work buffer has one byte per pixel of the current frame
+	void ensureBuffer(HeapBlock<uint8>& buffer, size_t& bufferSize);
+};
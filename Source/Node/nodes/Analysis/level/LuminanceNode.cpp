@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+	LuminanceNode.cpp
+	Created: 21 Oct 2026 12:21:09pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+LuminanceNode::LuminanceNode(var params) :
+	AnalysisNode(getTypeString(), params)
+{
+	regionPosition = addPoint2DParameter("Region Position", "Top left corner of the region, relative to the image");
+	regionPosition->setBounds(0, 0, 1, 1);
+
+	regionSize = addPoint2DParameter("Region Size", "Size of the region, relative to the image");
+	regionSize->setBounds(0, 0, 1, 1);
+	regionSize->setDefaultPoint(1, 1);
+
+	luminanceOut = addSlot("Luminance", false, NODE_FLOAT);
+}
+
+LuminanceNode::~LuminanceNode()
+{
+}
+
+void LuminanceNode::processFrame()
+{
+	Point<float> p = regionPosition->getPoint();
+	Point<float> s = regionSize->getPoint();
+
+	Rectangle<int> region = Rectangle<int>(roundToInt(p.x * frameWidth), roundToInt(p.y * frameHeight), roundToInt(s.x * frameWidth), roundToInt(s.y * frameHeight))
+		.getIntersection(Rectangle<int>(0, 0, frameWidth, frameHeight));
+
+	if (region.isEmpty())
+	{
+		sendNumber(luminanceOut, 0);
+		return;
+	}
+
+	uint64 total = 0;
+	for (int y = region.getY(); y < region.getBottom(); y++) total += ImageKernels::sum(luma + (size_t)y * frameWidth + region.getX(), region.getWidth());
+
+	sendNumber(luminanceOut, total / (255.0 * region.getWidth() * region.getHeight()));
+}
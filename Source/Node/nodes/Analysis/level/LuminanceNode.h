@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+	LuminanceNode.h
+	Created: 21 Oct 2026 12:21:09pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Mean brightness of a part of the image
+class LuminanceNode :
+	public AnalysisNode
+{
+public:
+	LuminanceNode(var params = var());
+	~LuminanceNode();
+
+	Point2DParameter* regionPosition;
+	Point2DParameter* regionSize;
+
+	NodeConnectionSlot* luminanceOut;
+
+	void processFrame() override;
+
+	DECLARE_TYPE("Region Luminance")
+};
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+	ThresholdNode.cpp
+	Created: 21 Oct 2026 12:05:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+ThresholdNode::ThresholdNode(var params) :
+	AnalysisNode(getTypeString(), params),
+	maskSize(0)
+{
+	level = addFloatParameter("Level", "Pixels at least this bright are counted", .5f, 0, 1);
+	invert = addBoolParameter("Invert", "Count the pixels darker than the level instead", false);
+	triggerCoverage = addFloatParameter("Trigger Coverage", "Triggered is on when at least this part of the image is counted", .05f, 0, 1);
+
+	coverageOut = addSlot("Coverage", false, NODE_FLOAT);
+	triggeredOut = addSlot("Triggered", false, NODE_BOOL);
+}
+
+ThresholdNode::~ThresholdNode()
+{
+}
+
+void ThresholdNode::processFrame()
+{
+	ensureBuffer(mask, maskSize);
+
+	int numPixels = frameWidth * frameHeight;
+	ImageKernels::threshold(luma, mask, numPixels, (uint8)roundToInt(level->floatValue() * 255));
+
+	double coverage = ImageKernels::sum(mask, numPixels) / (255.0 * numPixels);
+	if (invert->boolValue()) coverage = 1 - coverage;
+
+	sendNumber(coverageOut, coverage);
+	sendNumber(triggeredOut, coverage >= triggerCoverage->floatValue() ? 1 : 0);
+}
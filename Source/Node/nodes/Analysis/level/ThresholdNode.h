@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+	ThresholdNode.h
+	Created: 21 Oct 2026 12:05:44pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//How much of the image is brighter than a level, for presence detection
+class ThresholdNode :
+	public AnalysisNode
+{
+public:
+	ThresholdNode(var params = var());
+	~ThresholdNode();
+
+	FloatParameter* level;
+	BoolParameter* invert;
+	FloatParameter* triggerCoverage;
+
+	NodeConnectionSlot* coverageOut;
+	NodeConnectionSlot* triggeredOut;
+
+	HeapBlock<uint8> mask;
+	size_t maskSize;
+
+	void processFrame() override;
+
+	DECLARE_TYPE("Threshold")
+};
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+	MotionNode.cpp
+	Created: 21 Oct 2026 12:40:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+MotionNode::MotionNode(var params) :
+	AnalysisNode(getTypeString(), params),
+	previousSize(0),
+	hasPrevious(false),
+	maskSize(0)
+{
+	noiseLevel = addFloatParameter("Noise Level", "Changes smaller than this are camera noise, not motion", .1f, 0, 1);
+	triggerAmount = addFloatParameter("Trigger Amount", "Moving is on when at least this part of the image moved", .02f, 0, 1);
+
+	amountOut = addSlot("Amount", false, NODE_FLOAT);
+	xOut = addSlot("X", false, NODE_FLOAT);
+	yOut = addSlot("Y", false, NODE_FLOAT);
+	movingOut = addSlot("Moving", false, NODE_BOOL);
+}
+
+MotionNode::~MotionNode()
+{
+}
+
+void MotionNode::processFrame()
+{
+	int numPixels = frameWidth * frameHeight;
+
+	if (previousSize != (size_t)numPixels) hasPrevious = false;
+	ensureBuffer(previousLuma, previousSize);
+	ensureBuffer(mask, maskSize);
+
+	if (hasPrevious)
+	{
+		ImageKernels::absDiff(luma, previousLuma, mask, numPixels);
+		ImageKernels::threshold(mask, mask, numPixels, (uint8)jmax(1, roundToInt(noiseLevel->floatValue() * 255)));
+
+		Point<float> centroid;
+		uint64 mass = 0;
+		bool hasMotion = getCentroid(mask, frameWidth, frameHeight, centroid, mass);
+		double amount = mass / (255.0 * numPixels);
+
+		sendNumber(amountOut, amount);
+		if (hasMotion)
+		{
+			sendNumber(xOut, centroid.x);
+			sendNumber(yOut, centroid.y);
+		}
+		sendNumber(movingOut, amount >= triggerAmount->floatValue() ? 1 : 0);
+	}
+
+	//the current frame is the reference for the next one
+	luma.swapWith(previousLuma);
+	std::swap(lumaSize, previousSize);
+	hasPrevious = true;
+}
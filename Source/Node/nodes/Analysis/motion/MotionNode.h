@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+	MotionNode.h
+	Created: 21 Oct 2026 12:40:52pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Frame differencing : how much of the image moved since the previous frame, and where
+class MotionNode :
+	public AnalysisNode
+{
+public:
+	MotionNode(var params = var());
+	~MotionNode();
+
+	FloatParameter* noiseLevel;
+	FloatParameter* triggerAmount;
+
+	NodeConnectionSlot* amountOut;
+	NodeConnectionSlot* xOut;
+	NodeConnectionSlot* yOut;
+	NodeConnectionSlot* movingOut;
+
+	HeapBlock<uint8> previousLuma;
+	size_t previousSize;
+	bool hasPrevious;
+
+	HeapBlock<uint8> mask;
+	size_t maskSize;
+
+	void processFrame() override;
+
+	DECLARE_TYPE("Motion")
+};
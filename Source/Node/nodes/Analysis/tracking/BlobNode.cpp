@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+	BlobNode.cpp
+	Created: 21 Oct 2026 1:24:50pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+BlobNode::BlobNode(var params) :
+	AnalysisNode(getTypeString(), params),
+	maskSize(0)
+{
+	level = addFloatParameter("Level", "Pixels at least this bright are part of a blob", .5f, 0, 1);
+	invert = addBoolParameter("Invert", "Track dark blobs on a bright background instead", false);
+	minSize = addFloatParameter("Min Size", "Smaller blobs are ignored, relative to the image area", .002f, 0, .25f);
+	maxDistance = addFloatParameter("Max Distance", "How far a blob can move between two frames and still be the same blob, relative to the image", .2f, 0, 1);
+
+	countOut = addSlot("Count", false, NODE_INT);
+	for (int i = 0; i < BLOBNODE_MAX_TRACKED; i++)
+	{
+		String prefix = "Blob " + String(i + 1) + " ";
+		xOuts[i] = addSlot(prefix + "X", false, NODE_FLOAT);
+		yOuts[i] = addSlot(prefix + "Y", false, NODE_FLOAT);
+		sizeOuts[i] = addSlot(prefix + "Size", false, NODE_FLOAT);
+	}
+}
+
+BlobNode::~BlobNode()
+{
+}
+
+void BlobNode::processFrame()
+{
+	ensureBuffer(mask, maskSize);
+
+	int numPixels = frameWidth * frameHeight;
+	ImageKernels::threshold(luma, mask, numPixels, (uint8)roundToInt(level->floatValue() * 255));
+
+	if (invert->boolValue())
+	{
+		//the mask is 0 or 255, a bitwise not flips it
+		for (int i = 0; i < numPixels; i++) mask[i] = (uint8)~mask[i];
+	}
+
+	labelRuns();
+	collectBlobs();
+	trackBlobs();
+
+	sendNumber(countOut, blobs.size());
+	for (int i = 0; i < BLOBNODE_MAX_TRACKED; i++)
+	{
+		//lost blobs keep their last position, only their size drops to 0
+		const TrackedBlob& t = tracked[i];
+		sendNumber(xOuts[i], t.position.x);
+		sendNumber(yOuts[i], t.position.y);
+		sendNumber(sizeOuts[i], t.isActive ? t.size : 0);
+	}
+}
+
+void BlobNode::labelRuns()
+{
+	runs.clearQuick();
+	parents.clearQuick();
+
+	int previousStart = 0;
+	int previousEnd = 0;
+
+	for (int y = 0; y < frameHeight; y++)
+	{
+		const uint8* row = mask + (size_t)y * frameWidth;
+		int rowStart = runs.size();
+		int x = 0;
+
+		while (x < frameWidth)
+		{
+			x = ImageKernels::skipValue(row, x, frameWidth, 0);
+			if (x >= frameWidth) break;
+			int end = ImageKernels::skipValue(row, x, frameWidth, 255);
+
+			//8-connectivity, runs touching by a corner are connected too
+			int label = -1;
+			for (int r = previousStart; r < previousEnd; r++)
+			{
+				const Run& p = runs.getReference(r);
+				if (p.end < x) continue;
+				if (p.start > end) break;
+				label = label < 0 ? findRoot(p.label) : unite(label, p.label);
+			}
+
+			if (label < 0)
+			{
+				label = parents.size();
+				parents.add(label);
+			}
+
+			runs.add({ y, x, end, label });
+			x = end;
+		}
+
+		previousStart = rowStart;
+		previousEnd = runs.size();
+	}
+}
+
+void BlobNode::collectBlobs()
+{
+	labelBlobs.clearQuick();
+	labelBlobs.insertMultiple(0, Blob(), parents.size());
+
+	for (auto& r : runs)
+	{
+		Blob& b = labelBlobs.getReference(findRoot(r.label));
+		int length = r.end - r.start;
+		b.area += length;
+		b.xSum += (r.start + r.end - 1) * length * .5;
+		b.ySum += (double)r.y * length;
+	}
+
+	blobs.clearQuick();
+
+	double numPixels = (double)frameWidth * frameHeight;
+	int minArea = jmax(1, roundToInt(minSize->floatValue() * numPixels));
+
+	for (auto& b : labelBlobs)
+	{
+		if (b.area < minArea) continue;
+		b.position.setXY((float)((b.xSum / b.area + .5) / frameWidth), (float)((b.ySum / b.area + .5) / frameHeight));
+		b.size = (float)(b.area / numPixels);
+		blobs.add(b);
+	}
+
+	std::sort(blobs.begin(), blobs.end(), [](const Blob& a, const Blob& b) { return a.area > b.area; });
+}
+
+void BlobNode::trackBlobs()
+{
+	blobIsUsed.clearQuick();
+	blobIsUsed.insertMultiple(0, false, blobs.size());
+
+	//Greedy matching, closest pairs first
+	float maxDist = maxDistance->floatValue();
+	bool slotIsMatched[BLOBNODE_MAX_TRACKED]{};
+
+	while (true)
+	{
+		int bestSlot = -1;
+		int bestBlob = -1;
+		float bestDist = maxDist;
+
+		for (int i = 0; i < BLOBNODE_MAX_TRACKED; i++)
+		{
+			if (!tracked[i].isActive || slotIsMatched[i]) continue;
+			for (int j = 0; j < blobs.size(); j++)
+			{
+				if (blobIsUsed[j]) continue;
+				float d = tracked[i].position.getDistanceFrom(blobs.getReference(j).position);
+				if (d <= bestDist)
+				{
+					bestDist = d;
+					bestSlot = i;
+					bestBlob = j;
+				}
+			}
+		}
+
+		if (bestSlot < 0) break;
+
+		const Blob& b = blobs.getReference(bestBlob);
+		tracked[bestSlot].position = b.position;
+		tracked[bestSlot].size = b.size;
+		slotIsMatched[bestSlot] = true;
+		blobIsUsed.set(bestBlob, true);
+	}
+
+	for (int i = 0; i < BLOBNODE_MAX_TRACKED; i++) if (!slotIsMatched[i]) tracked[i].isActive = false;
+
+	//New blobs take the free outputs, biggest first
+	int nextBlob = 0;
+	for (int i = 0; i < BLOBNODE_MAX_TRACKED; i++)
+	{
+		if (tracked[i].isActive) continue;
+		while (nextBlob < blobs.size() && blobIsUsed[nextBlob]) nextBlob++;
+		if (nextBlob >= blobs.size()) break;
+
+		const Blob& b = blobs.getReference(nextBlob);
+		tracked[i].isActive = true;
+		tracked[i].position = b.position;
+		tracked[i].size = b.size;
+		blobIsUsed.set(nextBlob, true);
+	}
+}
+
+int BlobNode::findRoot(int label)
+{
+	while (parents[label] != label)
+	{
+		parents.set(label, parents[parents[label]]); //path halving
+		label = parents[label];
+	}
+	return label;
+}
+
+int BlobNode::unite(int a, int b)
+{
+	int ra = findRoot(a);
+	int rb = findRoot(b);
+	if (ra == rb) return ra;
+	if (ra < rb) std::swap(ra, rb);
+	parents.set(ra, rb);
+	return rb;
+}
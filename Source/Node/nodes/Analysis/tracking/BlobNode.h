@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+	BlobNode.h
+	Created: 21 Oct 2026 1:24:50pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#define BLOBNODE_MAX_TRACKED 4
+
+/*
+	Connected components of the thresholded image, labeled run by run with a union-find.
+	The biggest blobs are tracked from frame to frame by distance, so each output keeps following the same blob.
+*/
+class BlobNode :
+	public AnalysisNode
+{
+public:
+	BlobNode(var params = var());
+	~BlobNode();
+
+	FloatParameter* level;
+	BoolParameter* invert;
+	FloatParameter* minSize;
+	FloatParameter* maxDistance;
+
+	NodeConnectionSlot* countOut;
+	NodeConnectionSlot* xOuts[BLOBNODE_MAX_TRACKED];
+	NodeConnectionSlot* yOuts[BLOBNODE_MAX_TRACKED];
+	NodeConnectionSlot* sizeOuts[BLOBNODE_MAX_TRACKED];
+
+	struct Run
+	{
+		int y;
+		int start;
+		int end;
+		int label;
+	};
+
+	struct Blob
+	{
+		int area = 0;
+		double xSum = 0;
+		double ySum = 0;
+		Point<float> position;
+		float size = 0;
+	};
+
+	struct TrackedBlob
+	{
+		bool isActive = false;
+		Point<float> position;
+		float size = 0;
+	};
+
+	HeapBlock<uint8> mask;
+	size_t maskSize;
+
+	//Kept between frames so labeling doesn't allocate once it has seen a busy frame
+	Array<Run> runs;
+	Array<int> parents;
+	Array<Blob> labelBlobs;
+	Array<Blob> blobs;
+	Array<bool> blobIsUsed;
+	TrackedBlob tracked[BLOBNODE_MAX_TRACKED];
+
+	void processFrame() override;
+
+	void labelRuns();
+	void collectBlobs();
+	void trackBlobs();
+
+	int findRoot(int label);
+	int unite(int a, int b);
+
+	DECLARE_TYPE("Blobs")
+};
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+	CentroidNode.cpp
+	Created: 21 Oct 2026 1:02:36pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+CentroidNode::CentroidNode(var params) :
+	AnalysisNode(getTypeString(), params),
+	weightsSize(0)
+{
+	level = addFloatParameter("Level", "Pixels darker than this are ignored, 0 weights the whole image", 0, 0, 1);
+
+	xOut = addSlot("X", false, NODE_FLOAT);
+	yOut = addSlot("Y", false, NODE_FLOAT);
+	massOut = addSlot("Mass", false, NODE_FLOAT);
+}
+
+CentroidNode::~CentroidNode()
+{
+}
+
+void CentroidNode::processFrame()
+{
+	int numPixels = frameWidth * frameHeight;
+	const uint8* image = luma;
+
+	uint8 l = (uint8)roundToInt(level->floatValue() * 255);
+	if (l > 0)
+	{
+		ensureBuffer(weights, weightsSize);
+		ImageKernels::thresholdToZero(luma, weights, numPixels, l);
+		image = weights;
+	}
+
+	Point<float> centroid;
+	uint64 mass = 0;
+	if (getCentroid(image, frameWidth, frameHeight, centroid, mass))
+	{
+		sendNumber(xOut, centroid.x);
+		sendNumber(yOut, centroid.y);
+	}
+	sendNumber(massOut, mass / (255.0 * numPixels));
+}
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+	CentroidNode.h
+	Created: 21 Oct 2026 1:02:36pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Brightness weighted center of the image, follows a single light or a single person on a dark floor
+class CentroidNode :
+	public AnalysisNode
+{
+public:
+	CentroidNode(var params = var());
+	~CentroidNode();
+
+	FloatParameter* level;
+
+	NodeConnectionSlot* xOut;
+	NodeConnectionSlot* yOut;
+	NodeConnectionSlot* massOut;
+
+	HeapBlock<uint8> weights;
+	size_t weightsSize;
+
+	void processFrame() override;
+
+	DECLARE_TYPE("Centroid")
+};
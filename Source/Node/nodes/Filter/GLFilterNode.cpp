@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+	GLFilterNode.cpp
+	Created: 20 Oct 2026 4:02:55pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+using namespace juce::gl;
+
+GLFilterNode::GLFilterNode(StringRef name, var params) :
+	Node(name, FILTER, params),
+	shaderIsDirty(true)
+{
+	addInOutSlot(&inBuffer, &outBuffer, NODE_BUFFER, "In Buffer", "Out Buffer");
+}
+
+GLFilterNode::~GLFilterNode()
+{
+}
+
+bool GLFilterNode::renderGL(const Array<GLuint>& inputTextures, const Array<Point<int>>& inputSizes, Point<int> size)
+{
+	if (shaderIsDirty)
+	{
+		filterProgram.request(getFilterCode());
+		shaderIsDirty = false;
+	}
+
+	if (filterProgram.update(niceName)) initUniforms(filterProgram.uniforms.get(), String());
+
+	GLuint inputTexture = inputTextures.isEmpty() ? 0 : inputTextures[0];
+	Point<int> inputSize = inputSizes.isEmpty() ? size : inputSizes[0];
+	if (!filterProgram.use(inputTexture, inputSize, size)) return false;
+
+	setUniforms(filterProgram.uniforms.get());
+
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+	return true;
+}
+
+void GLFilterNode::releaseGL()
+{
+	filterProgram.reset();
+	shaderIsDirty = true;
+}
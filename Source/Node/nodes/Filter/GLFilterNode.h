@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+	GLFilterNode.h
+	Created: 20 Oct 2026 4:02:55pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+	Base for the nodes filtering a buffer with a fragment shader.
+	The code of the child classes is appended to a common header declaring the inputs :
+	inputTexture, inputSize, outputSize, time and the uv coordinates, and must write fragColor.
+
+	Pointwise filters only read their inputs at the pixel they write. They don't give a whole shader but a function,
+	vec4 $apply(vec4 c), and the NodeGraphRenderer fuses chains of them in one generated shader.
+	'$' is replaced by a prefix unique to the node in that shader, for the function and the node's uniforms.
+	Their extra buffer inputs are sampled at uv from $input1, $input2...
+*/
+class GLFilterNode :
+	public Node
+{
+public:
+	GLFilterNode(StringRef name, var params = var());
+	virtual ~GLFilterNode();
+
+	NodeConnectionSlot* inBuffer;
+	NodeConnectionSlot* outBuffer;
+
+	//Only used when the node is rendered on its own, fused nodes share the program of their chain
+	NodeFilterProgram filterProgram;
+	bool shaderIsDirty;
+
+	bool hasGLPass() const override { return true; }
+	bool renderGL(const Array<GLuint>& inputTextures, const Array<Point<int>>& inputSizes, Point<int> size) override;
+	void releaseGL() override;
+
+	virtual bool isPointwise() const { return false; }
+	virtual String getFilterCode() { return String(); }
+	virtual String getPointwiseCode() { return String(); }
+
+	//Prefix is empty when rendered on its own
+	virtual void initUniforms(ShaderUniformTable* table, const String& prefix) {}
+	virtual void setUniforms(ShaderUniformTable* table) {}
+};
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+	BlurNode.cpp
+	Created: 20 Oct 2026 4:27:10pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+BlurNode::BlurNode(var params) :
+	GLFilterNode(getTypeString(), params),
+	radiusIndex(-1)
+{
+	radius = addFloatParameter("Radius", "Blur radius, in pixels", 5, 0, 100);
+}
+
+BlurNode::~BlurNode()
+{
+}
+
+String BlurNode::getFilterCode()
+{
+	//Fixed 9x9 gaussian taps spread over the radius, the cost doesn't depend on it
+	return R"(
+		uniform float blurRadius;
+		void main() {
+			vec2 stepSize = blurRadius / 4.0 / inputSize;
+			vec4 sum = vec4(0.0);
+			float weightSum = 0.0;
+			for (int x = -4; x <= 4; x++)
+			{
+				for (int y = -4; y <= 4; y++)
+				{
+					float w = exp(-float(x * x + y * y) / 8.0);
+					sum += texture(inputTexture, uv + vec2(x, y) * stepSize) * w;
+					weightSum += w;
+				}
+			}
+			fragColor = sum / weightSum;
+		}
+	)";
+}
+
+void BlurNode::initUniforms(ShaderUniformTable* table, const String& prefix)
+{
+	radiusIndex = table->indexOf(prefix + "blurRadius");
+}
+
+void BlurNode::setUniforms(ShaderUniformTable* table)
+{
+	table->setFloat(radiusIndex, radius->floatValue());
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+	BlurNode.h
+	Created: 20 Oct 2026 4:27:10pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class BlurNode :
+	public GLFilterNode
+{
+public:
+	BlurNode(var params = var());
+	~BlurNode();
+
+	FloatParameter* radius;
+
+	int radiusIndex;
+
+	String getFilterCode() override;
+	void initUniforms(ShaderUniformTable* table, const String& prefix) override;
+	void setUniforms(ShaderUniformTable* table) override;
+
+	DECLARE_TYPE("Blur")
+};
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+	InvertNode.cpp
+	Created: 20 Oct 2026 6:52:40pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+InvertNode::InvertNode(var params) :
+	GLFilterNode(getTypeString(), params),
+	amountIndex(-1)
+{
+	amount = addFloatParameter("Amount", "How much the colors are inverted", 1, 0, 1);
+}
+
+InvertNode::~InvertNode()
+{
+}
+
+String InvertNode::getPointwiseCode()
+{
+	return R"(
+		uniform float $amount;
+		vec4 $apply(vec4 c) {
+			return vec4(mix(c.rgb, 1.0 - c.rgb, $amount), c.a);
+		}
+	)";
+}
+
+void InvertNode::initUniforms(ShaderUniformTable* table, const String& prefix)
+{
+	amountIndex = table->indexOf(prefix + "amount");
+}
+
+void InvertNode::setUniforms(ShaderUniformTable* table)
+{
+	table->setFloat(amountIndex, amount->floatValue());
+}
@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+	InvertNode.h
+	Created: 20 Oct 2026 6:52:40pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class InvertNode :
+	public GLFilterNode
+{
+public:
+	InvertNode(var params = var());
+	~InvertNode();
+
+	FloatParameter* amount;
+
+	int amountIndex;
+
+	bool isPointwise() const override { return true; }
+	String getPointwiseCode() override;
+	void initUniforms(ShaderUniformTable* table, const String& prefix) override;
+	void setUniforms(ShaderUniformTable* table) override;
+
+	DECLARE_TYPE("Invert")
+};
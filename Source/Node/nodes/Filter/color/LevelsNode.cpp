@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+	LevelsNode.cpp
+	Created: 20 Oct 2026 6:48:21pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+LevelsNode::LevelsNode(var params) :
+	GLFilterNode(getTypeString(), params),
+	inputBlackIndex(-1),
+	inputWhiteIndex(-1),
+	gammaIndex(-1),
+	outputBlackIndex(-1),
+	outputWhiteIndex(-1)
+{
+	inputBlack = addFloatParameter("Input Black", "Input level mapped to the output black", 0, 0, 1);
+	inputWhite = addFloatParameter("Input White", "Input level mapped to the output white", 1, 0, 1);
+	gamma = addFloatParameter("Gamma", "Midtones, higher is brighter", 1, .1f, 10);
+	outputBlack = addFloatParameter("Output Black", "Darkest output level", 0, 0, 1);
+	outputWhite = addFloatParameter("Output White", "Brightest output level", 1, 0, 1);
+}
+
+LevelsNode::~LevelsNode()
+{
+}
+
+String LevelsNode::getPointwiseCode()
+{
+	return R"(
+		uniform float $inputBlack;
+		uniform float $inputWhite;
+		uniform float $gamma;
+		uniform float $outputBlack;
+		uniform float $outputWhite;
+		vec4 $apply(vec4 c) {
+			vec3 v = clamp((c.rgb - $inputBlack) / max($inputWhite - $inputBlack, 0.0001), 0.0, 1.0);
+			v = pow(v, vec3(1.0 / $gamma));
+			return vec4(mix(vec3($outputBlack), vec3($outputWhite), v), c.a);
+		}
+	)";
+}
+
+void LevelsNode::initUniforms(ShaderUniformTable* table, const String& prefix)
+{
+	inputBlackIndex = table->indexOf(prefix + "inputBlack");
+	inputWhiteIndex = table->indexOf(prefix + "inputWhite");
+	gammaIndex = table->indexOf(prefix + "gamma");
+	outputBlackIndex = table->indexOf(prefix + "outputBlack");
+	outputWhiteIndex = table->indexOf(prefix + "outputWhite");
+}
+
+void LevelsNode::setUniforms(ShaderUniformTable* table)
+{
+	table->setFloat(inputBlackIndex, inputBlack->floatValue());
+	table->setFloat(inputWhiteIndex, inputWhite->floatValue());
+	table->setFloat(gammaIndex, gamma->floatValue());
+	table->setFloat(outputBlackIndex, outputBlack->floatValue());
+	table->setFloat(outputWhiteIndex, outputWhite->floatValue());
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+	LevelsNode.h
+	Created: 20 Oct 2026 6:48:21pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class LevelsNode :
+	public GLFilterNode
+{
+public:
+	LevelsNode(var params = var());
+	~LevelsNode();
+
+	FloatParameter* inputBlack;
+	FloatParameter* inputWhite;
+	FloatParameter* gamma;
+	FloatParameter* outputBlack;
+	FloatParameter* outputWhite;
+
+	int inputBlackIndex;
+	int inputWhiteIndex;
+	int gammaIndex;
+	int outputBlackIndex;
+	int outputWhiteIndex;
+
+	bool isPointwise() const override { return true; }
+	String getPointwiseCode() override;
+	void initUniforms(ShaderUniformTable* table, const String& prefix) override;
+	void setUniforms(ShaderUniformTable* table) override;
+
+	DECLARE_TYPE("Levels")
+};
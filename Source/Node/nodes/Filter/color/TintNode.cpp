@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+	TintNode.cpp
+	Created: 20 Oct 2026 4:20:37pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+TintNode::TintNode(var params) :
+	GLFilterNode(getTypeString(), params),
+	colorIndex(-1),
+	amountIndex(-1)
+{
+	color = addColorParameter("Color", "Color multiplied with the input", Colours::white);
+	amount = addFloatParameter("Amount", "How much of the tint is applied", 1, 0, 1);
+}
+
+TintNode::~TintNode()
+{
+}
+
+String TintNode::getPointwiseCode()
+{
+	return R"(
+		uniform vec4 $color;
+		uniform float $amount;
+		vec4 $apply(vec4 c) {
+			return mix(c, c * $color, $amount);
+		}
+	)";
+}
+
+void TintNode::initUniforms(ShaderUniformTable* table, const String& prefix)
+{
+	colorIndex = table->indexOf(prefix + "color");
+	amountIndex = table->indexOf(prefix + "amount");
+}
+
+void TintNode::setUniforms(ShaderUniformTable* table)
+{
+	Colour c = color->getColor();
+	GLfloat values[4] = { c.getFloatRed(), c.getFloatGreen(), c.getFloatBlue(), c.getFloatAlpha() };
+	table->setFloats(colorIndex, values, 4);
+	table->setFloat(amountIndex, amount->floatValue());
+}
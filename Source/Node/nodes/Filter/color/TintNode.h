@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+	TintNode.h
+	Created: 20 Oct 2026 4:20:37pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class TintNode :
+	public GLFilterNode
+{
+public:
+	TintNode(var params = var());
+	~TintNode();
+
+	ColorParameter* color;
+	FloatParameter* amount;
+
+	int colorIndex;
+	int amountIndex;
+
+	bool isPointwise() const override { return true; }
+	String getPointwiseCode() override;
+	void initUniforms(ShaderUniformTable* table, const String& prefix) override;
+	void setUniforms(ShaderUniformTable* table) override;
+
+	DECLARE_TYPE("Tint")
+};
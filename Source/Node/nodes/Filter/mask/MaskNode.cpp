@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+	MaskNode.cpp
+	Created: 20 Oct 2026 6:57:03pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Node/NodeIncludes.h"
+
+MaskNode::MaskNode(var params) :
+	GLFilterNode(getTypeString(), params),
+	channelIndex(-1),
+	invertIndex(-1)
+{
+	maskBuffer = addSlot("Mask", true, NODE_BUFFER);
+
+	channel = addEnumParameter("Channel", "Which channel of the mask is used");
+	channel->addOption("Luminance", LUMINANCE)->addOption("Alpha", ALPHA);
+	invert = addBoolParameter("Invert", "Hide what the mask shows, and show what it hides", false);
+}
+
+MaskNode::~MaskNode()
+{
+}
+
+String MaskNode::getPointwiseCode()
+{
+	return R"(
+		uniform sampler2D $input1;
+		uniform int $channel;
+		uniform int $invert;
+		vec4 $apply(vec4 c) {
+			vec4 m = texture($input1, uv);
+			float v = $channel == 0 ? dot(m.rgb, vec3(0.2126, 0.7152, 0.0722)) : m.a;
+			if ($invert == 1) v = 1.0 - v;
+			return vec4(c.rgb, c.a * v);
+		}
+	)";
+}
+
+void MaskNode::initUniforms(ShaderUniformTable* table, const String& prefix)
+{
+	channelIndex = table->indexOf(prefix + "channel");
+	invertIndex = table->indexOf(prefix + "invert");
+}
+
+void MaskNode::setUniforms(ShaderUniformTable* table)
+{
+	table->setInt(channelIndex, (int)channel->getValueDataAsEnum<MaskChannel>());
+	table->setInt(invertIndex, invert->boolValue() ? 1 : 0);
+}
@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+	MaskNode.h
+	Created: 20 Oct 2026 6:57:03pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class MaskNode :
+	public GLFilterNode
+{
+public:
+	MaskNode(var params = var());
+	~MaskNode();
+
+	enum MaskChannel { LUMINANCE, ALPHA };
+
+	NodeConnectionSlot* maskBuffer;
+
+	EnumParameter* channel;
+	BoolParameter* invert;
+
+	int channelIndex;
+	int invertIndex;
+
+	bool isPointwise() const override { return true; }
+	String getPointwiseCode() override;
+	void initUniforms(ShaderUniformTable* table, const String& prefix) override;
+	void setUniforms(ShaderUniformTable* table) override;
+
+	DECLARE_TYPE("Mask")
+};
@@ -8,4 +8,14 @@
   ==============================================================================
 */
 
-#include "OutputNode.h"
+#include "Node/NodeIncludes.h"
+
+OutputNode::OutputNode(var params) :
+    Node(getTypeString(), Node::OUTPUT, params)
+{
+    inBuffer = addSlot("In Buffer", true, NODE_BUFFER);
+}
+
+OutputNode::~OutputNode()
+{
+}
@@ -9,3 +9,16 @@
 */
 
 #pragma once
+
+//What is connected to this is drawn in the NodeMedia
+class OutputNode :
+    public Node
+{
+public:
+    OutputNode(var params = var());
+    ~OutputNode();
+
+    NodeConnectionSlot* inBuffer;
+
+    DECLARE_TYPE("Output")
+};
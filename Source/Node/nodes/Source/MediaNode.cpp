@@ -11,6 +11,8 @@
 #include "Node/NodeIncludes.h"
 #include "Media/MediaIncludes.h"
 
+#define MEDIANODE_TARGET_MEDIA_ID 0
+
 MediaNode::MediaNode(var params) :
 	Node(getTypeString(), Node::SOURCE)
 {
@@ -37,4 +39,36 @@ void MediaNode::processInternal()
 	Media* s = dynamic_cast<Media*>(source->targetContainer.get());
 
 	if (s == nullptr) return;
-}
\ No newline at end of file
+
+	sendBuffer(outBuffer, s->getFrameBuffer());
+}
+
+void MediaNode::onContainerParameterChangedInternal(Parameter* p)
+{
+	Node::onContainerParameterChangedInternal(p);
+
+	if (p == source)
+	{
+		if (Media* m = source->getTargetContainerAs<Media>()) registerUseMedia(MEDIANODE_TARGET_MEDIA_ID, m);
+		else unregisterUseMedia(MEDIANODE_TARGET_MEDIA_ID);
+	}
+	else if (p == enabled)
+	{
+		if (Media* m = source->getTargetContainerAs<Media>()) m->updateBeingUsed();
+	}
+}
+
+bool MediaNode::isUsingMedia(Media* m)
+{
+	if (!enabled->boolValue()) return false;
+	return MediaTarget::isUsingMedia(m);
+}
+
+GLuint MediaNode::getGLOutputTexture(Point<int>& size)
+{
+	Media* m = source->getTargetContainerAs<Media>();
+	if (m == nullptr || !m->frameBuffer.isValid()) return 0;
+
+	size = Point<int>(m->frameBuffer.getWidth(), m->frameBuffer.getHeight());
+	return m->getTextureID();
+}
@@ -11,7 +11,8 @@
 #pragma once
 
 class MediaNode :
-    public Node
+    public Node,
+    public MediaTarget
 {
 public:
     MediaNode(var params = var());
@@ -24,5 +25,11 @@ public:
     bool initInternal() override;
     void processInternal() override;
 
+    void onContainerParameterChangedInternal(Parameter* p) override;
+    bool isUsingMedia(Media* m) override;
+
+    bool providesGLTexture() const override { return true; }
+    GLuint getGLOutputTexture(Point<int>& size) override;
+
     DECLARE_TYPE("Media")
 };
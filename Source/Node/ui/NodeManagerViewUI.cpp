@@ -91,7 +91,7 @@ void NodeManagerViewUI::refreshStats()
 	if (inspectable.wasObjectDeleted()) return;
 	if (RootNodeManager* n = dynamic_cast<RootNodeManager*>(manager))
 	{
-		statsLabel.setText("Process : " + String(n->processTimeMS) + "ms - Framerate : " + String(n->averageFPS) + " fps (Max : " + String(n->maxFPS) + ")", dontSendNotification);
+		statsLabel.setText("Process : " + String(n->processTimeMS, 2) + "ms - Framerate : " + String(roundToInt(n->averageFPS)) + " fps (Max : " + String(n->maxFPS) + ")", dontSendNotification);
 	}
 }
 
@@ -167,7 +167,7 @@ void BaseNodeViewUI::viewFilterUpdated()
 void BaseNodeViewUI::refreshStats()
 {
 	if (inspectable.wasObjectDeleted()) return;
-	statsLabel.setText(String(item->processTimeMS) + "ms", dontSendNotification);
+	statsLabel.setText(String(item->averageProcessTimeMS, 2) + "ms", dontSendNotification);
 	//if (!item->miniMode->boolValue() && item->getPreviewImage().isValid()) repaint();
 }
 
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+	ScreenLatency.cpp
+	Created: 19 Oct 2026 6:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+LatencyRoute::LatencyRoute(Media* media) :
+	ControllableContainer(media->niceName),
+	media(media),
+	mediaRef(media)
+{
+	samples = addIntParameter("Samples", "Number of input frames measured", 0, 0);
+	uploadMean = addFloatParameter("Arrival to Upload", "Mean time between the frame arrival and its texture upload", 0, 0);
+	drawMean = addFloatParameter("Upload to Draw", "Mean time between the texture upload and the surface draw", 0, 0);
+	presentMean = addFloatParameter("Draw to Present", "Mean time between the surface draw and the output present", 0, 0);
+	totalMean = addFloatParameter("Total Mean", "Mean time between the frame arrival and the output present", 0, 0);
+	totalP50 = addFloatParameter("Total P50", "Median total latency", 0, 0);
+	totalP95 = addFloatParameter("Total P95", "95th percentile of the total latency", 0, 0);
+	totalP99 = addFloatParameter("Total P99", "99th percentile of the total latency", 0, 0);
+	totalMax = addFloatParameter("Total Max", "Worst total latency", 0, 0);
+
+	for (auto& c : controllables)
+	{
+		c->setControllableFeedbackOnly(true);
+		if (Parameter* p = dynamic_cast<Parameter*>(c)) p->isSavable = false;
+	}
+}
+
+void LatencyRoute::addSample(const FrameTiming& t)
+{
+	if (t.uploadTime >= 0)
+	{
+		uploadHistogram.add(t.uploadTime - t.arrivalTime);
+		drawHistogram.add(t.drawTime - t.uploadTime);
+	}
+	presentHistogram.add(t.presentTime - t.drawTime);
+	totalHistogram.add(t.presentTime - t.arrivalTime);
+}
+
+void LatencyRoute::updateParameters()
+{
+	samples->setValue(totalHistogram.count);
+	uploadMean->setValue(uploadHistogram.getMean());
+	drawMean->setValue(drawHistogram.getMean());
+	presentMean->setValue(presentHistogram.getMean());
+	totalMean->setValue(totalHistogram.getMean());
+	totalP50->setValue(totalHistogram.getPercentile(.5));
+	totalP95->setValue(totalHistogram.getPercentile(.95));
+	totalP99->setValue(totalHistogram.getPercentile(.99));
+	totalMax->setValue(totalHistogram.maxValue);
+}
+
+
+
+ScreenLatency::ScreenLatency() :
+	EnablingControllableContainer("Latency")
+{
+	resetTrigger = addTrigger("Reset", "Clear the measures");
+
+	enabled->setDefaultValue(false);
+	editorIsCollapsed = true;
+}
+
+ScreenLatency::~ScreenLatency()
+{
+	stopTimer();
+}
+
+void ScreenLatency::addDrawnFrame(Media* m)
+{
+	if (m == nullptr || !enabled->boolValue()) return;
+
+	const FrameTiming& t = m->frameTiming;
+	if (t.arrivalTime < 0) return; //not an input, or nothing received yet
+
+	//Only the first draw of each input frame counts, the next ones are just repeats
+	bool isRepeat = (lastDrawnArrival.contains(m) && lastDrawnArrival[m] == t.arrivalTime)
+		|| (drawnArrival.contains(m) && drawnArrival[m] == t.arrivalTime);
+	drawnArrival.set(m, t.arrivalTime);
+	if (isRepeat) return;
+
+	//the media is alive while its surface draws it, the weak reference tells the timer if it still is
+	Sample s{ m, m, t };
+	s.timing.drawTime = Time::getMillisecondCounterHiRes();
+
+	GenericScopedLock lock(sampleLock);
+	if (drawnSamples.size() > 256) drawnSamples.clear(); //nobody presents this screen
+	drawnSamples.add(s);
+}
+
+void ScreenLatency::endDrawnFrames()
+{
+	lastDrawnArrival.swapWith(drawnArrival);
+	drawnArrival.clear();
+}
+
+void ScreenLatency::markPresented()
+{
+	if (!enabled->boolValue()) return;
+
+	double t = Time::getMillisecondCounterHiRes();
+
+	GenericScopedLock lock(sampleLock);
+	for (auto& s : drawnSamples)
+	{
+		s.timing.presentTime = t;
+		presentedSamples.add(s);
+	}
+	drawnSamples.clearQuick();
+}
+
+void ScreenLatency::onContainerParameterChanged(Parameter* p)
+{
+	EnablingControllableContainer::onContainerParameterChanged(p);
+	if (p == enabled)
+	{
+		if (enabled->boolValue()) startTimerHz(4);
+		else stopTimer();
+	}
+}
+
+void ScreenLatency::onContainerTriggerTriggered(Trigger* t)
+{
+	EnablingControllableContainer::onContainerTriggerTriggered(t);
+	if (t == resetTrigger) clearRoutes();
+}
+
+void ScreenLatency::timerCallback()
+{
+	Array<Sample> samplesToProcess;
+	{
+		GenericScopedLock lock(sampleLock);
+		samplesToProcess.swapWith(presentedSamples);
+	}
+
+	//a new media allocated where a deleted one was must not inherit its route
+	for (int i = routes.size() - 1; i >= 0; i--)
+	{
+		if (!routes[i]->mediaRef.wasObjectDeleted()) continue;
+		removeChildControllableContainer(routes[i]);
+		routes.remove(i);
+	}
+
+	if (samplesToProcess.isEmpty()) return;
+
+	Array<LatencyRoute*> updatedRoutes;
+	for (auto& s : samplesToProcess)
+	{
+		if (s.mediaRef.wasObjectDeleted()) continue;
+		LatencyRoute* r = getRouteForMedia(s.media);
+		r->addSample(s.timing);
+		updatedRoutes.addIfNotAlreadyThere(r);
+	}
+
+	for (auto& r : updatedRoutes)
+	{
+		if (r->niceName != r->media->niceName) r->setNiceName(r->media->niceName);
+		r->updateParameters();
+	}
+}
+
+void ScreenLatency::clearRoutes()
+{
+	{
+		GenericScopedLock lock(sampleLock);
+		drawnSamples.clear();
+		presentedSamples.clear();
+	}
+
+	for (auto& r : routes) removeChildControllableContainer(r);
+	routes.clear();
+}
+
+LatencyRoute* ScreenLatency::getRouteForMedia(Media* m)
+{
+	for (auto& r : routes) if (r->media == m) return r;
+
+	LatencyRoute* r = routes.add(new LatencyRoute(m));
+	addChildControllableContainer(r);
+	return r;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+	ScreenLatency.h
+	Created: 19 Oct 2026 6:12:08pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+//Latency from one input media to this screen, in milliseconds. Keyed by the media, its name is only shown.
+class LatencyRoute :
+	public ControllableContainer
+{
+public:
+	LatencyRoute(Media* media);
+	~LatencyRoute() {}
+
+	Media* media;
+	WeakReference<Inspectable> mediaRef;
+
+	IntParameter* samples;
+	FloatParameter* uploadMean;
+	FloatParameter* drawMean;
+	FloatParameter* presentMean;
+	FloatParameter* totalMean;
+	FloatParameter* totalP50;
+	FloatParameter* totalP95;
+	FloatParameter* totalP99;
+	FloatParameter* totalMax;
+
+	LatencyHistogram uploadHistogram;
+	LatencyHistogram drawHistogram;
+	LatencyHistogram presentHistogram;
+	LatencyHistogram totalHistogram;
+
+	void addSample(const FrameTiming& t);
+	void updateParameters();
+};
+
+class ScreenLatency :
+	public EnablingControllableContainer,
+	public Timer
+{
+public:
+	ScreenLatency();
+	~ScreenLatency();
+
+	Trigger* resetTrigger;
+	OwnedArray<LatencyRoute> routes;
+
+	struct Sample
+	{
+		Media* media;
+		WeakReference<Inspectable> mediaRef;
+		FrameTiming timing;
+	};
+
+	//Filled from the GL threads, drained by the timer
+	CriticalSection sampleLock;
+	Array<Sample> drawnSamples;
+	Array<Sample> presentedSamples;
+
+	//GL thread of the renderer. Arrivals of the medias drawn in the previous and in the current frame, medias no longer drawn are dropped.
+	HashMap<Media*, double> lastDrawnArrival;
+	HashMap<Media*, double> drawnArrival;
+
+	//GL thread of the renderer, right after a surface has been drawn
+	void addDrawnFrame(Media* m);
+	void endDrawnFrames();
+
+	//GL thread of whoever sends the frame out, right before the swap or after the send
+	void markPresented();
+
+	void onContainerParameterChanged(Parameter* p) override;
+	void onContainerTriggerTriggered(Trigger* t) override;
+	void timerCallback() override;
+
+	void clearRoutes();
+	LatencyRoute* getRouteForMedia(Media* m);
+};
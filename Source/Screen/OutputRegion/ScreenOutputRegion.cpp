@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+	ScreenOutputRegion.cpp
+	Created: 19 Oct 2026 7:02:41pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+ScreenOutputRegion::ScreenOutputRegion(Screen* screen) :
+	BaseItem("Output Region"),
+	screen(screen),
+	edgeBlendCC("Edge Blend"),
+	sharedTextureSender(nullptr)
+{
+	saveAndLoadRecursiveData = true;
+
+	outputType = addEnumParameter("Output type", "Output type");
+	outputType->addOption("Display", Screen::DISPLAY)->addOption("Shared Texture", Screen::SHARED_TEXTURE)->addOption("NDI", Screen::NDI);
+
+	screenID = addIntParameter("Screen number", "Screen ID in your OS, for display outputs", 1, 0);
+
+	regionX = addIntParameter("X", "Left of the region in the screen's canvas, in pixels", 0, 0);
+	regionY = addIntParameter("Y", "Top of the region in the screen's canvas, in pixels", 0, 0);
+	regionWidth = addIntParameter("Width", "Width of the region in pixels", 1920, 1, 10000);
+	regionHeight = addIntParameter("Height", "Height of the region in pixels", 1080, 1, 10000);
+
+	blendLeft = edgeBlendCC.addIntParameter("Left", "Width of the left overlap in pixels", 0, 0);
+	blendRight = edgeBlendCC.addIntParameter("Right", "Width of the right overlap in pixels", 0, 0);
+	blendTop = edgeBlendCC.addIntParameter("Top", "Height of the top overlap in pixels", 0, 0);
+	blendBottom = edgeBlendCC.addIntParameter("Bottom", "Height of the bottom overlap in pixels", 0, 0);
+	blendGamma = edgeBlendCC.addFloatParameter("Gamma", "Gamma of the projectors, compensates the blend ramp so overlaps add up to a flat brightness", 2.2f, .5f, 4);
+	edgeBlendCC.enabled->setDefaultValue(false);
+	edgeBlendCC.editorIsCollapsed = true;
+	addChildControllableContainer(&edgeBlendCC);
+	addChildControllableContainer(&presentStats);
+}
+
+ScreenOutputRegion::~ScreenOutputRegion()
+{
+	if (frameBuffer.isValid() && GlContextHolder::getInstanceWithoutCreating() != nullptr)
+	{
+		GlContextHolder::getInstance()->context.executeOnGLThread([this](OpenGLContext&) { releaseGL(); }, true);
+	}
+}
+
+void ScreenOutputRegion::clearItem()
+{
+	BaseItem::clearItem();
+	removeOutputs();
+}
+
+void ScreenOutputRegion::onContainerParameterChangedInternal(Parameter* p)
+{
+	if (p == outputType)
+	{
+		setupOutput();
+	}
+
+	if (sharedTextureSender != nullptr)
+	{
+		if (p == enabled) sharedTextureSender->setEnabled(enabled->boolValue());
+		else if (p == regionWidth || p == regionHeight) sharedTextureSender->setSize(regionWidth->intValue(), regionHeight->intValue());
+	}
+}
+
+void ScreenOutputRegion::onContainerNiceNameChanged()
+{
+	BaseItem::onContainerNiceNameChanged();
+	updateOutputName();
+}
+
+void ScreenOutputRegion::updateOutputName()
+{
+	if (sharedTextureSender != nullptr) sharedTextureSender->setSharingName(getOutputName());
+	if (ndiOutput != nullptr) setupOutput(); //NDI senders can't be renamed, recreate it
+}
+
+void ScreenOutputRegion::setupOutput()
+{
+	removeOutputs();
+
+	switch (outputType->getValueDataAsEnum<Screen::OutputType>())
+	{
+	case Screen::DISPLAY:
+		break;
+
+	case Screen::SHARED_TEXTURE:
+		sharedTextureSender = SharedTextureManager::getInstance()->addSender(getOutputName(), regionWidth->intValue(), regionHeight->intValue());
+		sharedTextureSender->setExternalFBO(&frameBuffer);
+		break;
+
+	case Screen::NDI:
+	{
+		std::unique_ptr<NDIOutput> o(new NDIOutput(getOutputName()));
+		GenericScopedLock lock(ndiOutputLock);
+		ndiOutput.swap(o);
+	}
+	break;
+	}
+}
+
+void ScreenOutputRegion::removeOutputs()
+{
+	if (SharedTextureManager::getInstanceWithoutCreating() != nullptr) SharedTextureManager::getInstance()->removeSender(sharedTextureSender);
+	sharedTextureSender = nullptr;
+
+	std::unique_ptr<NDIOutput> o;
+	{
+		GenericScopedLock lock(ndiOutputLock);
+		o.swap(ndiOutput);
+	}
+
+	//deleted outside of the lock, it waits for the GL thread to release its buffers
+	o.reset();
+}
+
+String ScreenOutputRegion::getOutputName() const
+{
+	if (screen == nullptr) return niceName;
+	return screen->niceName + " - " + niceName;
+}
+
+Rectangle<int> ScreenOutputRegion::getCanvasRegion(int canvasWidth, int canvasHeight) const
+{
+	Rectangle<int> r(regionX->intValue(), regionY->intValue(), regionWidth->intValue(), regionHeight->intValue());
+	return r.getIntersection(Rectangle<int>(0, 0, canvasWidth, canvasHeight));
+}
+
+bool ScreenOutputRegion::hasEdgeBlend() const
+{
+	if (!edgeBlendCC.enabled->boolValue()) return false;
+	return blendLeft->intValue() > 0 || blendRight->intValue() > 0 || blendTop->intValue() > 0 || blendBottom->intValue() > 0;
+}
+
+void ScreenOutputRegion::releaseGL()
+{
+	frameBuffer.release();
+
+	GenericScopedLock lock(ndiOutputLock);
+	if (ndiOutput != nullptr) ndiOutput->releaseGL();
+}
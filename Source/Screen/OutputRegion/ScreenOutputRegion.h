@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+	ScreenOutputRegion.h
+	Created: 19 Oct 2026 7:02:41pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class Screen;
+
+/*
+	A sub-rectangle of a screen's canvas sent to its own output.
+	The canvas is rendered once, each region takes its part of it, with an optional edge blend on the overlapping borders.
+*/
+class ScreenOutputRegion :
+	public BaseItem
+{
+public:
+	ScreenOutputRegion(Screen* screen = nullptr);
+	virtual ~ScreenOutputRegion();
+
+	Screen* screen;
+
+	EnumParameter* outputType;
+	IntParameter* screenID;
+
+	IntParameter* regionX;
+	IntParameter* regionY;
+	IntParameter* regionWidth;
+	IntParameter* regionHeight;
+
+	EnablingControllableContainer edgeBlendCC;
+	IntParameter* blendLeft;
+	IntParameter* blendRight;
+	IntParameter* blendTop;
+	IntParameter* blendBottom;
+	FloatParameter* blendGamma;
+
+	PresentStats presentStats;
+
+	SharedTextureSender* sharedTextureSender;
+
+	CriticalSection ndiOutputLock;
+	std::unique_ptr<NDIOutput> ndiOutput;
+
+	//Only used by shared texture and NDI outputs, display outputs draw from the canvas directly
+	OpenGLFrameBuffer frameBuffer;
+
+	void clearItem() override;
+
+	void onContainerParameterChangedInternal(Parameter* p) override;
+	void onContainerNiceNameChanged() override;
+
+	void setupOutput();
+	void removeOutputs();
+	void updateOutputName();
+	String getOutputName() const;
+
+	//Clipped to the canvas, y from the top
+	Rectangle<int> getCanvasRegion(int canvasWidth, int canvasHeight) const;
+	bool hasEdgeBlend() const;
+
+	void releaseGL();
+
+	String getTypeString() const override { return "Output Region"; }
+};
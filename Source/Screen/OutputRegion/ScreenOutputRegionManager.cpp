@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+	ScreenOutputRegionManager.cpp
+	Created: 19 Oct 2026 7:02:41pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#include "Screen/ScreenIncludes.h"
+
+ScreenOutputRegionManager::ScreenOutputRegionManager(Screen* screen) :
+	BaseManager("Output Regions"),
+	screen(screen)
+{
+	itemDataType = "Output Region";
+	selectItemWhenCreated = false;
+	editorIsCollapsed = true;
+}
+
+ScreenOutputRegionManager::~ScreenOutputRegionManager()
+{
+}
+
+ScreenOutputRegion* ScreenOutputRegionManager::createItem()
+{
+	return new ScreenOutputRegion(screen);
+}
+
+void ScreenOutputRegionManager::addItemInternal(ScreenOutputRegion* r, var data)
+{
+	//the first region takes over the screen's own output
+	if (items.size() == 1) screen->setupOutput();
+}
+
+void ScreenOutputRegionManager::removeItemInternal(ScreenOutputRegion* r)
+{
+	r->removeOutputs();
+	if (items.isEmpty()) screen->setupOutput();
+}
@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+	ScreenOutputRegionManager.h
+	Created: 19 Oct 2026 7:02:41pm
+	Author:  bkupe
+
+  ==============================================================================
+*/
+
+#pragma once
+
+class ScreenOutputRegionManager :
+	public BaseManager<ScreenOutputRegion>
+{
+public:
+	ScreenOutputRegionManager(Screen* screen);
+	~ScreenOutputRegionManager();
+
+	Screen* screen;
+
+	ScreenOutputRegion* createItem() override;
+	void addItemInternal(ScreenOutputRegion* r, var data) override;
+	void removeItemInternal(ScreenOutputRegion* r) override;
+};
@@ -15,7 +15,12 @@ Screen::Screen(var params) :
 	objectType(params.getProperty("type", "Screen").toString()),
 	objectData(params),
 	sharedTextureSender(nullptr),
-	positionCC("Positionning")
+	isRenderingDirect(false),
+	numEditorViews(0),
+	positionCC("Positionning"),
+	colorCorrection("Color Correction"),
+	recorder("Recorder"),
+	outputRegions(this)
 {
 	saveAndLoadRecursiveData = true;
 
@@ -33,14 +38,21 @@ Screen::Screen(var params) :
 	outputType->addOption("Display", DISPLAY)->addOption("Shared Texture", SHARED_TEXTURE)->addOption("NDI", NDI);
 
 	screenID = addIntParameter("Screen number", "Screen ID in your OS", 1, 0);
+	directRender = addBoolParameter("Direct Render", "Lower latency, the output window draws the surfaces directly instead of copying the screen's framebuffer. Only used with a Display output, when the screen is not shown in the editor nor recorded", false);
 
 	showTestPattern = addBoolParameter("Show Test Pattern", "Show a test pattern on the screen", false);
 
 	snapDistance = addFloatParameter("Snap distance", "Distance in pixels to snap to another point", .05f, 0, .2f);
 
+	addChildControllableContainer(&colorCorrection);
+	addChildControllableContainer(&recorder);
+	addChildControllableContainer(&latency);
+	addChildControllableContainer(&presentStats);
+
 	if (!Engine::mainEngine->isLoadingFile) surfaces.addItem(nullptr, var(), false);
 
 	addChildControllableContainer(&surfaces);
+	addChildControllableContainer(&outputRegions);
 
 	renderer.reset(new ScreenRenderer(this));
 }
@@ -57,6 +69,9 @@ void Screen::clearItem()
 	if (SharedTextureManager::getInstanceWithoutCreating() != nullptr) SharedTextureManager::getInstance()->removeSender(sharedTextureSender);
 	sharedTextureSender = nullptr;
 
+	removeNDIOutput();
+	for (auto& r : outputRegions.items) r->removeOutputs();
+
 	//enabled->setValue(false);
 }
 
@@ -78,6 +93,8 @@ void Screen::onContainerNiceNameChanged()
 {
 	BaseItem::onContainerNiceNameChanged();
 	if (sharedTextureSender != nullptr) sharedTextureSender->setSharingName(niceName);
+	if (ndiOutput != nullptr) setupOutput(); //NDI senders can't be renamed, recreate it
+	for (auto& r : outputRegions.items) r->updateOutputName();
 }
 
 void Screen::setupOutput()
@@ -85,6 +102,10 @@ void Screen::setupOutput()
 	SharedTextureManager::getInstance()->removeSender(sharedTextureSender);
 	sharedTextureSender = nullptr;
 
+	removeNDIOutput();
+
+	if (isMultiOutput()) return;
+
 	OutputType type = outputType->getValueDataAsEnum<OutputType>();
 	switch (type)
 	{
@@ -97,8 +118,55 @@ void Screen::setupOutput()
 		break;
 
 	case NDI:
-		break;
+	{
+		std::unique_ptr<NDIOutput> o(new NDIOutput(niceName));
+		GenericScopedLock lock(ndiOutputLock);
+		ndiOutput.swap(o);
+	}
+	break;
+	}
+}
+
+void Screen::removeNDIOutput()
+{
+	std::unique_ptr<NDIOutput> o;
+	{
+		GenericScopedLock lock(ndiOutputLock);
+		o.swap(ndiOutput);
+	}
+
+	//deleted outside of the lock, it waits for the GL thread to release its buffers
+	o.reset();
+}
+
+bool Screen::canRenderDirect()
+{
+	if (!directRender->boolValue() || !enabled->boolValue()) return false;
+
+	if (isMultiOutput())
+	{
+		//every region has to be a plain window, blends and senders read the canvas
+		for (auto& r : outputRegions.items)
+		{
+			if (!r->enabled->boolValue()) continue;
+			if (r->outputType->getValueDataAsEnum<OutputType>() != DISPLAY || r->hasEdgeBlend()) return false;
+		}
+	}
+	else if (outputType->getValueDataAsEnum<OutputType>() != DISPLAY) return false;
+
+	//anything else reading the framebuffer needs it to be rendered
+	return numEditorViews == 0 && !recorder.isRecording;
+}
+
+bool Screen::hasDisplayOutput()
+{
+	if (!isMultiOutput()) return outputType->getValueDataAsEnum<OutputType>() == DISPLAY;
+
+	for (auto& r : outputRegions.items)
+	{
+		if (r->enabled->boolValue() && r->outputType->getValueDataAsEnum<OutputType>() == DISPLAY) return true;
 	}
+	return false;
 }
 
 Point2DParameter* Screen::getClosestHandle(Point<float> pos, float maxDistance, Array<Point2DParameter*> excludeHandles)
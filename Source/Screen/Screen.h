@@ -31,21 +31,43 @@ public:
     enum OutputType { DISPLAY, SHARED_TEXTURE, NDI };
     EnumParameter* outputType;
     IntParameter* screenID;
+    BoolParameter* directRender;
 
     BoolParameter* showTestPattern;
     FloatParameter* snapDistance;
 
+    ColorCorrection colorCorrection;
+    FrameRecorder recorder;
+    ScreenLatency latency;
+    PresentStats presentStats;
+
     SurfaceManager surfaces;
 
+    //When not empty, the canvas is split to these outputs and the screen's own output is not used
+    ScreenOutputRegionManager outputRegions;
+
     std::unique_ptr<ScreenRenderer> renderer;
     SharedTextureSender* sharedTextureSender;
 
+    CriticalSection ndiOutputLock;
+    std::unique_ptr<NDIOutput> ndiOutput;
+
+    //Direct render : the output window draws the surfaces itself and the renderer's framebuffer is skipped
+    std::atomic<bool> isRenderingDirect;
+    std::atomic<int> numEditorViews;
+    CriticalSection surfaceDrawLock;
+
     void clearItem() override;
 
     void onContainerParameterChangedInternal(Parameter* p) override;
     void onContainerNiceNameChanged() override;
 
     void setupOutput();
+    void removeNDIOutput();
+    bool canRenderDirect();
+
+    bool isMultiOutput() const { return !outputRegions.items.isEmpty(); }
+    bool hasDisplayOutput();
     
     Point2DParameter* getClosestHandle(Point<float> pos, float maxDistance = INT32_MAX, Array<Point2DParameter*> excludeHandles = {});
     Point2DParameter* getSnapHandle(Point<float> pos, Point2DParameter* handle);
@@ -11,6 +11,9 @@
 
 #include "ScreenIncludes.h"
 
+#include "Latency/ScreenLatency.cpp"
+#include "OutputRegion/ScreenOutputRegion.cpp"
+#include "OutputRegion/ScreenOutputRegionManager.cpp"
 #include "Screen.cpp"
 #include "ScreenManager.cpp"
 #include "ui/ScreenRenderer.cpp"
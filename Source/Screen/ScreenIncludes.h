@@ -17,6 +17,11 @@
 #include "Surface/Surface.h"
 #include "Surface/SurfaceManager.h"
 
+#include "Latency/ScreenLatency.h"
+
+#include "OutputRegion/ScreenOutputRegion.h"
+#include "OutputRegion/ScreenOutputRegionManager.h"
+
 #include "Screen.h"
 #include "ScreenManager.h"
 
@@ -16,6 +16,8 @@
 #define SURFACE_TARGET_MASK_ID 1
 #define SURFACE_PATTERN_ID 2
 
+#define SURFACE_LUT_TEXTURE_UNIT 2
+
 Surface::Surface(var params) :
 	BaseItem(params.getProperty("name", "Surface")),
 	positionningCC("Positionning"),
@@ -23,6 +25,7 @@ Surface::Surface(var params) :
 	adjustmentsCC("Adjustments"),
 	formatCC("Aspect Ratio"),
 	pinsCC("Pins"),
+	colorCorrection("Color Correction"),
 	objectType(params.getProperty("type", "Surface").toString()),
 	objectData(params),
 	previewMedia(nullptr),
@@ -175,6 +178,7 @@ Surface::Surface(var params) :
 	addChildControllableContainer(&positionningCC);
 	addChildControllableContainer(&adjustmentsCC);
 	addChildControllableContainer(&formatCC);
+	addChildControllableContainer(&colorCorrection);
 	addChildControllableContainer(&pinsCC);
 
 	if (!Engine::mainEngine->isLoadingFile)
@@ -855,6 +859,8 @@ void Surface::draw(GLuint shaderID)
 	float boostValue = boost->floatValue();
 	glUniform4f(tintLocation, tintColor.getFloatRed() * boostValue, tintColor.getFloatGreen() * boostValue, tintColor.getFloatBlue() * boostValue, tintColor.getFloatAlpha());
 
+	colorCorrection.setUniforms(shaderID, "surface", SURFACE_LUT_TEXTURE_UNIT);
+
 	glEnableVertexAttribArray(posAttrib);
 	glGetError();
 
@@ -886,6 +892,8 @@ void Surface::draw(GLuint shaderID)
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	//glDeleteBuffers(1, &vbo);
 
+	colorCorrection.unbindTexture(SURFACE_LUT_TEXTURE_UNIT);
+
 	glActiveTexture(GL_TEXTURE1);
 	glDisable(GL_TEXTURE_2D);
 	glBindTexture(GL_TEXTURE_2D, 0);
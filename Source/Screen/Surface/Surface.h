@@ -62,6 +62,8 @@ public:
 	ColorParameter* tint;
 	FloatParameter* boost;
 
+	ColorCorrection colorCorrection;
+
 	BoolParameter* showTestPattern;
 	TargetParameter* mask;
 	BoolParameter* invertMask;
@@ -53,12 +53,20 @@ void ScreenEditorPanel::setScreen(Screen* s)
 {
 	if (screen == s) return;
 
-	if (screen != nullptr) screen->removeInspectableListener(this);
+	if (screen != nullptr && !screenRef.wasObjectDeleted())
+	{
+		screen->removeInspectableListener(this);
+		screen->numEditorViews--;
+	}
 
 	screen = s;
 	screenRef = s;
 
-	if (screen != nullptr) screen->addInspectableListener(this);
+	if (screen != nullptr)
+	{
+		screen->addInspectableListener(this);
+		screen->numEditorViews++;
+	}
 
 	ScreenManager::getInstance()->editingScreen = screen;
 	setCustomName("Screen Editor " + String(screen != nullptr ? " : " + screen->niceName : ""));
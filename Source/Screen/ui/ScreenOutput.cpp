@@ -10,18 +10,24 @@
 
 #include "Screen/ScreenIncludes.h"
 #include "Common/CommonIncludes.h"
+#include "Engine/MGEngine.h"
 #include "ScreenOutput.h"
 
 juce_ImplementSingleton(ScreenOutputWatcher)
 
 using namespace juce::gl;
 
-ScreenOutput::ScreenOutput(Screen* screen) :
+ScreenOutput::ScreenOutput(Screen* screen, ScreenOutputRegion* region) :
 	InspectableContentComponent(screen),
 	OpenGLSharedRenderer(this),
 	isLive(false),
 	screen(screen),
-	timeAtRender(0)
+	region(region),
+	regionRef(region),
+	timeAtRender(0),
+	isSynced(false),
+	isInSwapGroup(false),
+	swapGroupFailed(false)
 {
 	autoDrawContourWhenSelected = false;
 
@@ -31,6 +37,8 @@ ScreenOutput::ScreenOutput(Screen* screen) :
 
 ScreenOutput::~ScreenOutput()
 {
+	if (!inspectable.wasObjectDeleted()) screen->isRenderingDirect = false;
+	if (GlContextHolder::getInstanceWithoutCreating() != nullptr) GlContextHolder::getInstance()->presentBarrier.removeParticipant(this);
 	removeFromDesktop();
 }
 
@@ -38,11 +46,14 @@ ScreenOutput::~ScreenOutput()
 void ScreenOutput::update()
 {
 	bool shouldShow = !inspectable.wasObjectDeleted() && screen->enabled->boolValue();
+	if (region != nullptr) shouldShow &= !regionRef.wasObjectDeleted() && region->enabled->boolValue();
+
+	int displayID = shouldShow ? (region != nullptr ? region->screenID->intValue() : screen->screenID->intValue()) : 0;
 
 	Displays ds = Desktop::getInstance().getDisplays();
-	if (screen->screenID->intValue() >= ds.displays.size())
+	if (displayID >= ds.displays.size())
 	{
-		LOGWARNING("Display #" << screen->screenID->intValue() << " is not available(" + ds.displays.size() << " screens connected)");
+		LOGWARNING("Display #" << displayID << " is not available(" + ds.displays.size() << " screens connected)");
 		shouldShow = false;
 	}
 
@@ -51,10 +62,10 @@ void ScreenOutput::update()
 
 	if (shouldShow)
 	{
-		Displays::Display d = ds.displays[screen->screenID->intValue()];
+		Displays::Display d = ds.displays[displayID];
 
 		Rectangle<int> a = d.totalArea;
-		if (screen->positionCC.enabled->boolValue())
+		if (region == nullptr && screen->positionCC.enabled->boolValue())
 		{
 			a.setX(a.getX() + screen->screenX->intValue());
 			a.setY(a.getY() + screen->screenY->intValue());
@@ -85,6 +96,8 @@ void ScreenOutput::update()
 	{
 		if (prevIsLive)
 		{
+			screen->isRenderingDirect = false;
+			GlContextHolder::getInstance()->presentBarrier.removeParticipant(this); //a hidden window may not render anymore
 			removeFromDesktop();
 			setAlwaysOnTop(false);
 			removeKeyListener(this);
@@ -106,13 +119,23 @@ void ScreenOutput::renderOpenGL()
 {
 	if (inspectable.wasObjectDeleted()) return;
 	if (screen->isClearing) return;
+	if (region != nullptr && regionRef.wasObjectDeleted()) return;
 
 	// Définir la vue OpenGL en fonction de la taille du composant
 	if (!isLive)
 	{
+		screen->isRenderingDirect = false;
+		updateSync();
 		return;
 	}
 
+	//the main context triggered this repaint right after rendering this frame
+	int64 frameNumber = GlContextHolder::getInstance()->frameNumber;
+	updateSync();
+
+	bool direct = screen->canRenderDirect();
+	screen->isRenderingDirect = direct;
+
 	//context.makeActive();
 
 	Init2DViewport(getWidth(), getHeight());
@@ -120,6 +143,34 @@ void ScreenOutput::renderOpenGL()
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
 
+	if (direct)
+	{
+		//no intermediate framebuffer, the surfaces go straight to the window
+		if (region != nullptr)
+		{
+			//the whole canvas viewport is offset and scaled so that only the region lands in the window
+			int cw = screen->renderer->frameBuffer.getWidth();
+			int ch = screen->renderer->frameBuffer.getHeight();
+			Rectangle<int> r = region->getCanvasRegion(cw, ch);
+			if (r.isEmpty()) return;
+
+			float sx = getWidth() / (float)r.getWidth();
+			float sy = getHeight() / (float)r.getHeight();
+			glViewport(roundToInt(-r.getX() * sx), roundToInt(-(ch - r.getBottom()) * sy), roundToInt(cw * sx), roundToInt(ch * sy));
+		}
+
+		screen->renderer->drawSurfaces();
+		presentFrame(frameNumber);
+		return;
+	}
+
+	if (region != nullptr)
+	{
+		screen->renderer->drawRegion(region, getWidth(), getHeight());
+		presentFrame(frameNumber);
+		return;
+	}
+
 	glEnable(GL_TEXTURE_2D);
 	glBindTexture(GL_TEXTURE_2D, screen->renderer->frameBuffer.getTextureID());
 	glGetError();
@@ -133,10 +184,70 @@ void ScreenOutput::renderOpenGL()
 	glBindTexture(GL_TEXTURE_2D, 0);
 	glGetError();
 
+	presentFrame(frameNumber);
 }
 
 void ScreenOutput::openGLContextClosing()
 {
+	GlContextHolder::getInstance()->presentBarrier.removeParticipant(this);
+	isSynced = false;
+
+	if (isInSwapGroup) NVSwapGroup::leave();
+	isInSwapGroup = false;
+}
+
+void ScreenOutput::updateSync()
+{
+	//applied every frame, update() may also have removed this output from the message thread
+	isSynced = isLive && RMPSettings::getInstance()->syncOutputs->boolValue();
+	if (isSynced) GlContextHolder::getInstance()->presentBarrier.addParticipant(this);
+	else GlContextHolder::getInstance()->presentBarrier.removeParticipant(this);
+
+	bool shouldJoinGroup = isLive && RMPSettings::getInstance()->useSwapGroup->boolValue();
+	if (shouldJoinGroup && !isInSwapGroup && !swapGroupFailed)
+	{
+		isInSwapGroup = NVSwapGroup::join(1);
+		swapGroupFailed = !isInSwapGroup;
+		if (swapGroupFailed) LOGWARNING("Swap groups are not supported on this system, outputs are only synced by the present barrier");
+	}
+	else if (!shouldJoinGroup && isInSwapGroup)
+	{
+		NVSwapGroup::leave();
+		isInSwapGroup = false;
+	}
+
+	getPresentStats().isInSwapGroup = isInSwapGroup;
+}
+
+void ScreenOutput::presentFrame(int64 frameNumber)
+{
+	PresentStats& stats = getPresentStats();
+
+	if (isSynced)
+	{
+		int fps = RMPSettings::getInstance()->fpsLimit->enabled ? RMPSettings::getInstance()->fpsLimit->intValue() : 60;
+		double timeoutMs = 500.0 / jmax(fps, 1);
+
+		//the barrier only means something once the GPU is done with this window, a fence waits for this context's commands only
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		if (fence != nullptr)
+		{
+			glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, (GLuint64)(timeoutMs * 1000000));
+			glDeleteSync(fence);
+		}
+
+		PresentBarrier::Result result = GlContextHolder::getInstance()->presentBarrier.arriveAndWait(frameNumber, timeoutMs);
+		stats.addResult(frameNumber, result, Time::getMillisecondCounterHiRes());
+	}
+	else stats.lastFrame = frameNumber;
+
+	//swap interval is 0, the swap follows right after this
+	screen->latency.markPresented();
+}
+
+PresentStats& ScreenOutput::getPresentStats()
+{
+	return region != nullptr ? region->presentStats : screen->presentStats;
 }
 
 void ScreenOutput::userTriedToCloseWindow()
@@ -184,29 +295,38 @@ ScreenOutputWatcher::~ScreenOutputWatcher()
 
 void ScreenOutputWatcher::updateOutput(Screen* s, bool forceRemove)
 {
-	ScreenOutput* o = getOutputForScreen(s);
-	bool shouldShow = !forceRemove && !s->isClearing && s->enabled->boolValue() && s->outputType->getValueDataAsEnum<Screen::OutputType>() == Screen::OutputType::DISPLAY;
-	if (o == nullptr)
-	{
-		if (shouldShow) o = outputs.add(new ScreenOutput(s));
-	}
-	else
+	//one window per display region, or one for the whole screen when it has no region. nullptr is the whole screen
+	Array<ScreenOutputRegion*> windows;
+	if (!forceRemove && !s->isClearing && s->enabled->boolValue())
 	{
-		if (!shouldShow)
+		if (s->isMultiOutput())
 		{
-			outputs.removeObject(o);
-			o = nullptr;
+			for (auto& r : s->outputRegions.items)
+			{
+				if (r->enabled->boolValue() && r->outputType->getValueDataAsEnum<Screen::OutputType>() == Screen::OutputType::DISPLAY) windows.add(r);
+			}
 		}
+		else if (s->outputType->getValueDataAsEnum<Screen::OutputType>() == Screen::OutputType::DISPLAY) windows.add(nullptr);
 	}
 
-	if (o != nullptr) o->update();
+	for (int i = outputs.size() - 1; i >= 0; i--)
+	{
+		if (outputs[i]->screen == s && !windows.contains(outputs[i]->region)) outputs.remove(i);
+	}
+
+	for (auto& r : windows)
+	{
+		ScreenOutput* o = getOutputForScreen(s, r);
+		if (o == nullptr) o = outputs.add(new ScreenOutput(s, r));
+		o->update();
+	}
 }
 
-ScreenOutput* ScreenOutputWatcher::getOutputForScreen(Screen* s)
+ScreenOutput* ScreenOutputWatcher::getOutputForScreen(Screen* s, ScreenOutputRegion* r)
 {
 	for (auto& o : outputs)
 	{
-		if (o->screen == s) return o;
+		if (o->screen == s && o->region == r) return o;
 	}
 	return nullptr;
 }
@@ -252,7 +372,18 @@ void ScreenOutputWatcher::newMessage(const ContainerAsyncEvent& e)
 				updateOutput(s);
 			}
 		}
+
+		if (ScreenOutputRegion* r = ControllableUtil::findParentAs<ScreenOutputRegion>(e.targetControllable, 1))
+		{
+			if (e.targetControllable == r->enabled || e.targetControllable == r->outputType || e.targetControllable == r->screenID) updateOutput(r->screen);
+		}
 	}
+	break;
+
+	case ContainerAsyncEvent::ChildStructureChanged:
+		//output regions added or removed
+		for (auto& s : ScreenManager::getInstance()->items) updateOutput(s);
+		break;
 	}
 }
 
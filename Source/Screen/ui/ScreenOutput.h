@@ -12,6 +12,7 @@
 
 class Screen;
 class Media;
+class ScreenOutputRegion;
 
 class ScreenOutput :
 	public InspectableContentComponent,
@@ -20,14 +21,23 @@ class ScreenOutput :
 	public Parameter::AsyncListener
 {
 public:
-	ScreenOutput(Screen* parent);
+	ScreenOutput(Screen* parent, ScreenOutputRegion* region = nullptr);
 	~ScreenOutput();
 
 	Screen* screen;
 
+	//Only shows this part of the screen's canvas when set
+	ScreenOutputRegion* region;
+	WeakReference<Inspectable> regionRef;
+
 	bool isLive;
 	double timeAtRender;
 
+	//GL thread only
+	bool isSynced;
+	bool isInSwapGroup;
+	bool swapGroupFailed;
+
 
 	void paint(Graphics& g) override {}
 	void update();
@@ -37,6 +47,10 @@ public:
 	void renderOpenGL() override;
 	void openGLContextClosing() override;
 
+	void updateSync();
+	void presentFrame(int64 frameNumber);
+	PresentStats& getPresentStats();
+
 	void userTriedToCloseWindow() override;
 
 	void newMessage(const Parameter::ParameterEvent& e) override;
@@ -60,7 +74,7 @@ public:
 
 	void updateOutput(Screen* s, bool forceRemove = false);
 
-	ScreenOutput* getOutputForScreen(Screen* s);
+	ScreenOutput* getOutputForScreen(Screen* s, ScreenOutputRegion* r = nullptr);
 
 	//void itemAdded(Screen* item) override;
 	//void itemsAdded(Array<Screen*> items) override;
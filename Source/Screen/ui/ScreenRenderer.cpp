@@ -16,6 +16,8 @@
 
 using namespace juce::gl;
 
+#define SCREEN_LUT_TEXTURE_UNIT 3
+
 ScreenRenderer::ScreenRenderer(Screen* screen) :
 	screen(screen)
 {
@@ -40,28 +42,23 @@ void ScreenRenderer::newOpenGLContextCreated()
 
 void ScreenRenderer::renderOpenGL()
 {
+	//LUTs are only uploaded here on the main context, even when the output window draws the surfaces
+	{
+		GenericScopedLock lock(screen->surfaceDrawLock);
+		screen->colorCorrection.updateGL();
+		for (auto& s : screen->surfaces.items) s->colorCorrection.updateGL();
+	}
+
+	//the output window draws the surfaces itself, nothing reads this framebuffer
+	if (screen->isRenderingDirect) return;
+
 	frameBuffer.makeCurrentRenderingTarget();
 	glClearColor(0, 0, 0, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	Init2DViewport(frameBuffer.getWidth(), frameBuffer.getHeight());
 
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	if (shader != nullptr)
-	{
-		for (int i = screen->surfaces.items.size() - 1; i >= 0; i--)
-		{
-			
-			shader->use();
-			GLuint shaderProgram = shader->getProgramID();
-			screen->surfaces.items[i]->draw(shaderProgram);
-		}
-
-		glUseProgram(0);
-		glGetError();
-	}
+	drawSurfaces();
 
 	//for testing flipping
 	//glBegin(GL_QUADS);
@@ -74,6 +71,108 @@ void ScreenRenderer::renderOpenGL()
 
 	frameBuffer.releaseAsRenderingTarget();
 
+	if (screen->enabled->boolValue())
+	{
+		GenericScopedLock lock(screen->ndiOutputLock);
+		if (screen->ndiOutput != nullptr) screen->ndiOutput->sendFrame(frameBuffer);
+	}
+
+	if (screen->enabled->boolValue() && screen->isMultiOutput()) renderOutputRegions();
+
+	screen->recorder.captureFrame(frameBuffer);
+
+	//Display outputs present in their own context
+	if (!screen->hasDisplayOutput()) screen->latency.markPresented();
+}
+
+void ScreenRenderer::drawSurfaces()
+{
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	if (shader == nullptr) return;
+
+	//the renderer and the output may swap roles between two frames
+	GenericScopedLock lock(screen->surfaceDrawLock);
+
+	//the surfaces keep the program, the screen correction is set once for all of them
+	GLuint shaderProgram = shader->getProgramID();
+	glUseProgram(shaderProgram);
+	screen->colorCorrection.setUniforms(shaderProgram, "screen", SCREEN_LUT_TEXTURE_UNIT);
+
+	for (int i = screen->surfaces.items.size() - 1; i >= 0; i--)
+	{
+		screen->surfaces.items[i]->draw(shaderProgram);
+		screen->latency.addDrawnFrame(screen->surfaces.items[i]->getMedia());
+	}
+	screen->latency.endDrawnFrames();
+
+	screen->colorCorrection.unbindTexture(SCREEN_LUT_TEXTURE_UNIT);
+
+	glUseProgram(0);
+	glGetError();
+}
+
+void ScreenRenderer::drawRegion(ScreenOutputRegion* r, int targetWidth, int targetHeight)
+{
+	if (regionShader == nullptr) return;
+
+	int cw = frameBuffer.getWidth();
+	int ch = frameBuffer.getHeight();
+	Rectangle<int> region = r->getCanvasRegion(cw, ch);
+	if (region.isEmpty()) return;
+
+	Init2DViewport(targetWidth, targetHeight);
+	glDisable(GL_BLEND);
+
+	regionShader->use();
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, frameBuffer.getTextureID());
+	regionShader->setUniform("tex", 0);
+
+	//texture space is bottom up, regions are top down
+	regionShader->setUniform("sourceRect", region.getX() / (float)cw, 1 - region.getBottom() / (float)ch, region.getWidth() / (float)cw, region.getHeight() / (float)ch);
+
+	bool blend = r->edgeBlendCC.enabled->boolValue();
+	float rw = (float)region.getWidth();
+	float rh = (float)region.getHeight();
+	regionShader->setUniform("blendSize", blend ? r->blendLeft->intValue() / rw : 0, blend ? r->blendRight->intValue() / rw : 0,
+		blend ? r->blendBottom->intValue() / rh : 0, blend ? r->blendTop->intValue() / rh : 0);
+	regionShader->setUniform("blendGamma", r->blendGamma->floatValue());
+
+	Draw2DTexRect(0, 0, targetWidth, targetHeight);
+
+	glUseProgram(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glEnable(GL_BLEND);
+	glGetError();
+}
+
+void ScreenRenderer::renderOutputRegions()
+{
+	//display regions are drawn by their ScreenOutput, only the senders need their own framebuffer
+	for (auto& r : screen->outputRegions.items)
+	{
+		if (!r->enabled->boolValue()) continue;
+		if (r->outputType->getValueDataAsEnum<Screen::OutputType>() == Screen::DISPLAY) continue;
+
+		int w = r->regionWidth->intValue();
+		int h = r->regionHeight->intValue();
+		if (r->frameBuffer.getWidth() != w || r->frameBuffer.getHeight() != h)
+		{
+			r->frameBuffer.release();
+			r->frameBuffer.initialise(GlContextHolder::getInstance()->context, w, h);
+		}
+
+		r->frameBuffer.makeCurrentRenderingTarget();
+		glClearColor(0, 0, 0, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		drawRegion(r, w, h);
+		r->frameBuffer.releaseAsRenderingTarget();
+
+		GenericScopedLock lock(r->ndiOutputLock);
+		if (r->ndiOutput != nullptr) r->ndiOutput->sendFrame(r->frameBuffer);
+	}
 }
 
 void ScreenRenderer::openGLContextClosing()
@@ -81,6 +180,15 @@ void ScreenRenderer::openGLContextClosing()
 	glEnable(GL_BLEND);
 	glDisable(GL_BLEND);
 	shader = nullptr;
+	regionShader = nullptr;
+
+	screen->colorCorrection.releaseGL();
+	for (auto& s : screen->surfaces.items) s->colorCorrection.releaseGL();
+	screen->recorder.releaseGL();
+	for (auto& r : screen->outputRegions.items) r->releaseGL();
+
+	GenericScopedLock lock(screen->ndiOutputLock);
+	if (screen->ndiOutput != nullptr) screen->ndiOutput->releaseGL();
 }
 
 
@@ -90,4 +198,46 @@ void ScreenRenderer::createAndLoadShaders()
 	shader->addVertexShader(OpenGLHelpers::translateVertexShaderToV3(BinaryData::VertexShaderMainSurface_glsl));
 	shader->addFragmentShader(OpenGLHelpers::translateFragmentShaderToV3(BinaryData::fragmentShaderMainSurface_glsl));
 	shader->link();
+
+	//Crops the canvas to a region and multiplies its borders by a gamma corrected blend ramp
+	const char* regionVertexShader = R"(
+			#version 120
+			uniform vec4 sourceRect;
+			varying vec2 texCoord;
+			varying vec2 localCoord;
+			void main() {
+				localCoord = gl_MultiTexCoord0.xy;
+				texCoord = sourceRect.xy + localCoord * sourceRect.zw;
+				gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+			}
+		)";
+
+	const char* regionFragmentShader = R"(
+			#version 120
+			uniform sampler2D tex;
+			uniform vec4 blendSize; //left, right, bottom, top, relative to the region
+			uniform float blendGamma;
+			varying vec2 texCoord;
+			varying vec2 localCoord;
+
+			float ramp(float d, float size) {
+				if (size <= 0.0) return 1.0;
+				float x = clamp(d / size, 0.0, 1.0);
+				return x < 0.5 ? 0.5 * pow(2.0 * x, 2.0) : 1.0 - 0.5 * pow(2.0 * (1.0 - x), 2.0);
+			}
+
+			void main() {
+				float a = ramp(localCoord.x, blendSize.x) * ramp(1.0 - localCoord.x, blendSize.y)
+					* ramp(localCoord.y, blendSize.z) * ramp(1.0 - localCoord.y, blendSize.w);
+				vec4 c = texture2D(tex, texCoord);
+				gl_FragColor = vec4(c.rgb * pow(a, 1.0 / blendGamma), c.a);
+			}
+		)";
+
+	regionShader.reset(new OpenGLShaderProgram(GlContextHolder::getInstance()->context));
+	if (!regionShader->addVertexShader(regionVertexShader) || !regionShader->addFragmentShader(regionFragmentShader) || !regionShader->link())
+	{
+		LOGERROR("Output region shader failed : " << regionShader->getLastError());
+		regionShader.reset();
+	}
 }
\ No newline at end of file
@@ -21,6 +21,7 @@ public:
 	Screen* screen;
 
 	std::unique_ptr<OpenGLShaderProgram> shader;
+	std::unique_ptr<OpenGLShaderProgram> regionShader;
 	juce::OpenGLFrameBuffer frameBuffer;
 
 	void regenerateTextures();
@@ -28,6 +29,13 @@ public:
 	void newOpenGLContextCreated() override;
 	void renderOpenGL() override;
 
+	//Draws in the currently bound target. Also called from the ScreenOutput context in direct render, programs and buffers are shared
+	void drawSurfaces();
+
+	//Draws the region's part of the framebuffer with its edge blend, in a target of the given size
+	void drawRegion(ScreenOutputRegion* r, int targetWidth, int targetHeight);
+	void renderOutputRegions();
+
 	void openGLContextClosing() override;
 
 	void createAndLoadShaders();